@@ -19,6 +19,9 @@
 
 #ifdef _WIN32
 #include <direct.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
 #endif
 #include <sys/stat.h>
 #include <errno.h>
@@ -244,6 +247,8 @@ static int MyCreateDir(const char *name)
 
 #define OUT_BUF_SIZE (1 << 20)
 
+#define UNPACK_MAX_WRITERS 4
+
 #if defined(_WIN32)
 static int compareExt(wchar_t *filename, const wchar_t *ext)
 {
@@ -273,10 +278,21 @@ static const wchar_t *filterExtension;
 static const char *filterExtension;
 #endif
 
+#ifdef _WIN32
+static CRITICAL_SECTION unpackLock;
+#define UnpackLock() EnterCriticalSection(&unpackLock)
+#define UnpackUnlock() LeaveCriticalSection(&unpackLock)
+#else
+static pthread_mutex_t unpackLock = PTHREAD_MUTEX_INITIALIZER;
+#define UnpackLock() pthread_mutex_lock(&unpackLock)
+#define UnpackUnlock() pthread_mutex_unlock(&unpackLock)
+#endif
+
 static void PrintProgressIpc(UInt64 processedBytes)
 {
     if (g_ipc)
     {
+        UnpackLock();
         progressUnpackedSize += processedBytes;
         int newProgress = progressUnpackedSize * 100 / totalUnpackedSize;
         if (lastProgress != newProgress)
@@ -289,6 +305,7 @@ static void PrintProgressIpc(UInt64 processedBytes)
 #endif
             fflush(stdout);
         }
+        UnpackUnlock();
     }
 }
 
@@ -296,6 +313,7 @@ static void PrintfCurrentFile(SzArEx_StreamOutEntry *streamOutInfo)
 {
     if (filterExtension[0] == 0 || compareExt(streamOutInfo->path, filterExtension))
     {
+        UnpackLock();
         if (g_ipc)
         {
 #if defined(_WIN32)
@@ -315,9 +333,207 @@ static void PrintfCurrentFile(SzArEx_StreamOutEntry *streamOutInfo)
                    totalFiles, streamOutInfo->path, streamOutInfo->UnpackSize);
 #endif
         }
+        UnpackUnlock();
     }
 }
 
+/* Folders are independent decode units, so each one can be extracted by its
+   own worker with a private input stream. Solid archives with a single folder
+   still unpack on one thread. */
+typedef struct
+{
+#ifdef USE_WINDOWS_FILE
+    const wchar_t *path;
+#else
+    const char *path;
+#endif
+    const CSzArEx *db;
+    SzArEx_StreamOutEntry *streamOutInfo;
+    const UInt32 *jobs;
+    UInt32 numJobs;
+    UInt32 nextJob;
+    SRes res;
+} UnpackContext;
+
+static SRes UnpackFolder(UnpackContext *ctx, ILookInStream *inStream, UInt32 i)
+{
+    ISzAlloc allocImp = g_Alloc;
+    ISzAlloc allocTempImp = g_Alloc;
+    SzArEx_StreamOutEntry *entry = &ctx->streamOutInfo[i];
+    SRes res;
+
+    res = SzArEx_ExtractFolderToStream(ctx->db, inStream, entry->folderIndex,
+                                       entry, &allocTempImp,
+                                       PrintProgressIpc, PrintfCurrentFile);
+    if (res == SZ_ERROR_UNSUPPORTED)
+    {
+        UInt32 blockIndex = 0xFFFFFFFF;
+        Byte *outBuffer = 0;
+        size_t outBufferSize = 0;
+        size_t offset = 0;
+        size_t outSizeProcessed = 0;
+
+        PrintfCurrentFile(entry);
+
+        res = SzArEx_Extract(ctx->db, inStream, i,
+                             &blockIndex, &outBuffer, &outBufferSize,
+                             &offset, &outSizeProcessed,
+                             &allocImp, &allocTempImp);
+        if (res == SZ_OK)
+        {
+            PrintProgressIpc(outSizeProcessed);
+
+#ifdef USE_WINDOWS_FILE
+            if (entry->outStream.file.handle != INVALID_HANDLE_VALUE)
+#else
+            if (entry->outStream.file.fd != -1)
+#endif
+            {
+                SizeT outProcessed = outSizeProcessed;
+                if (entry->outStream.vt.Write(&entry->outStream.vt, outBuffer, outProcessed) != outProcessed)
+                {
+                    res = SZ_ERROR_WRITE;
+                }
+            }
+            ISzAlloc_Free(&allocImp, outBuffer);
+        }
+    }
+
+    return res;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI UnpackWorker(LPVOID param)
+#else
+static void *UnpackWorker(void *param)
+#endif
+{
+    UnpackContext *ctx = (UnpackContext *)param;
+    CFileInStream archiveStream;
+    CLookToRead2 lookStream;
+    SRes res = SZ_OK;
+
+#ifdef USE_WINDOWS_FILE
+    if (InFile_OpenW(&archiveStream.file, ctx->path))
+#else
+    if (InFile_Open(&archiveStream.file, ctx->path))
+#endif
+    {
+        res = SZ_ERROR_READ;
+    }
+    else
+    {
+        FileInStream_CreateVTable(&archiveStream);
+        LookToRead2_CreateVTable(&lookStream, False);
+        lookStream.buf = ISzAlloc_Alloc(&g_Alloc, kInputBufSize);
+        if (!lookStream.buf)
+        {
+            res = SZ_ERROR_MEM;
+        }
+        else
+        {
+            lookStream.bufSize = kInputBufSize;
+            lookStream.realStream = &archiveStream.vt;
+            LookToRead2_Init(&lookStream);
+
+            for (;;)
+            {
+                UInt32 job;
+                UnpackLock();
+                if (ctx->res != SZ_OK || ctx->nextJob >= ctx->numJobs)
+                {
+                    UnpackUnlock();
+                    break;
+                }
+                job = ctx->nextJob++;
+                UnpackUnlock();
+
+                res = UnpackFolder(ctx, &lookStream.vt, ctx->jobs[job]);
+                if (res != SZ_OK)
+                    break;
+            }
+            ISzAlloc_Free(&g_Alloc, lookStream.buf);
+        }
+        File_Close(&archiveStream.file);
+    }
+
+    if (res != SZ_OK)
+    {
+        UnpackLock();
+        if (ctx->res == SZ_OK)
+            ctx->res = res;
+        UnpackUnlock();
+    }
+
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+static UInt32 GetNumUnpackWorkers(UInt32 numJobs)
+{
+    UInt32 numThreads;
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    numThreads = info.dwNumberOfProcessors;
+#else
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    numThreads = cpus > 0 ? (UInt32)cpus : 1;
+#endif
+    if (numThreads > UNPACK_MAX_WRITERS)
+        numThreads = UNPACK_MAX_WRITERS;
+    if (numThreads > numJobs)
+        numThreads = numJobs;
+    return numThreads;
+}
+
+static SRes UnpackFolders(UnpackContext *ctx)
+{
+    UInt32 numThreads = GetNumUnpackWorkers(ctx->numJobs);
+    UInt32 t, started = 0;
+
+    ctx->nextJob = 0;
+    ctx->res = SZ_OK;
+    if (numThreads <= 1)
+    {
+        UnpackWorker(ctx);
+        return ctx->res;
+    }
+
+#ifdef _WIN32
+    HANDLE threads[UNPACK_MAX_WRITERS];
+    for (t = 0; t < numThreads; t++)
+    {
+        threads[t] = CreateThread(NULL, 0, UnpackWorker, ctx, 0, NULL);
+        if (threads[t] == NULL)
+            break;
+        started++;
+    }
+    if (started != 0)
+        WaitForMultipleObjects(started, threads, TRUE, INFINITE);
+    for (t = 0; t < started; t++)
+        CloseHandle(threads[t]);
+#else
+    pthread_t threads[UNPACK_MAX_WRITERS];
+    for (t = 0; t < numThreads; t++)
+    {
+        if (pthread_create(&threads[t], NULL, UnpackWorker, ctx) != 0)
+            break;
+        started++;
+    }
+    for (t = 0; t < started; t++)
+        pthread_join(threads[t], NULL);
+#endif
+
+    if (started == 0)
+        UnpackWorker(ctx);
+
+    return ctx->res;
+}
+
 #ifdef USE_WINDOWS_FILE
 int sevenzip_unpack(const wchar_t *path, const wchar_t *output_path,
                     const wchar_t *filter, int full_path, int ipc)
@@ -659,80 +875,50 @@ int sevenzip_unpack(const char *path, const char *output_path,
         }
     }
 
-    for (f = 0; ; f++)
+    if (res == SZ_OK)
     {
-        int foundFolder = 0;
-        for (i = 0; i < db.NumFiles; i++)
+        UInt32 *folderFirstFile = (UInt32 *)SzAlloc(NULL, (db.db.NumFolders + 1) * sizeof(UInt32));
+        UInt32 *jobs = (UInt32 *)SzAlloc(NULL, (db.db.NumFolders + 1) * sizeof(UInt32));
+        UInt32 numJobs = 0;
+        if (folderFirstFile == NULL || jobs == NULL)
+        {
+            res = SZ_ERROR_MEM;
+        }
+        else
         {
-            if (streamOutInfo[i].folderIndex > f &&
-                streamOutInfo[i].folderIndex != 0xffffffff)
+            for (f = 0; f < db.db.NumFolders; f++)
+                folderFirstFile[f] = 0xFFFFFFFF;
+            for (i = 0; i < db.NumFiles; i++)
             {
-                foundFolder = 1;
+                if (streamOutInfo[i].isDir)
+                    continue;
+                f = streamOutInfo[i].folderIndex;
+                if (f != 0xffffffff && folderFirstFile[f] == 0xFFFFFFFF)
+                    folderFirstFile[f] = i;
             }
-            if ((streamOutInfo[i].folderIndex != f && streamOutInfo[i].folderIndex != 0xffffffff) ||
-                 streamOutInfo[i].folderIndex == 0xffffffff)
+            for (f = 0; f < db.db.NumFolders; f++)
             {
-                continue;
+                if (folderFirstFile[f] != 0xFFFFFFFF)
+                    jobs[numJobs++] = folderFirstFile[f];
             }
-            if (streamOutInfo[i].isDir)
-            {
-                if (!ipc)
-                {
-#if defined(_WIN32)
-                    wprintf(L"%d of %d - %ls\n", (i + 1), db.NumFiles, streamOutInfo[i].path);
-#else
-                    printf("%d of %d - %s\n", (i + 1), db.NumFiles, streamOutInfo[i].path);
-#endif
-                }
-            }
-            else
-            {
-                res = SzArEx_ExtractFolderToStream(&db, &lookStream.vt, f,
-                                                   &streamOutInfo[i], &allocTempImp,
-                                                   PrintProgressIpc, PrintfCurrentFile);
-                if (res == SZ_ERROR_UNSUPPORTED)
-                {
-                    UInt32 blockIndex = 0xFFFFFFFF;
-                    Byte *outBuffer = 0;
-                    size_t outBufferSize = 0;
-                    size_t offset = 0;
-                    size_t outSizeProcessed = 0;
-
-                    PrintfCurrentFile(&streamOutInfo[i]);
-
-                    res = SzArEx_Extract(&db, &lookStream.vt, i,
-                                         &blockIndex, &outBuffer, &outBufferSize,
-                                         &offset, &outSizeProcessed,
-                                         &allocImp, &allocTempImp);
-                    if (res == SZ_OK)
-                    {
-                        PrintProgressIpc(outSizeProcessed);
 
-#ifdef USE_WINDOWS_FILE
-                        if (streamOutInfo[i].outStream.file.handle != INVALID_HANDLE_VALUE)
-#else
-                        if (streamOutInfo[i].outStream.file.fd != -1)
+            UnpackContext ctx;
+            memset(&ctx, 0, sizeof(UnpackContext));
+            ctx.path = path;
+            ctx.db = &db;
+            ctx.streamOutInfo = streamOutInfo;
+            ctx.jobs = jobs;
+            ctx.numJobs = numJobs;
+#ifdef _WIN32
+            InitializeCriticalSection(&unpackLock);
+#endif
+            res = UnpackFolders(&ctx);
+#ifdef _WIN32
+            DeleteCriticalSection(&unpackLock);
 #endif
-                        {
-                            SizeT outProcessed = outSizeProcessed;
-                            if (streamOutInfo[i].outStream.vt.Write(&streamOutInfo[i].outStream.vt, outBuffer, outProcessed) != outProcessed)
-                            {
-                                res = SZ_ERROR_WRITE;
-                            }
-                        }
-                        ISzAlloc_Free(&allocImp, outBuffer);
-                    }
-                }
-
-                if (res == SZ_OK)
-                {
-                    foundFolder = 1;
-                }
-                break;
-            }
         }
-        if (!foundFolder)
-            break;
+        SzFree(NULL, jobs);
+        SzFree(NULL, folderFirstFile);
     }
 
     for (i = 0; i < db.NumFiles; i++)
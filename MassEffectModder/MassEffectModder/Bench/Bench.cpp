@@ -0,0 +1,85 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include "Bench.h"
+
+Bench::Bench(int numIterations, const QString &nameFilter)
+    : filter(nameFilter), iterations(qMax(numIterations, 1))
+{
+}
+
+bool Bench::Enabled(const QString &name) const
+{
+    return filter.isEmpty() || name.contains(filter, Qt::CaseInsensitive);
+}
+
+void Bench::Measure(const QString &name, qint64 bytes, const std::function<void()> &run,
+                    const std::function<void()> &prepare,
+                    const std::function<void()> &finish)
+{
+    if (!Enabled(name))
+        return;
+
+    Result result{};
+    result.name = name;
+    result.bytes = bytes;
+    result.iterations = iterations;
+    result.minMs = std::numeric_limits<double>::max();
+    double totalMs = 0;
+    QElapsedTimer timer;
+    for (int i = 0; i < iterations; i++)
+    {
+        if (prepare)
+            prepare();
+        timer.start();
+        run();
+        double elapsedMs = timer.nsecsElapsed() / 1000000.0;
+        if (finish)
+            finish();
+        totalMs += elapsedMs;
+        result.minMs = qMin(result.minMs, elapsedMs);
+    }
+    result.meanMs = totalMs / iterations;
+    results.push_back(result);
+}
+
+QByteArray Bench::ToJson(const QJsonObject &environment) const
+{
+    QJsonArray list;
+    for (const auto& result : results)
+    {
+        QJsonObject entry;
+        entry["name"] = result.name;
+        entry["bytes"] = result.bytes;
+        entry["iterations"] = result.iterations;
+        entry["min_ms"] = result.minMs;
+        entry["mean_ms"] = result.meanMs;
+        if (result.minMs > 0)
+            entry["mb_per_s"] = (result.bytes / (1024.0 * 1024.0)) / (result.minMs / 1000.0);
+        list.append(entry);
+    }
+
+    QJsonObject root = environment;
+    root["results"] = list;
+
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
@@ -0,0 +1,59 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <functional>
+#include <limits>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+class Bench
+{
+    struct Result
+    {
+        QString name;
+        qint64 bytes;
+        int iterations;
+        double minMs;
+        double meanMs;
+    };
+
+private:
+
+    QList<Result> results;
+    QString filter;
+    int iterations;
+
+public:
+
+    Bench(int numIterations, const QString &nameFilter);
+    bool Enabled(const QString &name) const;
+    void Measure(const QString &name, qint64 bytes, const std::function<void()> &run,
+                 const std::function<void()> &prepare = nullptr,
+                 const std::function<void()> &finish = nullptr);
+    QByteArray ToJson(const QJsonObject &environment) const;
+};
+
+#endif
@@ -0,0 +1,254 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include "BenchData.h"
+#include <GameData/Package.h>
+#include <Helpers/FileStream.h>
+#include <Helpers/MemoryStream.h>
+#include <Image/Image.h>
+#include <MipMaps/MipMaps.h>
+#include <MipMaps/MipMap.h>
+#include <Misc/Misc.h>
+
+#define BENCH_PACKAGE_NAMES_COUNT 4
+
+static const char *const packageNames[BENCH_PACKAGE_NAMES_COUNT] =
+{
+    "None", "Core", "Texture2D", "BenchObject"
+};
+
+ByteBuffer BenchData::GenerateData(qint64 size, quint32 seed)
+{
+    ByteBuffer data(size);
+    quint8 *ptr = data.ptr();
+    quint32 state = seed != 0 ? seed : 0x9E3779B9;
+    for (qint64 i = 0; i < size; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        // Alternate noise and gradient runs, compresses close to real texture payloads
+        if ((i & 0x100) != 0)
+            ptr[i] = (quint8)(state & 0x3F);
+        else
+            ptr[i] = (quint8)(i >> 4);
+    }
+    return data;
+}
+
+void BenchData::WritePackage(const QString &path, int exportsCount, int exportSize,
+                             Package::CompressionType compression)
+{
+    const int flagsOffset = Package::packageHeaderNameSizeOffset + 4 + 5;
+    const int tablesOffset = flagsOffset + 4;
+
+    MemoryStream image;
+    image.WriteUInt32(Package::DataTag);
+    image.WriteUInt16(Package::packageFileVersion684);
+    image.WriteUInt16(0);
+    image.WriteUInt32(0); // end of tables - filled later
+    image.WriteInt32(5);
+    image.WriteStringASCIINull("None");
+    image.WriteUInt32(0); // flags
+    image.WriteZeros(Package::packageHeaderSize684 - tablesOffset);
+    image.WriteUInt32(Package::CompressionType::None);
+    image.WriteUInt32(0); // number of chunks
+    image.WriteUInt32(0); // some tag
+    image.WriteUInt32(0); // extra names count
+    uint dataOffset = image.Position();
+
+    uint namesOffset = image.Position();
+    for (auto name : packageNames)
+    {
+        image.WriteInt32(strlen(name) + 1);
+        image.WriteStringASCIINull(name);
+    }
+
+    uint importsOffset = image.Position();
+
+    uint exportsOffset = image.Position();
+    QVector<uint> exportEntries(exportsCount);
+    for (int i = 0; i < exportsCount; i++)
+    {
+        exportEntries[i] = image.Position();
+        image.WriteInt32(0); // class
+        image.WriteInt32(0); // super class
+        image.WriteInt32(0); // link
+        image.WriteInt32(BENCH_PACKAGE_NAMES_COUNT - 1); // object name
+        image.WriteInt32(i + 1); // name suffix
+        image.WriteInt32(0); // archetype
+        image.WriteUInt64(0); // object flags
+        image.WriteUInt32(exportSize);
+        image.WriteUInt32(0); // data offset - filled later
+        image.WriteInt32(0);
+        image.WriteUInt32(0); // no entries
+        image.WriteZeros(16); // guid
+        image.WriteInt32(0);
+    }
+
+    uint dependsOffset = image.Position();
+    for (int i = 0; i < exportsCount; i++)
+        image.WriteInt32(0);
+
+    uint guidsOffset = image.Position();
+    uint endOfTables = image.Position();
+
+    for (int i = 0; i < exportsCount; i++)
+    {
+        uint offset = image.Position();
+        ByteBuffer data = GenerateData(exportSize, i + 1);
+        image.WriteFromBuffer(data);
+        data.Free();
+        image.JumpTo(exportEntries[i] + Package::ExportEntry::DataOffsetOffset);
+        image.WriteUInt32(offset);
+        image.SeekEnd();
+    }
+
+    image.JumpTo(Package::packageHeaderFirstChunkSizeOffset);
+    image.WriteUInt32(endOfTables);
+    image.JumpTo(tablesOffset);
+    image.WriteUInt32(BENCH_PACKAGE_NAMES_COUNT);
+    image.WriteUInt32(namesOffset);
+    image.WriteUInt32(exportsCount);
+    image.WriteUInt32(exportsOffset);
+    image.WriteUInt32(0); // imports count
+    image.WriteUInt32(importsOffset);
+    image.WriteUInt32(dependsOffset);
+    image.WriteUInt32(guidsOffset);
+    image.WriteUInt32(0);
+    image.WriteUInt32(0); // guids count
+
+    ByteBuffer package = image.ToArray();
+
+    QDir().mkpath(DirName(path));
+    FileStream fs = FileStream(path, FileMode::Create, FileAccess::WriteOnly);
+    if (compression == Package::CompressionType::None)
+    {
+        fs.WriteFromBuffer(package);
+        package.Free();
+        return;
+    }
+
+    StorageTypes storageType = compression == Package::CompressionType::Zlib ?
+                StorageTypes::pccZlib : StorageTypes::pccOodle;
+    *reinterpret_cast<uint *>(package.ptr() + flagsOffset) |= Package::PackageFlags::compressed;
+
+    QList<Package::Chunk> chunks;
+    QList<ByteBuffer> chunksData;
+    for (uint offset = dataOffset; offset < package.size(); offset += Package::MaxChunkSize)
+    {
+        Package::Chunk chunk{};
+        chunk.uncomprOffset = offset;
+        chunk.uncomprSize = qMin((uint)Package::MaxChunkSize, (uint)package.size() - offset);
+        ByteBuffer data(package.ptr() + offset, chunk.uncomprSize);
+        chunksData.push_back(Package::compressData(data, storageType));
+        data.Free();
+        chunk.comprSize = chunksData.last().size();
+        chunks.push_back(chunk);
+    }
+
+    fs.WriteFromBuffer(package.ptr(), Package::packageHeaderSize684);
+    fs.WriteUInt32(compression);
+    fs.WriteUInt32(chunks.count());
+    uint comprOffset = fs.Position() + Package::SizeOfChunk * chunks.count() + 8;
+    for (auto& chunk : chunks)
+    {
+        chunk.comprOffset = comprOffset;
+        comprOffset += chunk.comprSize;
+        fs.WriteUInt32(chunk.uncomprOffset);
+        fs.WriteUInt32(chunk.uncomprSize);
+        fs.WriteUInt32(chunk.comprOffset);
+        fs.WriteUInt32(chunk.comprSize);
+    }
+    fs.WriteUInt32(0); // some tag
+    fs.WriteUInt32(0); // extra names count
+    for (auto& data : chunksData)
+    {
+        fs.WriteFromBuffer(data);
+        data.Free();
+    }
+    package.Free();
+}
+
+ByteBuffer BenchData::GenerateTexture(int width, int height, PixelFormat format)
+{
+    Image image(width, height);
+    image.generateGradient();
+    image.correctMips(format, false, 128, 0.2f);
+    MipMap *top = image.getMipMaps().first();
+    return ByteBuffer(top->getRefData().ptr(), top->getRefData().size());
+}
+
+qint64 BenchData::WriteMem(const QString &path, MeType gameId, int texturesCount,
+                           int textureSize, CompressionDataType compression)
+{
+    qint64 uncompressedBytes = 0;
+    QList<FileMod> modFiles;
+
+    FileStream outFs = FileStream(path, FileMode::Create, FileAccess::WriteOnly);
+    outFs.WriteUInt32(TextureModTag);
+    outFs.WriteUInt32(TextureModVersion);
+    outFs.WriteInt64(0); // filled later
+
+    for (int i = 0; i < texturesCount; i++)
+    {
+        Image image(textureSize, textureSize);
+        image.generateGradient();
+        image.correctMips(PixelFormat::DXT1, false, 128, 0.2f);
+        auto data = image.StoreImageToDDS();
+        uncompressedBytes += data.size();
+
+        MemoryStream dst;
+        Misc::compressData(data, dst, compression);
+        data.Free();
+        dst.SeekBegin();
+
+        FileMod fileMod{};
+        fileMod.tag = FileTextureTag;
+        fileMod.name = QString::asprintf("BenchTexture%04d", i);
+        fileMod.offset = outFs.Position();
+        fileMod.size = dst.Length();
+        outFs.WriteUInt32(0); // texture flags
+        outFs.WriteUInt32(0x10000000 + i); // crc
+        outFs.CopyFrom(dst, dst.Length());
+        modFiles.push_back(fileMod);
+    }
+
+    qint64 pos = outFs.Position();
+    outFs.SeekBegin();
+    outFs.WriteUInt32(TextureModTag);
+    outFs.WriteUInt32(TextureModVersion);
+    outFs.WriteInt64(pos);
+    outFs.JumpTo(pos);
+    outFs.WriteUInt32((uint)gameId);
+    outFs.WriteInt32(modFiles.count());
+    for (const auto& fileMod : modFiles)
+    {
+        outFs.WriteUInt32(fileMod.tag);
+        outFs.WriteStringASCIINull(fileMod.name);
+        outFs.WriteInt64(fileMod.offset);
+        outFs.WriteInt64(fileMod.size);
+        outFs.WriteInt64(fileMod.flags);
+    }
+
+    return uncompressedBytes;
+}
@@ -0,0 +1,42 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#ifndef BENCH_DATA_H
+#define BENCH_DATA_H
+
+#include <GameData/Package.h>
+#include <Helpers/ByteBuffer.h>
+#include <Types/MemTypes.h>
+
+class BenchData
+{
+public:
+
+    static ByteBuffer GenerateData(qint64 size, quint32 seed);
+    static void WritePackage(const QString &path, int exportsCount, int exportSize,
+                             Package::CompressionType compression);
+    static ByteBuffer GenerateTexture(int width, int height, PixelFormat format);
+    static qint64 WriteMem(const QString &path, MeType gameId, int texturesCount,
+                           int textureSize, CompressionDataType compression);
+};
+
+#endif
@@ -0,0 +1,488 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include <Bench/Bench.h>
+#include <Bench/BenchData.h>
+#include <GameData/GameData.h>
+#include <GameData/Package.h>
+#include <GameData/PackageCache.h>
+#include <Helpers/Crc32Fast.h>
+#include <Helpers/FileStream.h>
+#include <Helpers/Logs.h>
+#include <Helpers/MemoryStream.h>
+#include <Helpers/MiscHelpers.h>
+#include <Image/Image.h>
+#include <Misc/Misc.h>
+#include <Program/SignalHandler.h>
+#include <Wrappers.h>
+
+bool g_ipc = false;
+
+static const PixelFormat benchPixelFormats[] =
+{
+    PixelFormat::DXT1, PixelFormat::DXT3, PixelFormat::DXT5, PixelFormat::ATI2,
+    PixelFormat::V8U8, PixelFormat::ARGB, PixelFormat::RGBA, PixelFormat::RGB,
+    PixelFormat::G8, PixelFormat::BC5, PixelFormat::BC7, PixelFormat::RGBE,
+    PixelFormat::R10G10B10A2, PixelFormat::R16G16B16A16,
+};
+
+static QString PixelFormatName(PixelFormat format)
+{
+    return Image::getEngineFormatType(format).replace("PF_", "");
+}
+
+static void BenchCrc(Bench &bench, int scale)
+{
+    qint64 size = 64LL * 1024 * 1024 * scale;
+    if (!bench.Enabled("crc32.16bytes_prefetch") &&
+        !bench.Enabled("crc32.pclmul") &&
+        !bench.Enabled("crc32.parallel"))
+    {
+        return;
+    }
+    ByteBuffer data = BenchData::GenerateData(size, 1);
+
+    // Accelerated variants must match reference for odd lengths and unaligned data
+    const size_t lengths[] = { 0, 1, 15, 16, 63, 64, 65, 255, 4097, 1024 * 1024 + 7 };
+    for (size_t length : lengths)
+    {
+        for (int offset = 0; offset < 4; offset++)
+        {
+            quint32 expected = crc32_16bytes(data.ptr() + offset, length, 0x12345678);
+            if (crc32_pclmul_supported() && crc32_pclmul(data.ptr() + offset, length, 0x12345678) != expected)
+                CRASH_MSG("Bench: crc32_pclmul mismatch!");
+            if (crc32_hw(data.ptr() + offset, length, 0x12345678) != expected)
+                CRASH_MSG("Bench: crc32_hw mismatch!");
+            size_t split = length / 3;
+            if (crc32_combine_parts(crc32_16bytes(data.ptr() + offset, split, 0x12345678),
+                                    crc32_16bytes(data.ptr() + offset + split, length - split),
+                                    length - split) != expected)
+            {
+                CRASH_MSG("Bench: crc32_combine_parts mismatch!");
+            }
+        }
+    }
+    if (crc32_parallel(data.ptr(), data.size()) != crc32_16bytes_prefetch(data.ptr(), data.size()))
+        CRASH_MSG("Bench: crc32_parallel mismatch!");
+
+    volatile quint32 crc = 0;
+    bench.Measure("crc32.16bytes_prefetch", size, [&] {
+        crc = crc32_16bytes_prefetch(data.ptr(), data.size());
+    });
+    if (crc32_pclmul_supported())
+    {
+        bench.Measure("crc32.pclmul", size, [&] {
+            crc = crc32_pclmul(data.ptr(), data.size());
+        });
+    }
+    bench.Measure("crc32.parallel", size, [&] {
+        crc = crc32_parallel(data.ptr(), data.size());
+    });
+    data.Free();
+}
+
+static void BenchStreams(Bench &bench, int scale)
+{
+    qint64 size = 64LL * 1024 * 1024 * scale;
+    if (!bench.Enabled("stream.copyFrom.fileToFile") &&
+        !bench.Enabled("stream.copyFrom.memoryToFile") &&
+        !bench.Enabled("stream.copyFrom.fileToMemory"))
+    {
+        return;
+    }
+    ByteBuffer data = BenchData::GenerateData(size, 4);
+    QString srcPath = g_GameData->GamePath() + "/BenchCopySrc.bin";
+    QString dstPath = g_GameData->GamePath() + "/BenchCopyDst.bin";
+    {
+        FileStream fs(srcPath, FileMode::Create, FileAccess::WriteOnly);
+        fs.WriteFromBuffer(data);
+    }
+
+    // Fast paths must produce same content as source, also at unaligned offsets
+    {
+        FileStream src(srcPath, FileMode::Open, FileAccess::ReadOnly);
+        FileStream dst(dstPath, FileMode::Create, FileAccess::ReadWrite);
+        dst.WriteByte(0);
+        src.JumpTo(3);
+        dst.CopyFrom(src, size - 3);
+        MemoryStream view(data.ptr() + 3, size - 3);
+        dst.CopyFrom(view, size - 3);
+        MemoryStream mem;
+        mem.WriteByte(0);
+        src.JumpTo(3);
+        mem.CopyFrom(src, size - 3);
+        dst.JumpTo(1);
+        ByteBuffer fromFile = dst.ReadToBuffer(size - 3);
+        ByteBuffer fromMemory = dst.ReadToBuffer(size - 3);
+        ByteBuffer toMemory = mem.ToArray();
+        bool valid = memcmp(fromFile.ptr(), data.ptr() + 3, size - 3) == 0 &&
+                     memcmp(fromMemory.ptr(), data.ptr() + 3, size - 3) == 0 &&
+                     memcmp(toMemory.ptr() + 1, data.ptr() + 3, size - 3) == 0;
+        fromFile.Free();
+        fromMemory.Free();
+        toMemory.Free();
+        if (!valid)
+            CRASH_MSG("Bench: stream copy mismatch!");
+    }
+
+    FileStream *src = nullptr;
+    FileStream *dst = nullptr;
+    bench.Measure("stream.copyFrom.fileToFile", size, [&] {
+        dst->CopyFrom(*src, size);
+    }, [&] {
+        src = new FileStream(srcPath, FileMode::Open, FileAccess::ReadOnly);
+        dst = new FileStream(dstPath, FileMode::Create, FileAccess::WriteOnly);
+    }, [&] {
+        delete src;
+        delete dst;
+    });
+    bench.Measure("stream.copyFrom.memoryToFile", size, [&] {
+        MemoryStream view(data.ptr(), size);
+        dst->CopyFrom(view, size);
+    }, [&] {
+        dst = new FileStream(dstPath, FileMode::Create, FileAccess::WriteOnly);
+    }, [&] {
+        delete dst;
+    });
+    bench.Measure("stream.copyFrom.fileToMemory", size, [&] {
+        MemoryStream mem;
+        mem.CopyFrom(*src, size);
+    }, [&] {
+        src = new FileStream(srcPath, FileMode::Open, FileAccess::ReadOnly);
+    }, [&] {
+        delete src;
+    });
+
+    data.Free();
+    QFile::remove(srcPath);
+    QFile::remove(dstPath);
+}
+
+static void BenchPackageCompression(Bench &bench, int scale, bool oodle)
+{
+    qint64 size = 16LL * 1024 * 1024 * scale;
+    QList<QPair<QString, StorageTypes>> types{ { "zlib", StorageTypes::pccZlib } };
+    if (oodle)
+        types.push_back({ "oodle", StorageTypes::pccOodle });
+
+    ByteBuffer data = BenchData::GenerateData(size, 2);
+    for (const auto& type : types)
+    {
+        QString name = "package.compressData." + type.first;
+        if (!bench.Enabled(name) &&
+            !bench.Enabled("package.decompressData." + type.first) &&
+            !bench.Enabled("package.decompressDataCrc." + type.first))
+        {
+            continue;
+        }
+        ByteBuffer compressed;
+        bench.Measure(name, size, [&] {
+            compressed = Package::compressData(data, type.second);
+        }, nullptr, [&] {
+            compressed.Free();
+        });
+        compressed = Package::compressData(data, type.second);
+        bench.Measure("package.decompressData." + type.first, size, [&] {
+            MemoryStream stream(compressed);
+            ByteBuffer decompressed = Package::decompressData(stream, type.second,
+                                                              size, compressed.size());
+            decompressed.Free();
+        });
+
+        uint expectedCrc = crc32_16bytes_prefetch(data.ptr(), data.size());
+        bench.Measure("package.decompressDataCrc." + type.first, size, [&] {
+            MemoryStream stream(compressed);
+            uint crc = 0;
+            if (!Package::decompressDataCrc(stream, type.second, size, compressed.size(), crc) ||
+                crc != expectedCrc)
+            {
+                CRASH_MSG("Bench: decompressDataCrc mismatch!");
+            }
+        });
+        compressed.Free();
+    }
+    data.Free();
+}
+
+static void BenchPackages(Bench &bench, int scale, bool oodle)
+{
+    const int exportsCount = 64;
+    const int exportSize = 256 * 1024 * scale;
+    const qint64 dataSize = (qint64)exportsCount * exportSize;
+    QList<QPair<QString, Package::CompressionType>> types{
+        { "none", Package::CompressionType::None },
+        { "zlib", Package::CompressionType::Zlib },
+    };
+    if (oodle)
+        types.push_back({ "oodle", Package::CompressionType::Oddle });
+
+    for (const auto& type : types)
+    {
+        if (!bench.Enabled("package.open." + type.first) &&
+            !bench.Enabled("package.openCached." + type.first) &&
+            !bench.Enabled("package.getData." + type.first) &&
+            !bench.Enabled("package.SaveToFile." + type.first))
+        {
+            continue;
+        }
+        QString pristinePath = g_GameData->GamePath() + "/Pristine" + type.first + ".pcc";
+        QString path = g_GameData->GamePath() + "/Bench" + type.first + ".pcc";
+        BenchData::WritePackage(pristinePath, exportsCount, exportSize, type.second);
+        qint64 fileSize = QFileInfo(pristinePath).size();
+
+        bench.Measure("package.open." + type.first, fileSize, [&] {
+            Package package;
+            if (package.Open(pristinePath) != 0)
+                CRASH_MSG("Bench: failed to open synthetic package!");
+        });
+
+        PackageCache::enabled = true;
+        bench.Measure("package.openCached." + type.first, fileSize, [&] {
+            Package package;
+            if (package.Open(pristinePath) != 0)
+                CRASH_MSG("Bench: failed to open synthetic package!");
+        }, [&] {
+            Package package;
+            if (package.Open(pristinePath) != 0)
+                CRASH_MSG("Bench: failed to open synthetic package!");
+        });
+        PackageCache::Remove(pristinePath);
+        PackageCache::enabled = false;
+
+        Package readPackage;
+        if (readPackage.Open(pristinePath) != 0)
+            CRASH_MSG("Bench: failed to open synthetic package!");
+        bench.Measure("package.getData." + type.first, dataSize, [&] {
+            for (int i = 0; i < readPackage.exportsTable.count(); i++)
+            {
+                UniqueByteBuffer data = readPackage.getExportData(i);
+                data.Free();
+            }
+        }, [&] {
+            readPackage.DisposeCache();
+        });
+
+        Package *package = nullptr;
+        ByteBuffer newData = BenchData::GenerateData(exportSize, 3);
+        bench.Measure("package.SaveToFile." + type.first, dataSize, [&] {
+            if (!package->SaveToFile(false, false, false))
+                CRASH_MSG("Bench: failed to save synthetic package!");
+        }, [&] {
+            QFile::remove(path);
+            QFile::copy(pristinePath, path);
+            package = new Package();
+            if (package->Open(path, false, false, true) != 0)
+                CRASH_MSG("Bench: failed to open synthetic package!");
+            package->setExportData(0, newData);
+        }, [&] {
+            delete package;
+            package = nullptr;
+        });
+        newData.Free();
+        QFile::remove(path);
+    }
+}
+
+static void BenchImages(Bench &bench, int textureSize)
+{
+    qint64 pixelsSize = (qint64)textureSize * textureSize * 4;
+    for (auto format : benchPixelFormats)
+    {
+        QString formatName = PixelFormatName(format);
+        if (!bench.Enabled("image.encode." + formatName) &&
+            !bench.Enabled("image.decode." + formatName) &&
+            !bench.Enabled("image.toRGBA." + formatName))
+        {
+            continue;
+        }
+
+        Image *image = nullptr;
+        bench.Measure("image.encode." + formatName, pixelsSize, [&] {
+            image->correctMips(format, false, 128, 0.2f);
+        }, [&] {
+            image = new Image(textureSize, textureSize);
+            image->generateGradient();
+        }, [&] {
+            delete image;
+            image = nullptr;
+        });
+
+        ByteBuffer encoded = BenchData::GenerateTexture(textureSize, textureSize, format);
+        bench.Measure("image.decode." + formatName, pixelsSize, [&] {
+            ByteBuffer decoded = Image::convertRawToInternal(encoded, textureSize, textureSize, format);
+            decoded.Free();
+        });
+        bench.Measure("image.toRGBA." + formatName, pixelsSize, [&] {
+            ByteBuffer decoded = Image::convertRawToRGBA(encoded, textureSize, textureSize, format);
+            decoded.Free();
+        });
+        encoded.Free();
+    }
+}
+
+static void BenchMem(Bench &bench, int scale, int textureSize)
+{
+    const int texturesCount = 8 * scale;
+    QList<QPair<QString, CompressionDataType>> types{
+        { "zlib", CompressionDataType::Zlib },
+        { "lzma", CompressionDataType::LZMA },
+    };
+
+    for (const auto& type : types)
+    {
+        QString name = "mem.decompressData." + type.first;
+        if (!bench.Enabled(name))
+            continue;
+        QString path = g_GameData->GamePath() + "/Bench" + type.first + ".mem";
+        qint64 dataSize = BenchData::WriteMem(path, MeType::ME3_TYPE, texturesCount,
+                                              textureSize, type.second);
+
+        MemoryStream memFile(path);
+        QList<FileMod> modFiles;
+        memFile.Skip(8);
+        memFile.JumpTo(memFile.ReadInt64());
+        memFile.SkipInt32();
+        int numFiles = memFile.ReadInt32();
+        for (int i = 0; i < numFiles; i++)
+        {
+            FileMod fileMod{};
+            fileMod.tag = memFile.ReadUInt32();
+            memFile.ReadStringASCIINull(fileMod.name);
+            fileMod.offset = memFile.ReadInt64();
+            fileMod.size = memFile.ReadInt64();
+            fileMod.flags = memFile.ReadInt64();
+            modFiles.push_back(fileMod);
+        }
+
+        bench.Measure(name, dataSize, [&] {
+            for (const auto& fileMod : modFiles)
+            {
+                memFile.JumpTo(fileMod.offset + 8);
+                ByteBuffer data = Misc::decompressData(memFile, fileMod.size);
+                data.Free();
+            }
+        });
+        QFile::remove(path);
+    }
+}
+
+static int runBench(int argc, char *argv[])
+{
+    QCoreApplication application(argc, argv);
+    QCoreApplication::setOrganizationName(APP_NAME);
+    QCoreApplication::setApplicationName(APP_NAME);
+
+    g_logs->EnableOutputConsole(true);
+    g_logs->ChangeLogLevel(LOG_ERROR);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("MassEffectModder synthetic data benchmarks");
+    parser.addHelpOption();
+    QCommandLineOption outputOption("output", "Write JSON results to <file>.", "file");
+    QCommandLineOption iterationsOption("iterations", "Number of iterations per case.", "count", "5");
+    QCommandLineOption filterOption("filter", "Run only cases containing <text>.", "text");
+    QCommandLineOption scaleOption("scale", "Scale factor of synthetic data sizes.", "factor", "1");
+    QCommandLineOption textureSizeOption("texture-size", "Width and height of synthetic textures.", "pixels", "512");
+    QCommandLineOption oodleOption("oodle", "Path to Oodle library, enables Oodle cases.", "path");
+    parser.addOptions({ outputOption, iterationsOption, filterOption, scaleOption,
+                        textureSizeOption, oodleOption });
+    parser.process(application);
+
+    int scale = qMax(parser.value(scaleOption).toInt(), 1);
+    int textureSize = qMax(parser.value(textureSizeOption).toInt(), 4) & ~3;
+
+    bool oodle = false;
+    if (parser.isSet(oodleOption))
+    {
+#if defined(_WIN32)
+        oodle = OodleInitLib(parser.value(oodleOption).toStdWString().c_str());
+#else
+        oodle = OodleInitLib(parser.value(oodleOption).toStdString().c_str());
+#endif
+        if (!oodle)
+            PERROR("Failed to load Oodle library, Oodle cases skipped.\n");
+    }
+
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid())
+    {
+        PERROR("Failed to create temporary directory.\n");
+        return 1;
+    }
+
+    // Package cache is enabled only for its own cases
+    PackageCache::enabled = false;
+
+    CreateGameData();
+    g_GameData->InitPath(MeType::ME3_TYPE, tempDir.path());
+
+    Bench bench(parser.value(iterationsOption).toInt(), parser.value(filterOption));
+    BenchCrc(bench, scale);
+    BenchStreams(bench, scale);
+    BenchPackageCompression(bench, scale, oodle);
+    BenchPackages(bench, scale, oodle);
+    BenchImages(bench, textureSize);
+    BenchMem(bench, scale, textureSize);
+
+    ReleaseGameData();
+
+    QJsonObject environment;
+    environment["version"] = MEM_VERSION;
+    environment["threads"] = omp_get_max_threads();
+    environment["scale"] = scale;
+    environment["texture_size"] = textureSize;
+    environment["oodle"] = oodle;
+#ifdef BYTEBUFFER_COPY_STATS
+    environment["bytes_copied"] = ByteBuffer::CopiedBytes().load();
+#endif
+    QByteArray json = bench.ToJson(environment);
+
+    if (parser.isSet(outputOption))
+    {
+        FileStream fs = FileStream(parser.value(outputOption), FileMode::Create, FileAccess::WriteOnly);
+        fs.WriteFromBuffer(reinterpret_cast<quint8 *>(json.data()), json.size());
+    }
+    else
+    {
+        ConsoleWrite(QString::fromUtf8(json));
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    InstallSignalsHandler();
+    CreateLogs();
+
+    BC7InitializeLibrary();
+
+    int status = runBench(argc, argv);
+
+    BC7ShutdownLibrary();
+
+    OodleUninitLib();
+
+    ReleaseLogs();
+
+    return status;
+}
@@ -44,30 +44,32 @@ void DisplayHelp()
         "  --check-game-data-after --gameid <game id> [--ipc]\n" \
         "     Check game data for mods installed after textures installation.\n" \
         "\n" \
-        "  --check-game-data-mismatch --gameid <game id> [--ipc]\n" \
+        "  --check-game-data-mismatch --gameid <game id> [--force-rehash] [--ipc]\n" \
         "     Check game data with md5 database.\n" \
         "     Scan to detect mods\n" \
         "\n" \
-        "  --check-game-data-vanilla --gameid <game id> [--ipc]\n" \
+        "  --check-game-data-vanilla --gameid <game id> [--force-rehash] [--ipc]\n" \
         "     Check game data with md5 database.\n" \
+        "     force rehash: ignore cached checksums and calculate them again\n" \
         "\n" \
         "  --check-for-markers --gameid <game id> [--ipc]\n" \
         "     Check game data for markers.\n" \
         "\n" \
-        "  --install-mods --gameid <game id> --input <input dir> [--cache-amount <percent>]\n" \
+        "  --install-mods --gameid <game id> --input <input dir | .zip | .7z> [--cache-amount <percent>]\n" \
         "  [--repack] [--skip-markers] [--ipc] [--alot-mode] [--limit-2k] [--verify]\n" \
-        "     Install MEM mods from input directory.\n" \
+        "     Install MEM mods from input directory or archive.\n" \
+        "     MEM files inside zip archive are read in place without unpacking.\n" \
         "\n" \
-        "  --detect-mods --gameid <game id> [--ipc]\n" \
+        "  --detect-mods --gameid <game id> [--force-rehash] [--ipc]\n" \
         "     Detect compatible mods.\n" \
         "\n" \
-        "  --detect-bad-mods --gameid <game id> [--ipc]\n" \
+        "  --detect-bad-mods --gameid <game id> [--force-rehash] [--ipc]\n" \
         "     Detect not compatible mods.\n" \
         "\n" \
         "  --apply-lods-gfx --gameid <game id>\n" \
         "     Update GFX settings.\n" \
         "\n" \
-        "  --convert-to-mem --gameid <game id> --input <input dir> --output <output file> [--mark-to-convert] [--bc7-format] [--bc7-quality <num>] [--fast-mode] [--ipc]\n" \
+        "  --convert-to-mem --gameid <game id> --input <input dir> --output <output file> [--mark-to-convert] [--bc7-format] [--bc7-quality <num>] [--fast-mode] [--memory-budget <MB>] [--ipc]\n" \
         "     game id: 1 for ME1, 2 for ME2, 3 for ME3\n" \
         "     input dir: directory to be converted, containing following file extension(s):\n" \
         "        MEM, TPF\n" \
@@ -84,6 +86,7 @@ void DisplayHelp()
         "     fast mode: turn on fast compresson of MEM files\n" \
         "     ipc: turn on IPC traces\n" \
         "     BC7 quality: allow to change BC7 compression quality: 0.0 - 1.0. Default: 0.2\n" \
+        "     memory budget: limit of memory used by images converted in parallel. Default: half of RAM\n" \
         "\n" \
         "  --extract-mem --gameid <game id> --input <input dir/file> [--output <output dir>] [--ipc]\n" \
         "     game id: 1 for ME1, 2 for ME2, 3 for ME3\n" \
@@ -104,7 +107,7 @@ void DisplayHelp()
         "     Output file is DDS image\n" \
         "     BC7 quality: allow to change BC7 compression quality: 0.0 - 1.0. Default: 0.2\n" \
         "\n" \
-        "  --convert-game-images --gameid <game id> --input <input dir> --output <output dir> [--mark-to-convert] [--bc7-quality <num>]\n" \
+        "  --convert-game-images --gameid <game id> --input <input dir> --output <output dir> [--mark-to-convert] [--bc7-quality <num>] [--memory-budget <MB>]\n" \
         "     game id: 1 for ME1, 2 for ME2, 3 for ME3\n" \
         "     input dir: directory to be converted, containing following file extension(s):\n" \
         "        Input files with following extension:\n" \
@@ -117,6 +120,7 @@ void DisplayHelp()
         "              uncompressed ARGB/RGB/RGBX\n" \
         "           Image filename must include texture CRC (0xhhhhhhhh)\n" \
         "     output dir: directory where textures converted to DDS are placed\n" \
+        "     memory budget: limit of memory used by images converted in parallel. Default: half of RAM\n" \
         "     BC7 quality: allow to change BC7 compression quality: 0.0 - 1.0. Default: 0.2\n" \
         "\n" \
         "  --convert-image --format <output pixel format> [--threshold <dxt1 alpha threshold>] --input <input image> --output <output image> [--bc7-quality <num>]\n" \
@@ -187,6 +191,11 @@ void DisplayHelp()
         "\n" \
         "\n" \
         "  Additonal option to enable debug logs level to all commands: --debug-logs\n" \
+        "  Additonal option to bypass package tables cache for all commands: --no-package-cache\n" \
+        "\n" \
+        "  Additonal options for commands with IPC traces:\n" \
+        "     --ipc-progress-rate <ms>: minimal interval between progress events. Default: 100, 0 to send all\n" \
+        "     --ipc-socket <path>: send events to unix socket as 32-bit length prefixed UTF-8 frames\n" \
         "\n";
     PINFO(help);
 }
@@ -21,10 +21,14 @@
 
 #include <CmdLine/CmdLineParams.h>
 #include <CmdLine/CmdLineTools.h>
+#include <Helpers/IpcChannel.h>
 #include <Helpers/MiscHelpers.h>
 #include <Helpers/Logs.h>
 #include <GameData/GameData.h>
+#include <GameData/PackageCache.h>
 #include <GameData/TOCFile.h>
+#include <Md5/MD5Cache.h>
+#include <Misc/ImageBatch.h>
 #include <Misc/Misc.h>
 #include <Program/ConfigIni.h>
 #include <Types/MemTypes.h>
@@ -160,6 +164,18 @@ int ProcessArguments()
             g_ipc = true;
             args.removeAt(l--);
         }
+        else if (arg == "--ipc-progress-rate" && hasValue(args, l))
+        {
+            IpcChannel::progressIntervalMs = args[l + 1].toInt();
+            args.removeAt(l);
+            args.removeAt(l--);
+        }
+        else if (arg == "--ipc-socket" && hasValue(args, l))
+        {
+            IpcChannel::socketPath = args[l + 1];
+            args.removeAt(l);
+            args.removeAt(l--);
+        }
         else if (arg == "--input" && hasValue(args, l))
         {
             input = args[l + 1].replace('\\', '/');
@@ -303,6 +319,16 @@ int ProcessArguments()
             args.removeAt(l);
             args.removeAt(l--);
         }
+        else if (arg == "--force-rehash")
+        {
+            MD5Cache::forceRehash = true;
+            args.removeAt(l--);
+        }
+        else if (arg == "--no-package-cache")
+        {
+            PackageCache::enabled = false;
+            args.removeAt(l--);
+        }
         else if (arg == "--debug-logs")
         {
             g_logs->ChangeLogLevel(LOG_DEBUG);
@@ -324,6 +350,12 @@ int ProcessArguments()
             args.removeAt(l);
             args.removeAt(l--);
         }
+        else if (arg == "--memory-budget" && hasValue(args, l))
+        {
+            ImageBatch::memoryBudgetMB = args[l + 1].toInt();
+            args.removeAt(l);
+            args.removeAt(l--);
+        }
         else if ((arg == "--filter-with-ext" || arg == "--filter") && hasValue(args, l))
         {
             filter = args[l + 1];
@@ -347,18 +379,21 @@ int ProcessArguments()
         return 1;
     }
 
+    if (g_ipc)
+        IpcChannel::Start();
+
     switch (cmd)
     {
     case CmdType::VERSION:
         if (g_ipc)
         {
-            ConsoleWrite(QString("[IPC]VERSION %1\n").arg(MEM_VERSION));
+            IpcChannel::Send(IpcEvent::Version, QString::number(MEM_VERSION));
         }
         else
         {
             ConsoleWrite(QString("Version: %1\n").arg(MEM_VERSION));
+            ConsoleSync();
         }
-        ConsoleSync();
         break;
     case CmdType::SCAN:
         if (gameId == MeType::UNKNOWN_TYPE)
@@ -485,9 +520,9 @@ int ProcessArguments()
             errorCode = 1;
             break;
         }
-        if (!QDir(input).exists())
+        if (!QDir(input).exists() && !QFile(input).exists())
         {
-            PERROR("Input folder doesn't exists! " + input + "\n");
+            PERROR("Input folder or archive doesn't exists! " + input + "\n");
             errorCode = 1;
             break;
         }
@@ -21,10 +21,14 @@
 
 #include <CmdLine/CmdLineTools.h>
 #include <GameData/GameData.h>
+#include <GameData/MarkersManifest.h>
 #include <GameData/UserSettings.h>
 #include <GameData/TOCFile.h>
+#include <Helpers/ArchiveStream.h>
+#include <Helpers/IpcChannel.h>
 #include <Helpers/MiscHelpers.h>
 #include <Helpers/Logs.h>
+#include <Misc/ImageBatch.h>
 #include <Misc/Misc.h>
 #include <MipMaps/MipMaps.h>
 #include <Program/ConfigIni.h>
@@ -33,6 +37,7 @@
 #include <Texture/Texture.h>
 #include <Texture/TextureMovie.h>
 #include <Texture/TextureScan.h>
+#include <Texture/TextureView.h>
 #include <Types/MemTypes.h>
 
 int CmdLineTools::scan(MeType gameId)
@@ -63,7 +68,7 @@ int CmdLineTools::scan(MeType gameId)
 
         for (int e = 0; e < package.exportsTable.count(); e++)
         {
-            ByteBuffer exportData = package.getExportData(e);
+            UniqueByteBuffer exportData = package.getExportData(e);
             if (exportData.ptr() == nullptr)
             {
                 PERROR(QString("Error: broken export data in package: " +
@@ -98,11 +103,9 @@ int CmdLineTools::scanTextures(MeType gameId)
     PINFO("Scan textures started...\n");
 
     QList<TextureMapEntry> textures;
-    Resources resources;
 
-    resources.loadMD5Tables();
     Misc::startTimer();
-    errorCode = TreeScan::PrepareListOfTextures(gameId, resources, textures, true, nullptr, nullptr);
+    errorCode = TreeScan::PrepareListOfTextures(gameId, textures, true, nullptr, nullptr);
     long elapsed = Misc::elapsedTime();
     PINFO(Misc::getTimerFormat(elapsed) + "\n");
 
@@ -132,8 +135,7 @@ bool CmdLineTools::GetGamePaths()
 
     if (g_ipc)
     {
-        ConsoleWrite(QString("[IPC]GAMEPATH ") + pathData);
-        ConsoleSync();
+        IpcChannel::Send(IpcEvent::GamePath, pathData);
     }
     else
     {
@@ -228,9 +230,7 @@ bool CmdLineTools::ConvertToMEM(MeType gameId, QString &inputDir, QString &memFi
                                 bool markToConvert, bool bc7format, float bc7quality)
 {
     QList<TextureMapEntry> textures;
-    Resources resources;
-    resources.loadMD5Tables();
-    TreeScan::loadTexturesMap(gameId, resources, textures);
+    TreeScan::loadTexturesMap(gameId, textures);
 
     QFileInfoList list;
     QFileInfoList list2;
@@ -303,20 +303,16 @@ bool CmdLineTools::convertGameTexture(const QString &inputFile,
 bool CmdLineTools::convertGameImage(MeType gameId, QString &inputFile, QString &outputFile, bool markToConvert, float bc7quality)
 {
     QList<TextureMapEntry> textures;
-    Resources resources;
-    resources.loadMD5Tables();
 
-    TreeScan::loadTexturesMap(gameId, resources, textures);
+    TreeScan::loadTexturesMap(gameId, textures);
     return convertGameTexture(inputFile, outputFile, textures, markToConvert, bc7quality);
 }
 
 bool CmdLineTools::convertGameImages(MeType gameId, QString &inputDir, QString &outputDir, bool markToConvert, float bc7quality)
 {
     QList<TextureMapEntry> textures;
-    Resources resources;
-    resources.loadMD5Tables();
 
-    TreeScan::loadTexturesMap(gameId, resources, textures);
+    TreeScan::loadTexturesMap(gameId, textures);
 
     inputDir = QDir::cleanPath(inputDir);
     QFileInfoList list;
@@ -328,14 +324,22 @@ bool CmdLineTools::convertGameImages(MeType gameId, QString &inputDir, QString &
     outputDir = QDir::cleanPath(outputDir);
     QDir().mkpath(outputDir);
 
-    bool status = true;
-    foreach (QFileInfo file, list)
+    QVector<qint64> estimates(list.count());
+    for (int i = 0; i < list.count(); i++)
     {
-        QString outputFile = outputDir + "/" + BaseNameWithoutExt(file.fileName()) + ".dds";
-        if (!convertGameTexture(file.absoluteFilePath(), outputFile, textures, markToConvert, bc7quality))
-            status = false;
+        TextureMapEntry foundTex = Misc::FoundTextureInTheMap(textures,
+                                                              Misc::scanFilenameForCRC(list[i].absoluteFilePath()));
+        estimates[i] = ImageBatch::EstimateMemory(foundTex.width, foundTex.height, foundTex.pixfmt, list[i].size());
     }
 
+    std::atomic<bool> status(true);
+    ImageBatch::Run(estimates, [&](int index)
+    {
+        QString outputFile = outputDir + "/" + BaseNameWithoutExt(list[index].fileName()) + ".dds";
+        if (!convertGameTexture(list[index].absoluteFilePath(), outputFile, textures, markToConvert, bc7quality))
+            status = false;
+    });
+
     return status;
 }
 
@@ -464,10 +468,7 @@ bool CmdLineTools::CheckGameDataAndMods(MeType gameId)
     if (!Misc::CheckGamePath())
         return false;
 
-    Resources resources;
-    resources.loadMD5Tables();
-
-    return Misc::CheckGameDataAndMods(gameId, resources);
+    return Misc::CheckGameDataAndMods(gameId);
 }
 
 bool CmdLineTools::CheckForMarkers(MeType gameId)
@@ -504,33 +505,120 @@ bool CmdLineTools::InstallMods(MeType gameId, QString &inputDir,
                                bool alotMode, bool skipMarkers,
                                bool verify, int cacheAmount)
 {
-    Resources resources;
-    resources.loadMD5Tables();
     ConfigIni configIni = ConfigIni();
     g_GameData->Init(gameId, configIni);
     if (!Misc::CheckGamePath())
         return false;
 
-    auto files = QDir(inputDir, "*.mem",
-                      QDir::SortFlag::Name | QDir::SortFlag::IgnoreCase,
-                      QDir::Files | QDir::NoDotAndDotDot | QDir::NoSymLinks).entryInfoList();
     QStringList modFiles;
-    foreach (QFileInfo file, files)
+    QString modsDir = inputDir;
+    QString unpackDir;
+    if (QFileInfo(inputDir).isFile())
     {
-        modFiles.push_back(file.absoluteFilePath());
+        if (ArchiveStream::IsArchive(inputDir))
+        {
+            // Compressed entries decode only forward while textures are read
+            // back out of order, unpack those once and keep stored ones in place
+            unpackDir = QDir::tempPath() + QString("/MEM-%1").arg(QCoreApplication::applicationPid());
+            QStringList entries = ArchiveStream::ListEntries(inputDir, "mem");
+            for (int i = 0; i < entries.count(); i++)
+            {
+                ArchiveStream stream(inputDir, ArchiveStream::EntryFromEntryPath(entries[i]));
+                if (!stream.isOpen())
+                {
+                    PERROR("Failed to open MEM mod file: " + entries[i] + "\n");
+                    continue;
+                }
+                if (stream.isStored())
+                {
+                    modFiles.push_back(entries[i]);
+                    continue;
+                }
+                QString outputDir = unpackDir + QString("/%1").arg(i);
+                QString outputFile = outputDir + "/" + BaseName(ArchiveStream::EntryFromEntryPath(entries[i]));
+                QDir().mkpath(outputDir);
+                if (!stream.ExtractTo(outputFile))
+                {
+                    PERROR("Failed to unpack MEM mod file: " + entries[i] + "\n");
+                    QFile(outputFile).remove();
+                    continue;
+                }
+                modFiles.push_back(outputFile);
+            }
+            if (modFiles.count() == 0)
+            {
+                PERROR("No MEM files found in archive: " + inputDir + "\n");
+                QDir(unpackDir).removeRecursively();
+                return false;
+            }
+        }
+        else if (inputDir.endsWith(".7z", Qt::CaseInsensitive))
+        {
+            // No streaming decoder for 7z, unpack only MEM files. Keep archive
+            // folders, same named mods in different folders must not collide
+            unpackDir = QDir::tempPath() + QString("/MEM-%1").arg(QCoreApplication::applicationPid());
+            QDir().mkpath(unpackDir);
+#if defined(_WIN32)
+            int result = SevenZipUnpack(inputDir.toStdWString().c_str(), unpackDir.toStdWString().c_str(),
+                                        L"mem", true);
+#else
+            int result = SevenZipUnpack(inputDir.toStdString().c_str(), unpackDir.toStdString().c_str(),
+                                        "mem", true);
+#endif
+            if (result != 0)
+            {
+                PERROR("Failed to unpack MEM files from archive: " + inputDir + "\n");
+                QDir(unpackDir).removeRecursively();
+                return false;
+            }
+            QDirIterator iterator(unpackDir, QDir::Files | QDir::NoSymLinks, QDirIterator::Subdirectories);
+            while (iterator.hasNext())
+            {
+                iterator.next();
+                if (iterator.fileName().endsWith(".mem", Qt::CaseInsensitive))
+                    modFiles.push_back(iterator.filePath());
+            }
+            // Same order as entries listed from zip archive
+            modFiles.sort(Qt::CaseInsensitive);
+            if (modFiles.count() == 0)
+            {
+                PERROR("No MEM files found in archive: " + inputDir + "\n");
+                QDir(unpackDir).removeRecursively();
+                return false;
+            }
+        }
+        else
+        {
+            PERROR("Input archive type not supported: " + inputDir + "\n");
+            return false;
+        }
+    }
+
+    if (modFiles.count() == 0)
+    {
+        auto files = QDir(modsDir, "*.mem",
+                          QDir::SortFlag::Name | QDir::SortFlag::IgnoreCase,
+                          QDir::Files | QDir::NoDotAndDotDot | QDir::NoSymLinks).entryInfoList();
+        foreach (QFileInfo file, files)
+        {
+            modFiles.push_back(file.absoluteFilePath());
+        }
     }
 
-    return Misc::InstallMods(gameId, resources, modFiles,
-                             false, alotMode, skipMarkers, verify, cacheAmount,
-                             nullptr, nullptr);
+    bool status = Misc::InstallMods(gameId, modFiles,
+                                    false, alotMode, skipMarkers, verify, cacheAmount,
+                                    nullptr, nullptr);
+
+    if (!unpackDir.isEmpty())
+        QDir(unpackDir).removeRecursively();
+
+    return status;
 }
 
 bool CmdLineTools::extractAllTextures(MeType gameId, QString &outputDir, QString &inputFile,
                                       bool png, bool pccOnly, bool tfcOnly, bool mapCrc,
                                       QString &textureTfcFilter, bool clearAlpha)
 {
-    Resources resources;
-    resources.loadMD5Tables();
     ConfigIni configIni = ConfigIni();
     g_GameData->Init(gameId, configIni);
     if (!Misc::CheckGamePath())
@@ -538,7 +626,7 @@ bool CmdLineTools::extractAllTextures(MeType gameId, QString &outputDir, QString
 
     QList<TextureMapEntry> textures;
     if (mapCrc)
-        TreeScan::loadTexturesMap(gameId, resources, textures);
+        TreeScan::loadTexturesMap(gameId, textures);
 
     QStringList packages;
     if (inputFile != "")
@@ -559,7 +647,13 @@ bool CmdLineTools::extractAllTextures(MeType gameId, QString &outputDir, QString
 
     QDir().mkpath(outputDir);
 
-    for (int p = 0; p < packages.count(); p++)
+    // Textures shared between packages are extracted once, by the first package claiming its CRC
+    QSet<uint> claimedCrcs;
+    std::mutex claimedCrcsLock;
+    std::atomic<int> pendingPngWrites(0);
+    int maxPendingPngWrites = omp_get_max_threads() * 2;
+
+    auto extractPackage = [&](int p)
     {
         PINFO(QString("Package ") + QString::number(p + 1) + "/" +
                              QString::number(packages.count()) + " : " +
@@ -569,7 +663,7 @@ bool CmdLineTools::extractAllTextures(MeType gameId, QString &outputDir, QString
         if (package.Open(g_GameData->GamePath() + packages[p]) != 0)
         {
             PERROR(QString("ERROR: Issue opening package file: ") + packages[p] + "\n");
-            continue;
+            return;
         }
 
         for (int e = 0; e < package.exportsTable.count(); e++)
@@ -581,7 +675,19 @@ bool CmdLineTools::extractAllTextures(MeType gameId, QString &outputDir, QString
                 id == package.nameIdShadowMapTexture2D ||
                 id == package.nameIdTextureFlipBook)
             {
-                ByteBuffer exportData = package.getExportData(e);
+                uint crc = 0;
+                if (mapCrc)
+                {
+                    crc = Misc::GetCRCFromTextureMap(textures, e, packages[p]);
+                    if (crc != 0)
+                    {
+                        std::lock_guard<std::mutex> guard(claimedCrcsLock);
+                        if (claimedCrcs.contains(crc))
+                            continue;
+                    }
+                }
+
+                UniqueByteBuffer exportData = package.getExportData(e);
                 if (exportData.ptr() == nullptr)
                 {
                     PERROR(QString("Error: Texture ") + exp.objectName +
@@ -589,8 +695,7 @@ bool CmdLineTools::extractAllTextures(MeType gameId, QString &outputDir, QString
                                  packages[p] +"\nExport Id: " + QString::number(e + 1) + "\nSkipping...\n");
                     continue;
                 }
-                Texture texture(package, e, exportData);
-                exportData.Free();
+                TextureView texture(package, e, std::move(exportData));
                 if (!texture.hasImageData())
                 {
                     continue;
@@ -615,9 +720,6 @@ bool CmdLineTools::extractAllTextures(MeType gameId, QString &outputDir, QString
                     }
                 }
                 QString name = exp.objectName;
-                uint crc = 0;
-                if (mapCrc)
-                    crc = Misc::GetCRCFromTextureMap(textures, e, packages[p]);
                 if (crc == 0)
                     crc = texture.getCrcTopMipmap();
                 if (crc == 0)
@@ -626,6 +728,12 @@ bool CmdLineTools::extractAllTextures(MeType gameId, QString &outputDir, QString
                                  packages[p] +"\nExport Id: " + QString::number(e + 1) + "\nSkipping...\n");
                     continue;
                 }
+                {
+                    std::lock_guard<std::mutex> guard(claimedCrcsLock);
+                    if (claimedCrcs.contains(crc))
+                        continue;
+                    claimedCrcs.insert(crc);
+                }
                 QString outputFile = outputDir + "/" +  name + QString::asprintf("_0x%08X", crc);
                 if (png)
                 {
@@ -652,18 +760,37 @@ bool CmdLineTools::extractAllTextures(MeType gameId, QString &outputDir, QString
                 {
                     storeAs16Bits = true;
                 }
-                if (!clearAlpha)
-                    clearAlpha = (pixelFormat == PixelFormat::DXT1) && !oneBitAlpha;
+                bool textureClearAlpha = clearAlpha || ((pixelFormat == PixelFormat::DXT1) && !oneBitAlpha);
                 if (png)
                 {
                     Texture::TextureMipMap mipmap = texture.getTopMipmap();
                     ByteBuffer data = texture.getTopImageData();
                     if (data.ptr() != nullptr)
                     {
-                        if (QFile(outputFile).exists())
-                            QFile(outputFile).remove();
-                        Image::saveToPng(data, mipmap.width, mipmap.height, pixelFormat, outputFile, !storeAs16Bits, clearAlpha);
-                        data.Free();
+                        // PNG encoding is handed over to writer tasks, unless too many are pending already
+                        std::atomic<int> *pending = &pendingPngWrites;
+                        if (pending->fetch_add(1) < maxPendingPngWrites)
+                        {
+                            #pragma omp task firstprivate(data, mipmap, pixelFormat, outputFile, storeAs16Bits, textureClearAlpha, pending)
+                            {
+                                Image::saveToPng(data, mipmap.width, mipmap.height, pixelFormat, outputFile, !storeAs16Bits, textureClearAlpha);
+                                data.Free();
+                                (*pending)--;
+                            }
+                        }
+                        else
+                        {
+                            (*pending)--;
+                            Image::saveToPng(data, mipmap.width, mipmap.height, pixelFormat, outputFile, !storeAs16Bits, textureClearAlpha);
+                            data.Free();
+                        }
+                    }
+                    else
+                    {
+                        PERROR(QString("Texture skipped. Texture ") + name +
+                                     QString::asprintf("_0x%08X", crc) + " is broken in game data!\n");
+                        std::lock_guard<std::mutex> guard(claimedCrcsLock);
+                        claimedCrcs.remove(crc);
                     }
                 }
                 else
@@ -677,14 +804,11 @@ bool CmdLineTools::extractAllTextures(MeType gameId, QString &outputDir, QString
                         {
                             continue;
                         }
-                        mipmaps.push_back(new MipMap(data, texture.mipMapsList[k].width, texture.mipMapsList[k].height, pixelFormat));
-                        data.Free();
+                        mipmaps.push_back(new MipMap(UniqueByteBuffer(std::move(data)), texture.mipMapsList[k].width, texture.mipMapsList[k].height, pixelFormat));
                     }
                     Image image = Image(mipmaps, pixelFormat);
                     if (image.getMipMaps().count() != 0)
                     {
-                        if (QFile(outputFile).exists())
-                            QFile(outputFile).remove();
                         FileStream fs = FileStream(outputFile, FileMode::Create, FileAccess::WriteOnly);
                         image.StoreImageToDDS(fs);
                     }
@@ -692,10 +816,20 @@ bool CmdLineTools::extractAllTextures(MeType gameId, QString &outputDir, QString
                     {
                         PERROR(QString("Texture skipped. Texture ") + name +
                                      QString::asprintf("_0x%08X", crc) + " is broken in game data!\n");
+                        std::lock_guard<std::mutex> guard(claimedCrcsLock);
+                        claimedCrcs.remove(crc);
                     }
                 }
             }
         }
+    };
+
+    #pragma omp parallel
+    #pragma omp single
+    for (int p = 0; p < packages.count(); p++)
+    {
+        #pragma omp task firstprivate(p)
+        extractPackage(p);
     }
 
     PINFO("Extracting textures completed.\n\n");
@@ -706,8 +840,6 @@ bool CmdLineTools::extractAllMovieTextures(MeType gameId, QString &outputDir, QS
                                            bool pccOnly, bool tfcOnly, bool mapCrc,
                                            QString &textureTfcFilter)
 {
-    Resources resources;
-    resources.loadMD5Tables();
     ConfigIni configIni = ConfigIni();
     g_GameData->Init(gameId, configIni);
     if (!Misc::CheckGamePath())
@@ -715,7 +847,7 @@ bool CmdLineTools::extractAllMovieTextures(MeType gameId, QString &outputDir, QS
 
     QList<TextureMapEntry> textures;
     if (mapCrc)
-        TreeScan::loadTexturesMap(gameId, resources, textures);
+        TreeScan::loadTexturesMap(gameId, textures);
 
     QStringList packages;
     if (inputFile != "")
@@ -755,7 +887,7 @@ bool CmdLineTools::extractAllMovieTextures(MeType gameId, QString &outputDir, QS
             int id = package.getClassNameId(exp.getClassId());
             if (id == package.nameIdTextureMovie)
             {
-                ByteBuffer exportData = package.getExportData(e);
+                UniqueByteBuffer exportData = package.getExportData(e);
                 if (exportData.ptr() == nullptr)
                 {
                     PERROR(QString("Error: Movie Texture ") + exp.objectName +
@@ -831,7 +963,7 @@ bool CmdLineTools::CheckTextures(MeType gameId)
         Package package;
         if (g_ipc)
         {
-            ConsoleWrite(QString("[IPC]PROCESSING_FILE ") + g_GameData->packageFiles[i]);
+            IpcChannel::Send(IpcEvent::ProcessingFile, g_GameData->packageFiles[i]);
         }
         else
         {
@@ -842,17 +974,15 @@ bool CmdLineTools::CheckTextures(MeType gameId)
         int newProgress = (i + 1) * 100 / g_GameData->packageFiles.count();
         if (g_ipc && lastProgress != newProgress)
         {
-            ConsoleWrite(QString("[IPC]TASK_PROGRESS ") + QString::number(newProgress));
-            ConsoleSync();
+            IpcChannel::Progress(newProgress);
             lastProgress = newProgress;
         }
         if (package.Open(g_GameData->GamePath() + g_GameData->packageFiles[i]) != 0)
         {
             if (g_ipc)
             {
-                ConsoleWrite(QString("[IPC]ERROR_TEXTURE_SCAN_DIAGNOSTIC Error opening package file: ") +
-                             g_GameData->packageFiles[i]);
-                ConsoleSync();
+                IpcChannel::Send(IpcEvent::ErrorTextureScanDiagnostic, QString("Error opening package file: ") +
+                                 g_GameData->packageFiles[i]);
             }
             else
             {
@@ -873,9 +1003,8 @@ bool CmdLineTools::CheckTextures(MeType gameId)
                 id == package.nameIdShadowMapTexture2D ||
                 id == package.nameIdTextureFlipBook)
             {
-                ByteBuffer exportData = package.getExportData(e);
-                Texture texture(package, e, exportData);
-                exportData.Free();
+                UniqueByteBuffer exportData = package.getExportData(e);
+                TextureView texture(package, e, std::move(exportData));
                 texture.removeEmptyMips();
                 for (int m = 0; m < texture.mipMapsList.count(); m++)
                 {
@@ -884,10 +1013,9 @@ bool CmdLineTools::CheckTextures(MeType gameId)
                     {
                         if (g_ipc)
                         {
-                            ConsoleWrite(QString("[IPC]ERROR_TEXTURE_SCAN_DIAGNOSTIC Issue opening texture data: ") +
-                                        package.exportsTable[e].objectName + ", mipmap: " + QString::number(m) + ", package: " +
-                                        g_GameData->packageFiles[i] + ", export id: " + QString::number(e + 1));
-                            ConsoleSync();
+                            IpcChannel::Send(IpcEvent::ErrorTextureScanDiagnostic, QString("Issue opening texture data: ") +
+                                             package.exportsTable[e].objectName + ", mipmap: " + QString::number(m) + ", package: " +
+                                             g_GameData->packageFiles[i] + ", export id: " + QString::number(e + 1));
                         }
                         else
                         {
@@ -923,26 +1051,29 @@ bool CmdLineTools::checkGameFilesAfter(MeType gameType)
             continue;
         filesToUpdate.push_back(g_GameData->packageFiles[i]);
     }
+    MarkersManifest manifest(gameType);
+    QVector<bool> markers(filesToUpdate.count());
+    #pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < filesToUpdate.count(); i++)
+    {
+        markers[i] = manifest.HasMarker(filesToUpdate[i]);
+    }
+    manifest.Save();
+
     int lastProgress = -1;
     for (int i = 0; i < filesToUpdate.count(); i++)
     {
         int newProgress = (i + 1) * 100 / filesToUpdate.count();
         if (g_ipc && lastProgress != newProgress)
         {
-            ConsoleWrite(QString("[IPC]TASK_PROGRESS ") + QString::number(newProgress));
-            ConsoleSync();
+            IpcChannel::Progress(newProgress);
             lastProgress = newProgress;
         }
-        FileStream fs = FileStream(g_GameData->GamePath() + filesToUpdate[i], FileMode::Open, FileAccess::ReadOnly);
-        fs.Seek(-MEMMarkerLength, SeekOrigin::End);
-        QString marker;
-        fs.ReadStringASCII(marker, MEMMarkerLength);
-        if (marker != QString(MEMendFileMarker))
+        if (!markers[i])
         {
             if (g_ipc)
             {
-                ConsoleWrite(QString("[IPC]ERROR_VANILLA_MOD_FILE ") + filesToUpdate[i]);
-                ConsoleSync();
+                IpcChannel::Send(IpcEvent::ErrorVanillaModFile, filesToUpdate[i]);
             }
             else
             {
@@ -966,15 +1097,12 @@ bool CmdLineTools::detectsMismatchPackagesAfter(MeType gameType)
     QString path = QStandardPaths::standardLocations(QStandardPaths::GenericConfigLocation).first() +
             "/MassEffectModder";
     QString mapFile = path + QString("/mele%1map.bin").arg((int)gameType);
-    FileStream fs = FileStream(mapFile, FileMode::Open, FileAccess::ReadOnly);
-    uint tag = fs.ReadUInt32();
-    uint version = fs.ReadUInt32();
-    if (tag != textureMapBinTag || version != textureMapBinVersion)
+    QStringList packages = QStringList();
+    if (!TreeScan::loadTexturesMapPackages(mapFile, packages))
     {
         if (g_ipc)
         {
-            ConsoleWrite("[IPC]ERROR_TEXTURE_MAP_WRONG");
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::ErrorTextureMapWrong);
         }
         else
         {
@@ -982,29 +1110,6 @@ bool CmdLineTools::detectsMismatchPackagesAfter(MeType gameType)
         }
         return false;
     }
-
-    uint countTexture = fs.ReadUInt32();
-    for (uint i = 0; i < countTexture; i++)
-    {
-        fs.Skip(fs.ReadInt32());
-        fs.SkipInt32();
-        uint countPackages = fs.ReadUInt32();
-        for (uint k = 0; k < countPackages; k++)
-        {
-            fs.Skip(8);
-            fs.Skip(fs.ReadInt32());
-        }
-    }
-
-    QStringList packages = QStringList();
-    int numPackages = fs.ReadInt32();
-    for (int i = 0; i < numPackages; i++)
-    {
-        QString pkgPath;
-        fs.ReadStringASCII(pkgPath, fs.ReadInt32());
-        pkgPath.replace(QChar('\\'), QChar('/'));
-        packages.push_back(pkgPath);
-    }
     PINFO("Checking for removed files since last game data scan...\n");
     for (int i = 0; i < packages.count(); i++)
     {
@@ -1012,8 +1117,7 @@ bool CmdLineTools::detectsMismatchPackagesAfter(MeType gameType)
         {
             if (g_ipc)
             {
-                ConsoleWrite(QString("[IPC]ERROR_REMOVED_FILE ") + packages[i]);
-                ConsoleSync();
+                IpcChannel::Send(IpcEvent::ErrorRemovedFile, packages[i]);
             }
             else
             {
@@ -1030,8 +1134,7 @@ bool CmdLineTools::detectsMismatchPackagesAfter(MeType gameType)
         {
             if (g_ipc)
             {
-                ConsoleWrite(QString("[IPC]ERROR_ADDED_FILE ") + g_GameData->packageFiles[i]);
-                ConsoleSync();
+                IpcChannel::Send(IpcEvent::ErrorAddedFile, g_GameData->packageFiles[i]);
             }
             else
             {
@@ -0,0 +1,236 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include <GameData/FileInventory.h>
+#include <Helpers/MiscHelpers.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
+
+#include <condition_variable>
+
+void FileInventory::ScanDirectory(const QString &basePath, const QString &relativeDir,
+                                  QVector<Entry> &files, QStringList &dirs)
+{
+#if defined(_WIN32)
+    QString pattern = QDir::toNativeSeparators(basePath + relativeDir) + "\\*";
+    WIN32_FIND_DATAW data;
+    HANDLE handle = FindFirstFileExW(reinterpret_cast<const wchar_t *>(pattern.utf16()),
+                                     FindExInfoBasic, &data, FindExSearchNameMatch,
+                                     nullptr, FIND_FIRST_EX_LARGE_FETCH);
+    if (handle == INVALID_HANDLE_VALUE)
+        return;
+    do
+    {
+        QString name = QString::fromWCharArray(data.cFileName);
+        if (name == "." || name == "..")
+            continue;
+        if (data.dwFileAttributes & (FILE_ATTRIBUTE_REPARSE_POINT | FILE_ATTRIBUTE_HIDDEN))
+            continue;
+        QString path = relativeDir + "/" + name;
+        if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        {
+            dirs.push_back(path);
+            continue;
+        }
+        Entry entry{};
+        entry.path = path;
+        entry.size = (static_cast<qint64>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+        entry.mtime = (static_cast<qint64>(data.ftLastWriteTime.dwHighDateTime) << 32) |
+                      data.ftLastWriteTime.dwLowDateTime;
+        entry.inode = 0;
+        files.push_back(entry);
+    } while (FindNextFileW(handle, &data));
+    FindClose(handle);
+#else
+    DIR *dir = opendir(QFile::encodeName(basePath + relativeDir).constData());
+    if (dir == nullptr)
+        return;
+    int fd = dirfd(dir);
+    struct dirent *dirEntry;
+    while ((dirEntry = readdir(dir)) != nullptr)
+    {
+        const char *name = dirEntry->d_name;
+        if (name[0] == '.')
+            continue;
+        unsigned char type = dirEntry->d_type;
+        if (type == DT_DIR)
+        {
+            dirs.push_back(relativeDir + "/" + QFile::decodeName(name));
+            continue;
+        }
+        if (type != DT_REG && type != DT_UNKNOWN)
+            continue;
+
+        // One stat per file, relative to the open directory
+        struct stat st{};
+        if (fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0)
+            continue;
+        if (S_ISDIR(st.st_mode))
+        {
+            dirs.push_back(relativeDir + "/" + QFile::decodeName(name));
+            continue;
+        }
+        if (!S_ISREG(st.st_mode))
+            continue;
+        Entry entry{};
+        entry.path = relativeDir + "/" + QFile::decodeName(name);
+        entry.size = st.st_size;
+#if defined(__APPLE__)
+        entry.mtime = static_cast<qint64>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+        entry.mtime = static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+        entry.inode = st.st_ino;
+        files.push_back(entry);
+    }
+    closedir(dir);
+#endif
+}
+
+void FileInventory::Scan(const QString &base, const QStringList &roots)
+{
+    Clear();
+    basePath = base;
+
+    QStringList pendingDirs = roots;
+    int activeWorkers = 0;
+    std::mutex queueLock;
+    std::condition_variable queueWakeup;
+
+    // Directories are listed by a pool of workers pulling from shared queue,
+    // subdirectories found are pushed back for any idle worker.
+    int numThreads = qBound(INVENTORY_MIN_THREADS, omp_get_max_threads() * 2, INVENTORY_MAX_THREADS);
+    #pragma omp parallel num_threads(numThreads)
+    {
+        QVector<Entry> localFiles;
+#ifdef GUI
+        // Main thread only keeps UI responsive while others list directories
+        if (omp_get_thread_num() == 0 && omp_get_num_threads() > 1)
+        {
+            std::unique_lock<std::mutex> guard(queueLock);
+            while (!pendingDirs.isEmpty() || activeWorkers != 0)
+            {
+                queueWakeup.wait_for(guard, std::chrono::milliseconds(100));
+                guard.unlock();
+                QApplication::processEvents();
+                guard.lock();
+            }
+        }
+        else
+#endif
+        while (true)
+        {
+            QString relativeDir;
+            {
+                std::unique_lock<std::mutex> guard(queueLock);
+                queueWakeup.wait(guard, [&] { return !pendingDirs.isEmpty() || activeWorkers == 0; });
+                if (pendingDirs.isEmpty())
+                    break;
+                relativeDir = pendingDirs.takeLast();
+                activeWorkers++;
+            }
+
+            QStringList dirs;
+            ScanDirectory(basePath, relativeDir, localFiles, dirs);
+
+            {
+                std::unique_lock<std::mutex> guard(queueLock);
+                pendingDirs += dirs;
+                activeWorkers--;
+            }
+            queueWakeup.notify_all();
+        }
+
+        std::unique_lock<std::mutex> guard(queueLock);
+        entries += localFiles;
+    }
+
+    for (auto &entry : entries)
+        entry.key = entry.path.toLower();
+    std::sort(entries.begin(), entries.end(), [](const Entry &e1, const Entry &e2)
+    {
+        return e1.key < e2.key;
+    });
+    index.reserve(entries.count());
+    for (int i = 0; i < entries.count(); i++)
+        index.insert(entries[i].key, i);
+}
+
+void FileInventory::Clear()
+{
+    entries.clear();
+    index.clear();
+}
+
+const FileInventory::Entry *FileInventory::Find(const QString &relativePath) const
+{
+    auto it = index.constFind(relativePath.toLower());
+    if (it == index.constEnd())
+        return nullptr;
+    return &entries[it.value()];
+}
+
+QVector<const FileInventory::Entry *> FileInventory::Files(const QString &relativeDir, bool recursive) const
+{
+    QVector<const Entry *> files;
+    QString prefix = relativeDir.toLower() + "/";
+    auto it = std::lower_bound(entries.begin(), entries.end(), prefix, [](const Entry &e, const QString &key)
+    {
+        return e.key < key;
+    });
+    for (; it != entries.end() && it->key.startsWith(prefix); it++)
+    {
+        if (!recursive && it->key.indexOf('/', prefix.length()) != -1)
+            continue;
+        files.push_back(&(*it));
+    }
+    return files;
+}
+
+QStringList FileInventory::SubDirs(const QString &relativeDir) const
+{
+    QStringList dirs;
+    QString prefix = relativeDir.toLower() + "/";
+    QString lastKey;
+    auto it = std::lower_bound(entries.begin(), entries.end(), prefix, [](const Entry &e, const QString &key)
+    {
+        return e.key < key;
+    });
+    for (; it != entries.end() && it->key.startsWith(prefix); it++)
+    {
+        int end = it->key.indexOf('/', prefix.length());
+        if (end == -1)
+            continue;
+        QString key = it->key.mid(prefix.length(), end - prefix.length());
+        if (key == lastKey)
+            continue;
+        lastKey = key;
+        dirs.push_back(it->path.mid(prefix.length(), end - prefix.length()));
+    }
+    return dirs;
+}
@@ -0,0 +1,62 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#ifndef FILE_INVENTORY_H
+#define FILE_INVENTORY_H
+
+#define INVENTORY_MIN_THREADS 4
+#define INVENTORY_MAX_THREADS 16
+
+class FileInventory
+{
+public:
+
+    struct Entry
+    {
+        QString path;
+        QString key;
+        qint64 size;
+        qint64 mtime;
+        quint64 inode;
+    };
+
+private:
+
+    QString basePath;
+    QVector<Entry> entries;
+    QHash<QString, int> index;
+
+    static void ScanDirectory(const QString &basePath, const QString &relativeDir,
+                              QVector<Entry> &files, QStringList &dirs);
+
+public:
+
+    void Scan(const QString &base, const QStringList &roots);
+    void Clear();
+    bool isEmpty() const { return entries.isEmpty(); }
+    const QVector<Entry> &Entries() const { return entries; }
+    const Entry *Find(const QString &relativePath) const;
+    QVector<const Entry *> Files(const QString &relativeDir, bool recursive) const;
+    QStringList SubDirs(const QString &relativeDir) const;
+};
+
+#endif
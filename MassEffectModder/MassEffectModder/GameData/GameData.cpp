@@ -56,20 +56,13 @@ void GameData::ScanGameFiles(bool force, const QString &filterPath)
         QElapsedTimer timer;
         timer.start();
 #endif
-        QStringList files;
-        QDirIterator iterator(MainData(), QDir::Files | QDir::NoSymLinks, QDirIterator::Subdirectories);
+        ScanInventory();
+
         int pathLen = _path.length();
-        while (iterator.hasNext())
+        QStringList files;
+        for (auto entry : inventory.Files(MainData().mid(pathLen), true))
         {
-#ifdef GUI
-            if (timer.elapsed() > 100)
-            {
-                QApplication::processEvents();
-                timer.restart();
-            }
-#endif
-            iterator.next();
-            files.append(iterator.filePath().mid(pathLen));
+            files.append(entry->path);
         }
 
         for (int f = 0; f < files.count(); f++)
@@ -118,72 +111,56 @@ void GameData::ScanGameFiles(bool force, const QString &filterPath)
 
         QString splashPath = bioGamePath() + "/Splash/PC/Splash.bmp";
         QString path = splashPath.mid(pathLen);
-        if (QFile::exists(splashPath))
+        if (inventory.Find(path))
         {
             othersFiles.push_back(path);
         }
 
-        QDirIterator iterator2(_path + "/Game/ME" + QString::number((int)gameType) + "/Engine/Shaders", QDir::Files | QDir::NoSymLinks);
-        while (iterator2.hasNext())
+        QString shadersPath = _path + "/Game/ME" + QString::number((int)gameType) + "/Engine/Shaders";
+        for (auto entry : inventory.Files(shadersPath.mid(pathLen), false))
         {
-            iterator2.next();
-            QString path = iterator2.filePath().mid(pathLen);
-            if (AsciiStringEndsWith(path, EXTENSION_USF, EXTENSION_USF_LEN))
+            if (AsciiStringEndsWith(entry->path, EXTENSION_USF, EXTENSION_USF_LEN))
             {
-                othersFiles.push_back(path);
+                othersFiles.push_back(entry->path);
             }
         }
 
-        QDirIterator iterator3(bioGamePath() + "/Movies", QDir::Files | QDir::NoSymLinks);
-        while (iterator3.hasNext())
+        for (auto entry : inventory.Files((bioGamePath() + "/Movies").mid(pathLen), false))
         {
-            iterator3.next();
-            QString path = iterator3.filePath().mid(pathLen);
-            if (AsciiStringEndsWith(path, EXTENSION_BIK, EXTENSION_BIK_LEN))
+            if (AsciiStringEndsWith(entry->path, EXTENSION_BIK, EXTENSION_BIK_LEN))
             {
-                othersFiles.push_back(path);
+                othersFiles.push_back(entry->path);
             }
         }
 
-        QDirIterator iterator4(bioGamePath() + "/Content/Packages/ISACT", QDir::Files | QDir::NoSymLinks);
-        while (iterator4.hasNext())
+        for (auto entry : inventory.Files((bioGamePath() + "/Content/Packages/ISACT").mid(pathLen), false))
         {
-            iterator4.next();
-            QString path = iterator4.filePath().mid(pathLen);
-            if (AsciiStringEndsWith(path, EXTENSION_ISB, EXTENSION_ISB_LEN))
+            if (AsciiStringEndsWith(entry->path, EXTENSION_ISB, EXTENSION_ISB_LEN))
             {
-                othersFiles.push_back(path);
+                othersFiles.push_back(entry->path);
             }
         }
 
-        if (QDir(DLCData()).exists())
+        QString DLCPath = DLCData().mid(pathLen);
+        QStringList DLCs = inventory.SubDirs(DLCPath);
+        if (DLCs.count() != 0)
         {
-            QStringList DLCs = QDir(DLCData(), "DLC_*", QDir::NoSort, QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks).entryList();
             foreach (QString DLCDir, DLCs)
             {
+                if (!DLCDir.startsWith("DLC_", Qt::CaseInsensitive))
+                    continue;
                 QStringList files;
                 bool isValid = false;
-                QString validDlcPath = DLCData() + "/" + DLCDir + DLCDataSuffix() + "/Mount.dlc";
-                if (QFile::exists(validDlcPath))
+                if (inventory.Find(DLCPath + "/" + DLCDir + DLCDataSuffix() + "/Mount.dlc"))
                     isValid = true;
-                validDlcPath = DLCData() + "/" + DLCDir + "/AutoLoad.ini";
-                if (QFile::exists(validDlcPath))
+                if (inventory.Find(DLCPath + "/" + DLCDir + "/AutoLoad.ini"))
                     isValid = true;
                 if (!isValid)
                     continue;
 
-                QDirIterator iterator(DLCData() + "/" + DLCDir + DLCDataSuffix(), QDir::Files | QDir::NoSymLinks, QDirIterator::Subdirectories);
-                while (iterator.hasNext())
+                for (auto entry : inventory.Files(DLCPath + "/" + DLCDir + DLCDataSuffix(), true))
                 {
-#ifdef GUI
-                    if (timer.elapsed() > 100)
-                    {
-                        QApplication::processEvents();
-                        timer.restart();
-                    }
-#endif
-                    iterator.next();
-                    QString path = iterator.filePath().mid(pathLen);
+                    const QString &path = entry->path;
                     if (filterPath.length() != 0 && !path.contains(filterPath, Qt::CaseInsensitive))
                         continue;
                     if (AsciiBaseNameStringStartsWith(path, GUIDCACHE, GUIDCACHE_LEN))
@@ -191,14 +168,11 @@ void GameData::ScanGameFiles(bool force, const QString &filterPath)
                     files.push_back(path);
                 }
 
-                QDirIterator iterator2(DLCData() + "/" + DLCDir + "/Movies", QDir::Files | QDir::NoSymLinks, QDirIterator::Subdirectories);
-                while (iterator2.hasNext())
+                for (auto entry : inventory.Files(DLCPath + "/" + DLCDir + "/Movies", true))
                 {
-                    iterator2.next();
-                    QString path = iterator2.filePath().mid(pathLen);
-                    if (AsciiStringEndsWith(path, EXTENSION_BIK, EXTENSION_BIK_LEN))
+                    if (AsciiStringEndsWith(entry->path, EXTENSION_BIK, EXTENSION_BIK_LEN))
                     {
-                        othersFiles.push_back(path);
+                        othersFiles.push_back(entry->path);
                     }
                 }
                 DLCFiles += files;
@@ -232,11 +206,9 @@ void GameData::ScanGameFiles(bool force, const QString &filterPath)
             }
         }
 
-        QDirIterator iterator5(_path + "/Game/Launcher", QDir::Files | QDir::NoSymLinks, QDirIterator::Subdirectories);
-        while (iterator5.hasNext())
+        for (auto entry : inventory.Files("/Game/Launcher", true))
         {
-            iterator5.next();
-            QString path = iterator5.filePath().mid(pathLen);
+            const QString &path = entry->path;
             if (AsciiStringEndsWith(path, EXTENSION_EXE, EXTENSION_EXE_LEN))
                 continue;
             if (AsciiStringEndsWith(path, EXTENSION_DLL, EXTENSION_DLL_LEN))
@@ -269,6 +241,20 @@ void GameData::ScanGameFiles(bool force, const QString &filterPath)
     }
 }
 
+void GameData::ScanInventory()
+{
+    if (_path == "")
+    {
+        inventory.Clear();
+        return;
+    }
+
+    QStringList roots;
+    roots.push_back("/Game/ME" + QString::number((int)gameType));
+    roots.push_back("/Game/Launcher");
+    inventory.Scan(_path, roots);
+}
+
 void GameData::Init(MeType type)
 {
     gameType = type;
@@ -292,6 +278,12 @@ void GameData::Init(MeType type, ConfigIni &configIni, bool force = false)
     ScanGameFiles(force, "");
 }
 
+void GameData::InitPath(MeType type, const QString &path)
+{
+    gameType = type;
+    _path = QDir::cleanPath(path);
+}
+
 void GameData::InternalInit(MeType type, ConfigIni &configIni)
 {
     gameType = type;
@@ -520,6 +512,7 @@ void GameData::ClosePackagesList()
     DLCFiles.clear();
     tfcFiles.clear();
     othersFiles.clear();
+    inventory.Clear();
 }
 
 GameData *g_GameData;
@@ -22,6 +22,7 @@
 #ifndef GAME_DATA_H
 #define GAME_DATA_H
 
+#include <GameData/FileInventory.h>
 #include <Program/ConfigIni.h>
 #include <Types/MemTypes.h>
 
@@ -111,12 +112,15 @@ public:
     QStringList DLCFiles;
     QStringList tfcFiles;
     QStringList othersFiles;
+    FileInventory inventory;
     bool DLCDataCacheDone = false;
 
     void Init(MeType type);
     void Init(MeType type, ConfigIni &configIni);
     void Init(MeType type, ConfigIni &configIni, const QString &filterPath);
     void Init(MeType type, ConfigIni &configIni, bool force);
+    void InitPath(MeType type, const QString &path);
+    void ScanInventory();
     QString GamePath() { return _path; }
     const QString MainData();
     const QString bioGamePath();
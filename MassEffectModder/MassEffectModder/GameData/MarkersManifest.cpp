@@ -0,0 +1,162 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <GameData/MarkersManifest.h>
+#include <GameData/GameData.h>
+#include <GameData/TOCFile.h>
+#include <Helpers/CacheFile.h>
+#include <Helpers/FileStream.h>
+#include <Helpers/MemoryStream.h>
+#include <Helpers/MiscHelpers.h>
+#include <Helpers/Logs.h>
+
+MarkersManifest::MarkersManifest(MeType gameId)
+{
+    QString path = QStandardPaths::standardLocations(QStandardPaths::GenericConfigLocation).first() +
+            "/MassEffectModder";
+    if (!QDir(path).exists())
+        QDir(path).mkpath(path);
+    manifestPath = path + QString("/mele%1markers.bin").arg((int)gameId);
+    Load();
+}
+
+void MarkersManifest::Load()
+{
+    if (!QFile(manifestPath).exists())
+        return;
+
+    CacheFileReader fs(manifestPath);
+    if (fs.ReadUInt32() != markersManifestBinTag)
+    {
+        PDEBUG("MarkersManifest: wrong manifest file, ignoring: " + manifestPath + "\n");
+        return;
+    }
+    if (fs.ReadUInt32() != markersManifestBinVersion)
+    {
+        PDEBUG("MarkersManifest: unsupported manifest version, ignoring: " + manifestPath + "\n");
+        return;
+    }
+    int count = fs.ReadInt32();
+    // key terminator, size, mtime, inode and marker flag
+    if (!fs.CheckCount(count, 2 + 8 + 8 + 8 + 1))
+    {
+        PDEBUG("MarkersManifest: broken manifest file, ignoring: " + manifestPath + "\n");
+        return;
+    }
+    entries.reserve(count);
+    for (int i = 0; i < count && !fs.Failed(); i++)
+    {
+        QString key;
+        ManifestEntry entry{};
+        fs.ReadStringUnicode16Null(key);
+        entry.size = fs.ReadInt64();
+        entry.mtime = fs.ReadInt64();
+        entry.inode = fs.ReadUInt64();
+        entry.marker = fs.ReadByte() != 0;
+        entries.insert(key, entry);
+    }
+    if (fs.Failed() || fs.Remaining() != 0)
+    {
+        PDEBUG("MarkersManifest: broken manifest file, ignoring: " + manifestPath + "\n");
+        entries.clear();
+    }
+}
+
+void MarkersManifest::Save()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if (!modified)
+        return;
+
+    MemoryStream mem;
+    mem.WriteUInt32(markersManifestBinTag);
+    mem.WriteUInt32(markersManifestBinVersion);
+    mem.WriteInt32(entries.count());
+    for (auto it = entries.constBegin(); it != entries.constEnd(); it++)
+    {
+        mem.WriteStringUnicode16Null(it.key());
+        mem.WriteInt64(it.value().size);
+        mem.WriteInt64(it.value().mtime);
+        mem.WriteUInt64(it.value().inode);
+        mem.WriteByte(it.value().marker ? 1 : 0);
+    }
+    if (!WriteCacheFile(manifestPath, mem))
+    {
+        PDEBUG("MarkersManifest: failed to write manifest file: " + manifestPath + "\n");
+        return;
+    }
+    modified = false;
+}
+
+void MarkersManifest::UpdateEntry(const QString &relativePath, bool marker)
+{
+    ManifestEntry entry{};
+    if (!GetFileStat(g_GameData->GamePath() + relativePath, entry.size, entry.mtime, entry.inode))
+        return;
+    entry.marker = marker;
+    std::lock_guard<std::mutex> guard(lock);
+    entries.insert(relativePath.toLower(), entry);
+    modified = true;
+}
+
+bool MarkersManifest::HasMarker(const QString &relativePath)
+{
+    QString path = g_GameData->GamePath() + relativePath;
+    qint64 size, mtime;
+    quint64 inode;
+    if (GetFileStat(path, size, mtime, inode))
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = entries.constFind(relativePath.toLower());
+        if (it != entries.constEnd() && it.value().size == size &&
+            it.value().mtime == mtime && it.value().inode == inode)
+        {
+            return it.value().marker;
+        }
+    }
+
+    FileStream fs = FileStream(path, FileMode::Open, FileAccess::ReadOnly);
+    fs.Seek(-MEMMarkerLength, SeekOrigin::End);
+    QString marker;
+    fs.ReadStringASCII(marker, MEMMarkerLength);
+    fs.Close();
+    bool present = marker == QString(MEMendFileMarker);
+    UpdateEntry(relativePath, present);
+
+    return present;
+}
+
+void MarkersManifest::AddMarker(const QString &relativePath)
+{
+    FileStream fs = FileStream(g_GameData->GamePath() + relativePath, FileMode::Open, FileAccess::ReadWrite);
+    fs.Seek(-MEMMarkerLength, SeekOrigin::End);
+    QString marker;
+    fs.ReadStringASCII(marker, MEMMarkerLength);
+    QString str(MEMendFileMarker);
+    if (marker != str)
+    {
+        fs.SeekEnd();
+        fs.WriteStringASCII(str);
+        TOCBinFile::RegisterChangedFile(g_GameData->GamePath() + relativePath);
+    }
+    fs.Close();
+    UpdateEntry(relativePath, true);
+}
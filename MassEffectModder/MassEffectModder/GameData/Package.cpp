@@ -19,11 +19,14 @@
  *
  */
 
+#include <Helpers/Crc32Fast.h>
 #include <Helpers/MiscHelpers.h>
 #include <Helpers/Logs.h>
 #include <Wrappers.h>
 #include <GameData/GameData.h>
 #include <GameData/Package.h>
+#include <GameData/PackageCache.h>
+#include <GameData/TOCFile.h>
 #include <Program/ConfigIni.h>
 #include <Types/MemTypes.h>
 
@@ -31,13 +34,10 @@ Package::~Package()
 {
     for (int i = 0; i < exportsTable.count(); i++)
     {
-        exportsTable[i].raw.Free();
         exportsTable[i].newData.Free();
     }
-    for (int i = 0; i < importsTable.count(); i++)
-    {
-        importsTable[i].raw.Free();
-    }
+    exportsTableData.Free();
+    importsTableData.Free();
     for (int i = 0; i < extraNamesTable.count(); i++)
     {
         extraNamesTable[i].raw.Free();
@@ -104,7 +104,7 @@ int Package::getPropertiesOffset(int exportIndex)
     return propertiesOffset;
 }
 
-int Package::Open(const QString &filename, bool headerOnly, bool fullLoad)
+int Package::Open(const QString &filename, bool headerOnly, bool fullLoad, bool forModify)
 {
     packagePath = g_GameData->RelativeGameData(filename);
 
@@ -125,14 +125,28 @@ int Package::Open(const QString &filename, bool headerOnly, bool fullLoad)
     }
 
     packageStream = new FileStream(filename, FileMode::Open, FileAccess::ReadOnly);
-    if (packageStream->ReadUInt32() != DataTag)
+
+    // Compressed packages tables are served from cache without touching package data
+    PackageCache::Entry cacheEntry{};
+    bool cached = !headerOnly && PackageCache::Get(filename, cacheEntry);
+    std::unique_ptr<MemoryStream> cacheStream;
+    Stream *input = packageStream;
+    if (cached)
     {
+        cacheStream = std::make_unique<MemoryStream>(cacheEntry.header.ptr(), cacheEntry.header.size());
+        input = cacheStream.get();
+    }
+
+    if (input->ReadUInt32() != DataTag)
+    {
+        cacheEntry.header.Free();
+        cacheEntry.tables.Free();
         delete packageStream;
         packageStream = nullptr;
         PERROR(QString("Wrong PCC tag: %1\n").arg(filename));
         return -1;
     }
-    ushort ver = packageStream->ReadUInt16();
+    ushort ver = input->ReadUInt16();
     if (ver == packageFileVersion684)
     {
         packageHeaderSize = packageHeaderSize684;
@@ -145,6 +159,8 @@ int Package::Open(const QString &filename, bool headerOnly, bool fullLoad)
     }
     else
     {
+        cacheEntry.header.Free();
+        cacheEntry.tables.Free();
         delete packageStream;
         packageStream = nullptr;
         PERROR(QString("Wrong PCC version in file: %1\n").arg(filename));
@@ -154,40 +170,40 @@ int Package::Open(const QString &filename, bool headerOnly, bool fullLoad)
     packageHeader = new quint8[packageHeaderSize];
     if (packageHeader == nullptr)
         CRASH_MSG((QString("Out of memory! - amount: ") + QString::number(packageHeaderSize)).toStdString().c_str());
-    packageStream->SeekBegin();
-    packageStream->ReadToBuffer(packageHeader, packageHeaderSize);
+    input->SeekBegin();
+    input->ReadToBuffer(packageHeader, packageHeaderSize);
 
-    compressionType = (CompressionType)packageStream->ReadUInt32();
+    compressionType = (CompressionType)input->ReadUInt32();
 
     if (headerOnly)
         return 0;
 
-    numChunks = packageStream->ReadUInt32();
+    numChunks = input->ReadUInt32();
 
-    chunksTableOffset = packageStream->Position();
+    chunksTableOffset = input->Position();
 
     if (getCompressedFlag())
     {
         for (uint i = 0; i < numChunks; i++)
         {
             Chunk chunk{};
-            chunk.uncomprOffset = packageStream->ReadUInt32();
-            chunk.uncomprSize = packageStream->ReadUInt32();
-            chunk.comprOffset = packageStream->ReadUInt32();
-            chunk.comprSize = packageStream->ReadUInt32();
+            chunk.uncomprOffset = input->ReadUInt32();
+            chunk.uncomprSize = input->ReadUInt32();
+            chunk.comprOffset = input->ReadUInt32();
+            chunk.comprSize = input->ReadUInt32();
             chunks.push_back(chunk);
         }
     }
-    long afterChunksTable = packageStream->Position();
-    someTag = packageStream->ReadUInt32();
+    long afterChunksTable = input->Position();
+    someTag = input->ReadUInt32();
 
-    loadExtraNames(*packageStream);
+    loadExtraNames(*input);
 
-    dataOffset = chunksTableOffset + (packageStream->Position() - afterChunksTable);
+    dataOffset = chunksTableOffset + (input->Position() - afterChunksTable);
 
     if (getCompressedFlag())
     {
-        if (packageStream->Position() != chunks[0].comprOffset)
+        if (input->Position() != chunks[0].comprOffset)
             CRASH();
 
         if ((uint)dataOffset != chunks[0].uncomprOffset)
@@ -196,12 +212,38 @@ int Package::Open(const QString &filename, bool headerOnly, bool fullLoad)
         uint length = getEndOfTablesOffset() - (uint)dataOffset;
         packageData = new MemoryStream();
         packageData->JumpTo(dataOffset);
-        if (!getData((uint)dataOffset, length, packageData))
+        if (cached && cacheEntry.tables.size() != length)
+        {
+            PDEBUG(QString("PackageCache: tables size mismatch, ignoring: %1\n").arg(filename));
+            PackageCache::Remove(filename);
+            cached = false;
+        }
+        if (cached)
+        {
+            packageData->WriteFromBuffer(cacheEntry.tables);
+        }
+        else
         {
-            PERROR(QString("Failed get data! %1\n").arg(filename));
-            return -1;
+            if (!getData((uint)dataOffset, length, packageData))
+            {
+                PERROR(QString("Failed get data! %1\n").arg(filename));
+                return -1;
+            }
+            // Package is going to be rewritten, its entry would be dropped on save anyway
+            if (!forModify)
+            {
+                cacheEntry.header = ByteBuffer(chunks[0].comprOffset);
+                packageStream->JumpTo(0);
+                packageStream->ReadToBuffer(cacheEntry.header.ptr(), cacheEntry.header.size());
+                cacheEntry.tables = ByteBuffer(length);
+                packageData->JumpTo(dataOffset);
+                packageData->ReadToBuffer(cacheEntry.tables.ptr(), length);
+                PackageCache::Put(filename, cacheEntry);
+            }
         }
     }
+    cacheEntry.header.Free();
+    cacheEntry.tables.Free();
 
     if (getCompressedFlag())
         loadNames(*packageData);
@@ -377,28 +419,49 @@ bool Package::getData(uint offset, uint length, Stream *outputStream, quint8 *ou
     return true;
 }
 
-ByteBuffer Package::getExportData(int id)
+UniqueByteBuffer Package::getExportData(int id)
 {
     ExportEntry& exp = exportsTable[id];
     uint length = exp.getDataSize();
-    auto data = ByteBuffer(length);
+    auto data = UniqueByteBuffer(length);
     if (exp.newData.ptr() != nullptr)
+    {
         memcpy(data.ptr(), exp.newData.ptr(), length);
+        ByteBuffer::CountCopy(length);
+    }
     else
     {
         if (!getData(exp.getDataOffset(), exp.getDataSize(), nullptr, data.ptr()))
-        {
-            data.Free();
             return {};
-        }
     }
 
     return data;
 }
 
+bool Package::getExportDataRange(int id, uint offset, uint length, quint8 *outputBuffer)
+{
+    ExportEntry& exp = exportsTable[id];
+    if ((quint64)offset + length > exp.getDataSize())
+        return false;
+    if (length == 0)
+        return true;
+    if (exp.newData.ptr() != nullptr)
+    {
+        memcpy(outputBuffer, exp.newData.ptr() + offset, length);
+        return true;
+    }
+
+    return getData(exp.getDataOffset() + offset, length, nullptr, outputBuffer);
+}
+
 void Package::setExportData(int id, const ByteBuffer &data)
 {
-    ExportEntry exp = exportsTable[id];
+    setExportData(id, UniqueByteBuffer(data.ptr(), data.size()));
+}
+
+void Package::setExportData(int id, UniqueByteBuffer &&data)
+{
+    ExportEntry& exp = exportsTable[id];
     if (data.size() > exp.getDataSize())
     {
         exp.setDataOffset(exportsEndOffset);
@@ -406,30 +469,28 @@ void Package::setExportData(int id, const ByteBuffer &data)
     }
     exp.setDataSize(data.size());
     exp.newData.Free();
-    exp.newData = ByteBuffer(data.ptr(), data.size());
-    exportsTable.replace(id, exp);
+    exp.newData = data.release();
     modified = true;
 }
 
 void Package::MoveExportDataToEnd(int id)
 {
-    ByteBuffer data = getExportData(id);
-    ExportEntry exp = exportsTable[id];
+    UniqueByteBuffer data = getExportData(id);
+    ExportEntry& exp = exportsTable[id];
     exp.setDataOffset(exportsEndOffset);
     exportsEndOffset = exp.getDataOffset() + exp.getDataSize();
 
     exp.newData.Free();
-    exp.newData = data;
-    exportsTable.replace(id, exp);
+    exp.newData = data.release();
     modified = true;
 }
 
-static bool compareExportsDataOffset(Package::ExportEntry &e1, Package::ExportEntry &e2)
+static bool compareExportsDataOffset(const Package::ExportEntry &e1, const Package::ExportEntry &e2)
 {
     return e1.getDataOffset() < e2.getDataOffset();
 }
 
-void Package::SortExportsTableByDataOffset(const QList<ExportEntry> &list, QList<ExportEntry> &sortedExports)
+void Package::SortExportsTableByDataOffset(const QVector<ExportEntry> &list, QVector<ExportEntry> &sortedExports)
 {
     sortedExports = list;
     std::sort(sortedExports.begin(), sortedExports.end(), compareExportsDataOffset);
@@ -437,7 +498,7 @@ void Package::SortExportsTableByDataOffset(const QList<ExportEntry> &list, QList
 
 bool Package::ReserveSpaceBeforeExportData(int space)
 {
-    QList<ExportEntry> sortedExports;
+    QVector<ExportEntry> sortedExports;
     SortExportsTableByDataOffset(exportsTable, sortedExports);
     if (getEndOfTablesOffset() > sortedExports.first().getDataOffset())
         CRASH();
@@ -495,22 +556,15 @@ const QString Package::StorageTypeToString(StorageTypes type)
 
 int Package::getNameId(const QString &name)
 {
-    for (int i = 0; i < namesTable.count(); i++)
-    {
-        if (namesTable[i].name == name)
-            return i;
-    }
-    CRASH();
+    auto it = namesIndex.constFind(name);
+    if (it == namesIndex.constEnd())
+        CRASH();
+    return it.value();
 }
 
 bool Package::existsNameId(const QString &name)
 {
-    for (int i = 0; i < namesTable.count(); i++)
-    {
-        if (namesTable[i].name == name)
-            return true;
-    }
-    return false;
+    return namesIndex.contains(name);
 }
 
 QString Package::getName(int id)
@@ -528,63 +582,114 @@ int Package::addName(const QString &name)
     NameEntry entry{};
     entry.name = name;
     namesTable.push_back(entry);
+    indexName(namesTable.count() - 1);
     setNamesCount(namesTable.count());
     namesTableModified = true;
     modified = true;
     return namesTable.count() - 1;
 }
 
+static const struct
+{
+    const char *name;
+    int Package::*id;
+} wellKnownNames[] =
+{
+    { "Texture2D", &Package::nameIdTexture2D },
+    { "LightMapTexture2D", &Package::nameIdLightMapTexture2D },
+    { "ShadowMapTexture2D", &Package::nameIdShadowMapTexture2D },
+    { "TextureFlipBook", &Package::nameIdTextureFlipBook },
+    { "TextureMovie", &Package::nameIdTextureMovie },
+    { "TextureCube", &Package::nameIdTextureCube },
+    { "None", &Package::nameIdNone },
+    { "IntProperty", &Package::nameIdIntProperty },
+    { "StrProperty", &Package::nameIdStrProperty },
+    { "FloatProperty", &Package::nameIdFloatProperty },
+    { "NameProperty", &Package::nameIdNameProperty },
+    { "ObjectProperty", &Package::nameIdObjectProperty },
+    { "StructProperty", &Package::nameIdStructProperty },
+    { "ByteProperty", &Package::nameIdByteProperty },
+    { "BoolProperty", &Package::nameIdBoolProperty },
+};
+
+void Package::indexName(int id)
+{
+    const QString &name = namesTable[id].name;
+    // Keep first instance of duplicated names, same as linear lookup did
+    if (namesIndex.contains(name))
+    {
+        duplicatedNames = true;
+        return;
+    }
+    namesIndex.insert(name, id);
+
+    for (const auto& wellKnown : wellKnownNames)
+    {
+        if (name == QLatin1String(wellKnown.name))
+        {
+            this->*wellKnown.id = id;
+            break;
+        }
+    }
+}
+
 void Package::loadNames(Stream &input)
 {
-    input.JumpTo(getNamesOffset());
-    for (uint i = 0; i < getNamesCount(); i++)
+    // Names are decoded from single buffer, table end is not known upfront
+    uint namesOffset = getNamesOffset();
+    qint64 namesSize = input.Length() - namesOffset;
+    if (namesOffset < getEndOfTablesOffset())
+        namesSize = qMin(namesSize, (qint64)(getEndOfTablesOffset() - namesOffset));
+    input.JumpTo(namesOffset);
+    ByteBuffer buffer = input.ReadToBuffer(namesSize);
+    const quint8 *ptr = buffer.ptr();
+    qint64 pos = 0;
+
+    uint namesCount = getNamesCount();
+    namesTable.reserve(namesCount);
+    namesIndex.reserve(namesCount);
+    for (uint i = 0; i < namesCount; i++)
     {
         NameEntry entry{};
-        int len = input.ReadInt32();
+        if (pos + 4 > namesSize)
+            CRASH_MSG("Names table out of range!");
+        int len = *reinterpret_cast<const qint32 *>(ptr + pos);
+        pos += 4;
         if (len < 0) // unicode
         {
-            entry.name = "";
+            if (pos + -len * 2LL > namesSize)
+                CRASH_MSG("Names table out of range!");
             if (packageFileVersion == packageFileVersion685)
             {
-                for (int n = 0; n < -len; n++)
-                {
-                    quint16 c = input.ReadUInt16();
-                    entry.name += QChar(static_cast<ushort>(c));
-                }
+                entry.name = QString::fromUtf16(reinterpret_cast<const ushort *>(ptr + pos), -len);
             }
             else
             {
+                entry.name.resize(-len);
                 for (int n = 0; n < -len; n++)
                 {
-                    quint8 c = input.ReadByte();
-                    input.ReadByte();
-                    entry.name += (char)c;
+                    entry.name[n] = QLatin1Char(static_cast<char>(ptr[pos + n * 2]));
                 }
             }
+            pos += -len * 2LL;
         }
         else
         {
-            input.ReadStringASCII(entry.name, len);
+            if (pos + len > namesSize)
+                CRASH_MSG("Names table out of range!");
+            auto str = reinterpret_cast<const char *>(ptr + pos);
+            entry.name = QString::fromUtf8(str, qstrnlen(str, len));
+            pos += len;
         }
         if (entry.name.endsWith(QChar('\0')))
             entry.name.chop(1);
 
-        if (nameIdTexture2D == -1 && entry.name == "Texture2D")
-            nameIdTexture2D = i;
-        else if (nameIdLightMapTexture2D == -1 && entry.name == "LightMapTexture2D")
-            nameIdLightMapTexture2D = i;
-        else if (nameIdShadowMapTexture2D == -1 && entry.name == "ShadowMapTexture2D")
-            nameIdShadowMapTexture2D = i;
-        else if (nameIdTextureFlipBook == -1 && entry.name == "TextureFlipBook")
-            nameIdTextureFlipBook = i;
-        else if (nameIdTextureMovie == -1 && entry.name == "TextureMovie")
-            nameIdTextureMovie = i;
-        else if (nameIdTextureCube == -1 && entry.name == "TextureCube")
-            nameIdTextureCube = i;
-
         namesTable.push_back(entry);
+        indexName(i);
     }
-    namesTableEnd = input.Position();
+    buffer.Free();
+    namesTableEnd = namesOffset + pos;
+    input.JumpTo(namesTableEnd);
 }
 
 void Package::saveNames(Stream &output)
@@ -699,27 +804,22 @@ void Package::saveExtraNames(Stream &output, bool rawMode)
 
 void Package::loadImports(Stream &input)
 {
+    // Import entry: package file, 0, class, 0, link, object name, unknown
+    const uint importEntrySize = 7 * 4;
     input.JumpTo(getImportsOffset());
+    importsTableData = input.ReadToBuffer(getImportsCount() * importEntrySize);
+    importsTable.reserve(getImportsCount());
     for (uint i = 0; i < getImportsCount(); i++)
     {
         ImportEntry entry{};
-
-        long start = input.Position();
-        entry.packageFileId = input.ReadInt32();
+        entry.raw = importsTableData.ptr() + i * importEntrySize;
+        auto values = reinterpret_cast<const qint32 *>(entry.raw);
+        entry.packageFileId = values[0];
         entry.packageFile = namesTable[entry.packageFileId].name;
-        input.SkipInt32(); // const 0
-        entry.classId = input.ReadInt32();
-        input.SkipInt32(); // const 0
-        entry.linkId = input.ReadInt32();
-        entry.objectNameId = input.ReadInt32();
+        entry.classId = values[2];
+        entry.linkId = values[4];
+        entry.objectNameId = values[5];
         entry.objectName = namesTable[entry.objectNameId].name;
-        input.SkipInt32();
-
-        long len = input.Position() - start;
-        input.JumpTo(start);
-        entry.raw = ByteBuffer(len);
-        input.ReadToBuffer(entry.raw.ptr(), len);
-
         importsTable.push_back(entry);
     }
     importsTableEnd = input.Position();
@@ -729,9 +829,8 @@ void Package::loadImportsNames()
 {
     for (uint i = 0; i < getImportsCount(); i++)
     {
-        ImportEntry entry = importsTable[i];
+        ImportEntry& entry = importsTable[i];
         entry.className = getClassName(entry.classId);
-        importsTable[i] = entry;
     }
 }
 
@@ -752,30 +851,34 @@ void Package::saveImports(Stream &output)
     }
     else
     {
-        for (int i = 0; i < importsTable.count(); i++)
-        {
-            output.WriteFromBuffer(importsTable[i].raw.ptr(), importsTable[i].raw.size());
-        }
+        output.WriteFromBuffer(importsTableData);
     }
 }
 
 void Package::loadExports(Stream &input)
 {
+    // Exports have variable size, find size of whole table and read it at once
+    uint exportsCount = getExportsCount();
+    QVector<uint> entriesOffsets(exportsCount);
     input.JumpTo(getExportsOffset());
-    for (uint i = 0; i < getExportsCount(); i++)
+    for (uint i = 0; i < exportsCount; i++)
     {
-        ExportEntry entry{};
-
-        long start = input.Position();
-        input.Skip(entry.DataOffsetOffset + 4);
+        entriesOffsets[i] = input.Position() - getExportsOffset();
+        input.Skip(ExportEntry::DataOffsetOffset + 4);
         input.SkipInt32();
         input.Skip(input.ReadUInt32() * 4 + 16 + 4); // skip entries + skip guid + some
+    }
+    uint tableSize = input.Position() - getExportsOffset();
+    input.JumpTo(getExportsOffset());
+    exportsTableData = input.ReadToBuffer(tableSize);
 
-        long len = input.Position() - start;
-        input.JumpTo(start);
-        entry.raw = ByteBuffer(len);
+    exportsTable.reserve(exportsCount);
+    for (uint i = 0; i < exportsCount; i++)
+    {
+        ExportEntry entry{};
+        entry.raw = exportsTableData.ptr() + entriesOffsets[i];
+        entry.rawSize = (i + 1 < exportsCount ? entriesOffsets[i + 1] : tableSize) - entriesOffsets[i];
         entry.newData = ByteBuffer();
-        input.ReadToBuffer(entry.raw.ptr(), len);
 
         if ((entry.getDataOffset() + entry.getDataSize()) > exportsEndOffset)
             exportsEndOffset = entry.getDataOffset() + entry.getDataSize();
@@ -790,9 +893,8 @@ void Package::loadExportsNames()
 {
     for (uint i = 0; i < getExportsCount(); i++)
     {
-        ExportEntry entry = exportsTable[i];
+        ExportEntry& entry = exportsTable[i];
         entry.className = getClassName(entry.getClassId());
-        exportsTable[i] = entry;
     }
 }
 
@@ -800,7 +902,7 @@ void Package::saveExports(Stream &output)
 {
     for (int i = 0; i < exportsTable.count(); i++)
     {
-        output.WriteFromBuffer(exportsTable[i].raw.ptr(), exportsTable[i].raw.size());
+        output.WriteFromBuffer(exportsTable[i].raw, exportsTable[i].rawSize);
     }
 }
 
@@ -876,6 +978,9 @@ bool Package::SaveToFile(bool forceCompressed, bool forceDecompressed, bool appe
         markerBuffer = packageStream->ReadToBuffer(markerSize);
     }
 
+    TOCBinFile::RegisterChangedFile(g_GameData->GamePath() + packagePath);
+    PackageCache::Remove(g_GameData->GamePath() + packagePath);
+
     if (exportsTable.count() == 0)
     {
         if (appendMarker)
@@ -901,7 +1006,7 @@ bool Package::SaveToFile(bool forceCompressed, bool forceDecompressed, bool appe
     saveExtraNames(tempOutput);
     dataOffset = tempOutput.Position();
 
-    QList<ExportEntry> sortedExports;
+    QVector<ExportEntry> sortedExports;
     SortExportsTableByDataOffset(exportsTable, sortedExports);
 
     setDependsOffset(tempOutput.Position());
@@ -1230,7 +1335,7 @@ void Package::ReleaseChunks()
     chunks.clear();
 }
 
-const ByteBuffer Package::compressData(const ByteBuffer &inputData, StorageTypes type, bool maxCompress)
+ByteBuffer Package::compressData(const ByteBuffer &inputData, StorageTypes type, bool maxCompress)
 {
     MemoryStream ouputStream;
     qint64 compressedSize = 0;
@@ -1302,37 +1407,36 @@ const ByteBuffer Package::compressData(const ByteBuffer &inputData, StorageTypes
     return ouputStream.ToArray();
 }
 
-const ByteBuffer Package::decompressData(Stream &stream, StorageTypes type,
-                                         int uncompressedSize, int compressedSize)
+bool Package::readCompressedBlocks(Stream &stream, int uncompressedSize, int compressedSize,
+                                   QList<ChunkBlock> &blocks, bool allocUncompressed)
 {
     uint blockTag = stream.ReadUInt32();
     if (blockTag != DataTag)
     {
         PERROR(QString("Data tag wrong!\n"));
-        return ByteBuffer();
+        return false;
     }
     uint blockSize = stream.ReadUInt32();
     if (blockSize != MaxBlockSize)
     {
         PERROR(QString("Data block size is wrong!\n"));
-        return ByteBuffer();
+        return false;
     }
     uint compressedChunkSize = stream.ReadUInt32();
     uint uncompressedChunkSize = stream.ReadUInt32();
     if (uncompressedChunkSize != (uint)uncompressedSize)
     {
         PERROR(QString("Data uncompressed size diffrent than expected!\n"));
-        return ByteBuffer();
+        return false;
     }
 
     uint blocksCount = (uncompressedChunkSize + MaxBlockSize - 1) / MaxBlockSize;
     if ((compressedChunkSize + SizeOfChunk + SizeOfChunkBlock * blocksCount) != (uint)compressedSize)
     {
         PERROR(QString("Data compressed size diffrent than expected!\n"));
-        return ByteBuffer();
+        return false;
     }
 
-    QList<Package::ChunkBlock> blocks{};
     for (uint b = 0; b < blocksCount; b++)
     {
         Package::ChunkBlock block{};
@@ -1349,42 +1453,57 @@ const ByteBuffer Package::decompressData(Stream &stream, StorageTypes type,
             CRASH_MSG((QString("Out of memory! - amount: ") +
                        QString::number(blocks[b].comprSize)).toStdString().c_str());
         stream.ReadToBuffer(block.compressedBuffer, blocks[b].comprSize);
-        block.uncompressedBuffer = new quint8[MaxBlockSize * 2];
-        if (block.uncompressedBuffer == nullptr)
-            CRASH_MSG((QString("Out of memory! - amount: ") +
-                       QString::number(MaxBlockSize * 2)).toStdString().c_str());
+        if (allocUncompressed)
+        {
+            block.uncompressedBuffer = new quint8[MaxBlockSize * 2];
+            if (block.uncompressedBuffer == nullptr)
+                CRASH_MSG((QString("Out of memory! - amount: ") +
+                           QString::number(MaxBlockSize * 2)).toStdString().c_str());
+        }
         blocks[b] = block;
     }
 
-    bool errorFlag = false;
+    return true;
+}
+
+bool Package::decompressBlock(StorageTypes type, const ChunkBlock &block, quint8 *output)
+{
     if (type == StorageTypes::extZlib || type == StorageTypes::pccZlib)
     {
-        #pragma omp parallel for
-        for (int b = 0; b < blocks.count(); b++)
-        {
-            uint dstLen = MaxBlockSize * 2;
-            Package::ChunkBlock block = blocks[b];
-            if (ZlibDecompress(block.compressedBuffer, block.comprSize, block.uncompressedBuffer, &dstLen) == -100)
-                CRASH_MSG("Out of memory!");
-            if (dstLen != block.uncomprSize)
-                errorFlag = true;
-        }
+        uint dstLen = MaxBlockSize * 2;
+        if (ZlibDecompress(block.compressedBuffer, block.comprSize, output, &dstLen) == -100)
+            CRASH_MSG("Out of memory!");
+        return dstLen == block.uncomprSize;
     }
-    else if (type == StorageTypes::extOodle || type == StorageTypes::pccOodle)
+    if (type == StorageTypes::extOodle || type == StorageTypes::pccOodle)
     {
-        #pragma omp parallel for
-        for (int b = 0; b < blocks.count(); b++)
-        {
-            Package::ChunkBlock block = blocks[b];
-            if (OodleDecompress(block.compressedBuffer, block.comprSize, block.uncompressedBuffer, block.uncomprSize) != 0)
-                errorFlag = true;
-        }
+        return OodleDecompress(block.compressedBuffer, block.comprSize, output, block.uncomprSize) == 0;
+    }
+    CRASH_MSG("Compression type not expected!");
+}
+
+const ByteBuffer Package::decompressData(Stream &stream, StorageTypes type,
+                                         int uncompressedSize, int compressedSize)
+{
+    QList<Package::ChunkBlock> blocks{};
+    if (!readCompressedBlocks(stream, uncompressedSize, compressedSize, blocks, true))
+        return ByteBuffer();
+
+    bool errorFlag = false;
+    #pragma omp parallel for
+    for (int b = 0; b < blocks.count(); b++)
+    {
+        if (!decompressBlock(type, blocks[b], blocks[b].uncompressedBuffer))
+            errorFlag = true;
     }
-    else
-        CRASH_MSG("Compression type not expected!");
 
     if (errorFlag)
     {
+        for (int b = 0; b < blocks.count(); b++)
+        {
+            delete[] blocks[b].compressedBuffer;
+            delete[] blocks[b].uncompressedBuffer;
+        }
         PERROR(QString("ERROR: Decompressed data size not expected!"));
         return ByteBuffer();
     }
@@ -1402,6 +1521,46 @@ const ByteBuffer Package::decompressData(Stream &stream, StorageTypes type,
     return data;
 }
 
+bool Package::decompressDataCrc(Stream &stream, StorageTypes type,
+                                int uncompressedSize, int compressedSize, uint &crc)
+{
+    QList<Package::ChunkBlock> blocks{};
+    if (!readCompressedBlocks(stream, uncompressedSize, compressedSize, blocks, false))
+        return false;
+
+    // Blocks are hashed right after decoding while still in cache,
+    // whole data is never assembled and partial CRCs are combined instead
+    std::vector<uint> blocksCrc(blocks.count());
+    std::vector<std::unique_ptr<quint8[]>> buffers(omp_get_max_threads());
+    bool errorFlag = false;
+    #pragma omp parallel for
+    for (int b = 0; b < blocks.count(); b++)
+    {
+        std::unique_ptr<quint8[]> &buffer = buffers[omp_get_thread_num()];
+        if (!buffer)
+            buffer.reset(new quint8[MaxBlockSize * 2]);
+        if (decompressBlock(type, blocks[b], buffer.get()))
+            blocksCrc[b] = crc32_hw(buffer.get(), blocks[b].uncomprSize);
+        else
+            errorFlag = true;
+    }
+
+    crc = 0;
+    for (int b = 0; b < blocks.count(); b++)
+    {
+        crc = crc32_combine_parts(crc, blocksCrc[b], blocks[b].uncomprSize);
+        delete[] blocks[b].compressedBuffer;
+    }
+
+    if (errorFlag)
+    {
+        PERROR(QString("ERROR: Decompressed data size not expected!"));
+        return false;
+    }
+
+    return true;
+}
+
 void Package::DisposeCache()
 {
     delete chunkCache;
@@ -141,7 +141,7 @@ public:
         int linkId;
         int objectNameId;
         QString objectName;
-        ByteBuffer raw;
+        quint8 *raw;
     };
 
     struct ExportEntry
@@ -158,42 +158,44 @@ public:
             DataOffsetOffset = 36,
         };
 
-        ByteBuffer raw;
+        // Raw entry points into exports table data owned by package
+        quint8 *raw;
+        uint rawSize;
         ByteBuffer newData;
         quint64 objectFlags;
         uint id;
 
         inline int getClassId()
         {
-            return *reinterpret_cast<int *>(&raw.ptr()[ClassIdOffset]);
+            return *reinterpret_cast<int *>(&raw[ClassIdOffset]);
         }
         QString className;
         int classParentId;
         inline int getLinkId()
         {
-            return *reinterpret_cast<int *>(&raw.ptr()[LinkIdOffset]);
+            return *reinterpret_cast<int *>(&raw[LinkIdOffset]);
         }
         inline int getObjectNameId()
         {
-            return *reinterpret_cast<int *>(&raw.ptr()[ObjectNameIdOffset]);
+            return *reinterpret_cast<int *>(&raw[ObjectNameIdOffset]);
         }
         QString objectName;
         int suffixNameId;
         inline uint getDataSize()
         {
-            return *reinterpret_cast<int *>(&raw.ptr()[DataSizeOffset]);
+            return *reinterpret_cast<int *>(&raw[DataSizeOffset]);
         }
         inline void setDataSize(uint size)
         {
-            *reinterpret_cast<int *>(&raw.ptr()[DataSizeOffset]) = size;
+            *reinterpret_cast<int *>(&raw[DataSizeOffset]) = size;
         }
         inline uint getDataOffset()
         {
-            return *reinterpret_cast<int *>(&raw.ptr()[DataOffsetOffset]);
+            return *reinterpret_cast<int *>(&raw[DataOffsetOffset]);
         }
         inline void setDataOffset(uint offset)
         {
-            *reinterpret_cast<int *>(&raw.ptr()[DataOffsetOffset]) = offset;
+            *reinterpret_cast<int *>(&raw[DataOffsetOffset]) = offset;
         }
     };
 
@@ -209,15 +211,24 @@ public:
         ByteBuffer raw;
     };
 
-    QList<NameEntry> namesTable;
-    QList<ImportEntry> importsTable;
-    QList<ExportEntry> exportsTable;
+    QVector<NameEntry> namesTable;
+    QVector<ImportEntry> importsTable;
+    QVector<ExportEntry> exportsTable;
     int nameIdTexture2D = -1;
     int nameIdLightMapTexture2D = -1;
     int nameIdShadowMapTexture2D = -1;
     int nameIdTextureFlipBook = -1;
     int nameIdTextureMovie = -1;
     int nameIdTextureCube = -1;
+    int nameIdNone = -1;
+    int nameIdIntProperty = -1;
+    int nameIdStrProperty = -1;
+    int nameIdFloatProperty = -1;
+    int nameIdNameProperty = -1;
+    int nameIdObjectProperty = -1;
+    int nameIdStructProperty = -1;
+    int nameIdByteProperty = -1;
+    int nameIdBoolProperty = -1;
 
     inline bool getCompressedFlag()
     {
@@ -247,8 +258,12 @@ private:
     uint chunksTableOffset{};
     uint namesTableEnd{};
     bool namesTableModified = false;
+    QHash<QString, int> namesIndex;
+    bool duplicatedNames = false;
     uint importsTableEnd{};
     bool importsTableModified = false;
+    ByteBuffer importsTableData;
+    ByteBuffer exportsTableData;
     QList<int> dependsTable;
     QList<GuidEntry> guidsTable;
     QList<ExtraNameEntry> extraNamesTable;
@@ -256,6 +271,11 @@ private:
     MemoryStream *chunkCache = nullptr;
     bool modified = false;
 
+    void indexName(int id);
+    static bool readCompressedBlocks(Stream &stream, int uncompressedSize, int compressedSize,
+                                     QList<ChunkBlock> &blocks, bool allocUncompressed);
+    static bool decompressBlock(StorageTypes type, const ChunkBlock &block, quint8 *output);
+
     inline uint getTag()
     {
         return *reinterpret_cast<uint *>(&packageHeader[packageHeaderTagOffset]);
@@ -401,21 +421,24 @@ public:
 
     Package() = default;
     ~Package();
-    int Open(const QString &filename, bool headerOnly = false, bool fullLoad = false);
+    int Open(const QString &filename, bool headerOnly = false, bool fullLoad = false, bool forModify = false);
     bool isName(int id);
     QString getClassName(int id);
     int getClassNameId(int id);
     QString resolvePackagePath(int id);
     bool getData(uint offset, uint length, Stream *outputStream = nullptr, quint8 *outputBuffer = nullptr);
-    ByteBuffer getExportData(int id);
+    UniqueByteBuffer getExportData(int id);
+    bool getExportDataRange(int id, uint offset, uint length, quint8 *outputBuffer);
     void setExportData(int id, const ByteBuffer &data);
+    void setExportData(int id, UniqueByteBuffer &&data);
     void MoveExportDataToEnd(int id);
-    void SortExportsTableByDataOffset(const QList<ExportEntry> &list, QList<ExportEntry> &sortedExports);
+    void SortExportsTableByDataOffset(const QVector<ExportEntry> &list, QVector<ExportEntry> &sortedExports);
     bool ReserveSpaceBeforeExportData(int space);
     static const QString StorageTypeToString(StorageTypes type);
     int getPropertiesOffset(int exportIndex);
     int getNameId(const QString &name);
     bool existsNameId(const QString &name);
+    bool hasDuplicatedNames() { return duplicatedNames; }
     QString getName(int id);
     int addName(const QString &name);
     void loadNames(Stream &input);
@@ -433,10 +456,12 @@ public:
     void loadGuids(Stream &input);
     void saveGuids(Stream &output);
     bool SaveToFile(bool forceCompressed = false, bool forceDecompressed = false, bool appendMarker = true);
-    static const ByteBuffer compressData(const ByteBuffer &inputData, StorageTypes type,
+    static ByteBuffer compressData(const ByteBuffer &inputData, StorageTypes type,
                                          bool maxCompress = true);
     static const ByteBuffer decompressData(Stream &stream, StorageTypes type,
                                            int uncompressedSize, int compressedSize);
+    static bool decompressDataCrc(Stream &stream, StorageTypes type,
+                                  int uncompressedSize, int compressedSize, uint &crc);
     void DisposeCache();
     void ReleaseChunks();
 };
@@ -0,0 +1,186 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include <GameData/PackageCache.h>
+#include <Helpers/CacheFile.h>
+#include <Helpers/MemoryStream.h>
+#include <Helpers/MiscHelpers.h>
+#include <Helpers/Logs.h>
+#include <Types/MemTypes.h>
+
+bool PackageCache::enabled = true;
+qint64 PackageCache::maxSize = 1024LL * 1024 * 1024;
+
+static std::once_flag pruneOnce;
+static const qint64 pruneTouchInterval = 24 * 60 * 60;
+
+QString PackageCache::cacheDir()
+{
+    static QString cacheDir = []()
+    {
+        QString path = QStandardPaths::standardLocations(QStandardPaths::GenericConfigLocation).first() +
+                "/MassEffectModder/PackageCache";
+        if (!QDir(path).exists())
+            QDir(path).mkpath(path);
+        return path;
+    }();
+    return cacheDir;
+}
+
+QString PackageCache::cacheFilePath(const QString &packagePath)
+{
+    QByteArray key = QFileInfo(packagePath).absoluteFilePath().toLower().toUtf8();
+    return cacheDir() + "/" + QCryptographicHash::hash(key, QCryptographicHash::Md5).toHex() + ".bin";
+}
+
+static bool ReadEntryHeader(CacheFileReader &fs, qint64 &size, qint64 &mtime, QString &path)
+{
+    if (fs.ReadUInt32() != packageCacheBinTag || fs.ReadUInt32() != packageCacheBinVersion)
+        return false;
+    size = fs.ReadInt64();
+    mtime = fs.ReadInt64();
+    fs.ReadStringUnicode16Null(path);
+    return !fs.Failed();
+}
+
+bool PackageCache::Get(const QString &packagePath, Entry &entry)
+{
+    if (!enabled)
+        return false;
+
+    qint64 size, mtime;
+    quint64 inode;
+    if (!GetFileStat(packagePath, size, mtime, inode))
+        return false;
+
+    QString cachePath = cacheFilePath(packagePath);
+    if (!QFile::exists(cachePath))
+        return false;
+
+    CacheFileReader fs(cachePath);
+    qint64 entrySize = 0, entryMtime = 0;
+    QString path;
+    if (!ReadEntryHeader(fs, entrySize, entryMtime, path))
+    {
+        PDEBUG("PackageCache: broken cache entry, removing: " + packagePath + "\n");
+        QFile::remove(cachePath);
+        return false;
+    }
+    // Stale entry of changed package, or other package with the same hash
+    if (entrySize != size || entryMtime != mtime ||
+        path.compare(QFileInfo(packagePath).absoluteFilePath(), Qt::CaseInsensitive) != 0)
+    {
+        QFile::remove(cachePath);
+        return false;
+    }
+    uint headerSize = fs.ReadUInt32();
+    uint tablesSize = fs.ReadUInt32();
+    if (fs.Failed() || fs.Remaining() != static_cast<qint64>(headerSize) + tablesSize)
+    {
+        PDEBUG("PackageCache: broken cache entry, removing: " + packagePath + "\n");
+        QFile::remove(cachePath);
+        return false;
+    }
+    entry.header = fs.ReadToBuffer(headerSize);
+    entry.tables = fs.ReadToBuffer(tablesSize);
+
+    // Modification time of entry tracks its last use for pruning, coarse
+    // enough to not turn package opens into metadata writes
+    QDateTime now = QDateTime::currentDateTimeUtc();
+    if (QFileInfo(cachePath).lastModified().toUTC().secsTo(now) > pruneTouchInterval)
+    {
+        QFile file(cachePath);
+        if (!file.open(QIODevice::Append) ||
+            !file.setFileTime(now, QFileDevice::FileModificationTime))
+        {
+            PDEBUG("PackageCache: failed to update cache entry time: " + packagePath + "\n");
+        }
+    }
+
+    return true;
+}
+
+void PackageCache::Put(const QString &packagePath, const Entry &entry)
+{
+    if (!enabled)
+        return;
+
+    std::call_once(pruneOnce, &PackageCache::Prune);
+
+    qint64 size, mtime;
+    quint64 inode;
+    if (!GetFileStat(packagePath, size, mtime, inode))
+        return;
+
+    MemoryStream mem;
+    mem.WriteUInt32(packageCacheBinTag);
+    mem.WriteUInt32(packageCacheBinVersion);
+    mem.WriteInt64(size);
+    mem.WriteInt64(mtime);
+    mem.WriteStringUnicode16Null(QFileInfo(packagePath).absoluteFilePath());
+    mem.WriteUInt32(entry.header.size());
+    mem.WriteUInt32(entry.tables.size());
+    mem.WriteFromBuffer(entry.header);
+    mem.WriteFromBuffer(entry.tables);
+
+    // Packages may be opened by several threads, publish complete file only
+    if (!WriteCacheFile(cacheFilePath(packagePath), mem))
+        PDEBUG("PackageCache: failed to write cache entry: " + packagePath + "\n");
+}
+
+void PackageCache::Remove(const QString &packagePath)
+{
+    QFile::remove(cacheFilePath(packagePath));
+}
+
+void PackageCache::Prune()
+{
+    // Oldest first
+    QFileInfoList files = QDir(cacheDir()).entryInfoList(QStringList("*.bin"), QDir::Files,
+                                                         QDir::Time | QDir::Reversed);
+    QFileInfoList used;
+    qint64 totalSize = 0;
+    for (const auto &info : files)
+    {
+        // Entry header only, enough for the longest package path
+        CacheFileReader fs(info.absoluteFilePath(), 64 * 1024);
+        qint64 entrySize = 0, entryMtime = 0;
+        QString path;
+        qint64 size, mtime;
+        quint64 inode;
+        if (!ReadEntryHeader(fs, entrySize, entryMtime, path) ||
+            !GetFileStat(path, size, mtime, inode) ||
+            size != entrySize || mtime != entryMtime)
+        {
+            QFile::remove(info.absoluteFilePath());
+            continue;
+        }
+        used.push_back(info);
+        totalSize += info.size();
+    }
+
+    for (int i = 0; i < used.count() && totalSize > maxSize; i++)
+    {
+        QFile::remove(used[i].absoluteFilePath());
+        totalSize -= used[i].size();
+    }
+}
@@ -0,0 +1,58 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#ifndef PACKAGE_CACHE_H
+#define PACKAGE_CACHE_H
+
+#include <Helpers/ByteBuffer.h>
+
+class PackageCache
+{
+public:
+
+    struct Entry
+    {
+        // Package file bytes up to first compressed chunk:
+        // header, chunks table and extra names
+        ByteBuffer header;
+        // Decompressed tables region from data offset to end of tables
+        ByteBuffer tables;
+    };
+
+private:
+
+    static QString cacheDir();
+    static QString cacheFilePath(const QString &packagePath);
+    static void Prune();
+
+public:
+
+    static bool enabled;
+    // Least recently used entries above this total size are pruned once per run
+    static qint64 maxSize;
+
+    static bool Get(const QString &packagePath, Entry &entry);
+    static void Put(const QString &packagePath, const Entry &entry);
+    static void Remove(const QString &packagePath);
+};
+
+#endif
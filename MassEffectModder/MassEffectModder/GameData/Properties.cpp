@@ -27,11 +27,28 @@
 #include <GameData/Properties.h>
 #include <Types/MemTypes.h>
 
-Properties::Properties(Package &pkg, const ByteBuffer &data, int propertyOffset)
+static const struct
+{
+    const char *name;
+    Properties::PropertyType type;
+    int Package::*id;
+} propertyTypes[] =
+{
+    { "IntProperty", Properties::IntProperty, &Package::nameIdIntProperty },
+    { "StrProperty", Properties::StrProperty, &Package::nameIdStrProperty },
+    { "FloatProperty", Properties::FloatProperty, &Package::nameIdFloatProperty },
+    { "NameProperty", Properties::NameProperty, &Package::nameIdNameProperty },
+    { "ObjectProperty", Properties::ObjectProperty, &Package::nameIdObjectProperty },
+    { "StructProperty", Properties::StructProperty, &Package::nameIdStructProperty },
+    { "ByteProperty", Properties::ByteProperty, &Package::nameIdByteProperty },
+    { "BoolProperty", Properties::BoolProperty, &Package::nameIdBoolProperty },
+};
+
+Properties::Properties(Package &pkg, const ByteSpan &data, int propertyOffset)
 {
     package = &pkg;
-    headerData = *reinterpret_cast<quint32 *>(data.ptr());
-    getProperty(data.ptr(), propertyOffset);
+    headerData = *reinterpret_cast<const quint32 *>(data.ptr());
+    parseProperties(data.ptr(), propertyOffset);
 }
 
 Properties::~Properties()
@@ -43,105 +60,169 @@ Properties::~Properties()
     }
 }
 
-void Properties::getProperty(quint8 *data, int offset)
+Properties::PropertyType Properties::getPropertyType(int typeId)
 {
-    PropertyEntry property{};
-    int size, valueRawPos, nextOffset;
-
-    property.name = package->getName(*reinterpret_cast<quint32 *>(data + offset));
-    if (property.name == "None")
+    for (const auto& propertyType : propertyTypes)
     {
-        nextOffset = offset;
-        propertyEndOffset = valueRawPos = offset + 8;
-        size = 0;
+        if (typeId == package->*propertyType.id)
+            return propertyType.type;
     }
-    else
+    // Duplicated name entries are not indexed, compare by string as fallback
+    if (!package->hasDuplicatedNames())
+        return UnknownProperty;
+    QString typeName = package->getName(typeId);
+    for (const auto& propertyType : propertyTypes)
     {
-        property.type = package->getName(*reinterpret_cast<qint32 *>(data + offset + 8));
-        size = *reinterpret_cast<qint32 *>(data + offset + 16);
-        property.index = *reinterpret_cast<qint32 *>(data + offset + 20);
-
-        valueRawPos = offset + 24;
+        if (typeName == QLatin1String(propertyType.name))
+            return propertyType.type;
+    }
+    return UnknownProperty;
+}
 
-        if (property.type == "IntProperty" ||
-            property.type == "StrProperty" ||
-            property.type == "FloatProperty" ||
-            property.type == "NameProperty" ||
-            property.type == "ObjectProperty")
-        {
-        }
-        else if (property.type == "StructProperty" ||
-                 property.type == "ByteProperty")
-        {
-            size += 8;
-        }
-        else if (property.type == "BoolProperty")
-        {
-            size = 1;
-        }
-        else
-            CRASH("");
+bool Properties::isNoneName(int nameId)
+{
+    if (nameId == package->nameIdNone)
+        return true;
+    if (!package->hasDuplicatedNames())
+        return false;
+    return package->getName(nameId) == QLatin1String("None");
+}
 
-        nextOffset = valueRawPos + size;
+int Properties::getTypeNameId(PropertyType type)
+{
+    for (const auto& propertyType : propertyTypes)
+    {
+        if (propertyType.type == type)
+            return getOrAddNameId(propertyType.name);
     }
-    property.valueRaw = ByteBuffer(size);
-    property.valueStruct = ByteBuffer();
-    property.fetched = false;
-    memcpy(property.valueRaw.ptr(), data + valueRawPos, size);
-    propertyList.push_back(property);
-
-    if (nextOffset != offset)
-        getProperty(data, nextOffset);
+    CRASH();
 }
 
-Properties::PropertyEntry Properties::getProperty(const QString &name)
+int Properties::getOrAddNameId(const QString &name)
+{
+    if (!package->existsNameId(name))
+        package->addName(name);
+    return package->getNameId(name);
+}
+
+int Properties::findProperty(int nameId)
 {
-    fetchValue(name);
     for (int i = 0; i < propertyList.count(); i++)
     {
-        if (propertyList[i].name == name)
-        {
-            return propertyList[i];
-        }
+        if (propertyList[i].nameId == nameId)
+            return i;
     }
-    CRASH("");
+    return -1;
 }
 
-void Properties::fetchValue(const QString &name)
+int Properties::findProperty(const QString &name)
 {
+    if (!package->existsNameId(name))
+        return -1;
+    int index = findProperty(package->getNameId(name));
+    if (index != -1 || !package->hasDuplicatedNames())
+        return index;
+    // Property may refer to duplicated name entry, compare by string as fallback
     for (int i = 0; i < propertyList.count(); i++)
     {
-        if (propertyList[i].name == name)
+        if (package->getName(propertyList[i].nameId) == name)
+            return i;
+    }
+    return -1;
+}
+
+void Properties::parseProperties(const quint8 *data, int offset)
+{
+    for (;;)
+    {
+        PropertyEntry property{};
+        int size, valueRawPos;
+
+        property.nameId = *reinterpret_cast<const qint32 *>(data + offset);
+        if (isNoneName(property.nameId))
         {
-            fetchValue(i);
-            return;
+            property.typeId = -1;
+            property.propertyType = NoneProperty;
+            propertyEndOffset = valueRawPos = offset + 8;
+            size = 0;
         }
+        else
+        {
+            property.typeId = *reinterpret_cast<const qint32 *>(data + offset + 8);
+            property.propertyType = getPropertyType(property.typeId);
+            size = *reinterpret_cast<const qint32 *>(data + offset + 16);
+            property.index = *reinterpret_cast<const qint32 *>(data + offset + 20);
+
+            valueRawPos = offset + 24;
+
+            switch (property.propertyType)
+            {
+            case IntProperty:
+            case StrProperty:
+            case FloatProperty:
+            case NameProperty:
+            case ObjectProperty:
+                break;
+            case StructProperty:
+            case ByteProperty:
+                size += 8;
+                break;
+            case BoolProperty:
+                size = 1;
+                break;
+            default:
+                CRASH("");
+            }
+        }
+        property.valueRaw = ByteBuffer(data + valueRawPos, size);
+        property.valueStruct = ByteBuffer();
+        property.fetched = false;
+        propertyList.push_back(property);
+
+        if (property.propertyType == NoneProperty)
+            break;
+        offset = valueRawPos + size;
     }
 }
 
+Properties::PropertyEntry Properties::getProperty(const QString &name)
+{
+    int index = findProperty(name);
+    if (index == -1)
+        CRASH("");
+    fetchValue(index);
+    return propertyList[index];
+}
+
+void Properties::fetchValue(const QString &name)
+{
+    int index = findProperty(name);
+    if (index != -1)
+        fetchValue(index);
+}
+
 void Properties::fetchValue(int index)
 {
     if (index < 0 || index >= propertyList.count())
         CRASH("");
-    PropertyEntry property = propertyList[index];
-    if (property.fetched || property.name == "None")
+    PropertyEntry &property = propertyList[index];
+    if (property.fetched || property.propertyType == NoneProperty)
         return;
-    if (property.type == "IntProperty" ||
-        property.type == "ObjectProperty")
+    switch (property.propertyType)
     {
+    case IntProperty:
+    case ObjectProperty:
         property.valueInt = *reinterpret_cast<qint32 *>(property.valueRaw.ptr() + 0);
-    }
-    else if (property.type == "ByteProperty")
-    {
+        break;
+    case ByteProperty:
         property.valueNameType = package->getName(*reinterpret_cast<qint32 *>(property.valueRaw.ptr() + 0));
         property.valueName = package->getName(*reinterpret_cast<qint32 *>(property.valueRaw.ptr() + 8));
         property.valueInt = *reinterpret_cast<qint32 *>(property.valueRaw.ptr() + 12);
-    }
-    else if (property.type == "BoolProperty")
-    {
+        break;
+    case BoolProperty:
         property.valueBool = property.valueRaw.ptr()[0] != 0;
-    }
-    else if (property.type == "StrProperty")
+        break;
+    case StrProperty:
     {
         qint32 len = *reinterpret_cast<qint32 *>(property.valueRaw.ptr() + 0);
         if (len < 0) // unicode
@@ -161,29 +242,24 @@ void Properties::fetchValue(int index)
                 property.valueName += (char)c;
             }
         }
-        if (property.name.endsWith(QChar('\0')))
-            property.name.chop(1);
+        break;
     }
-    else if (property.type == "FloatProperty")
-    {
+    case FloatProperty:
         property.valueFloat = *reinterpret_cast<float *>(property.valueRaw.ptr() + 0);
-    }
-    else if (property.type == "NameProperty")
-    {
+        break;
+    case NameProperty:
         property.valueName = package->getName(*reinterpret_cast<qint32 *>(property.valueRaw.ptr() + 0));
-    }
-    else if (property.type == "StructProperty")
-    {
+        break;
+    case StructProperty:
         property.valueName = package->getName(*reinterpret_cast<qint32 *>(property.valueRaw.ptr() + 0));
         property.valueInt = *reinterpret_cast<qint32 *>(property.valueRaw.ptr() + 4);
-        property.valueStruct = ByteBuffer(property.valueRaw.size() - 8);
-        memcpy(property.valueStruct.ptr(), property.valueRaw.ptr() + 8, property.valueStruct.size());
-    }
-    else
+        property.valueStruct = ByteBuffer(property.valueRaw.ptr() + 8, property.valueRaw.size() - 8);
+        break;
+    default:
         CRASH("");
+    }
 
     property.fetched = true;
-    propertyList[index] = property;
 }
 
 QString Properties::getDisplayString(int index)
@@ -193,345 +269,130 @@ QString Properties::getDisplayString(int index)
         CRASH();
 
     fetchValue(index);
-    PropertyEntry property = propertyList[index];
-    if (property.name == "None")
+    const PropertyEntry &property = propertyList[index];
+    if (property.propertyType == NoneProperty)
         return result;
 
-    result = "  " + property.name + ": ";
-    if (property.type == "IntProperty")
+    result = "  " + package->getName(property.nameId) + ": ";
+    switch (property.propertyType)
     {
+    case IntProperty:
         result += QString::number(property.valueInt) + "\n";
-    }
-    else if (property.type == "ObjectProperty")
-    {
+        break;
+    case ObjectProperty:
         result += package->getName(package->getClassNameId(property.valueInt)) + "\n";
-    }
-    else if (property.type == "ByteProperty")
-    {
+        break;
+    case ByteProperty:
         result += property.valueNameType + ": ";
         result += property.valueName + ": ";
         result += QString::number(property.valueInt) + "\n";
-    }
-    else if (property.type == "BoolProperty")
-    {
+        break;
+    case BoolProperty:
         result += QString(property.valueBool ? "true" : "false") + "\n";
-    }
-    else if (property.type == "FloatProperty")
-    {
+        break;
+    case FloatProperty:
         result += QString::number(property.valueFloat) + "\n";
-    }
-    else if (property.type == "NameProperty" || property.type == "StrProperty")
-    {
-        result += property.valueName + "\n";
-    }
-    else if (property.type == "StructProperty")
-    {
+        break;
+    case NameProperty:
+    case StrProperty:
+    case StructProperty:
         result += property.valueName + "\n";
-    }
-    else
+        break;
+    default:
         CRASH();
+    }
 
     return result;
 }
 
 bool Properties::exists(const QString &name)
 {
-    for (int i = 0; i < propertyList.count(); i++)
-    {
-        if (propertyList[i].name == name)
-            return true;
-    }
-    return false;
+    return findProperty(name) != -1;
 }
 
 void Properties::removeProperty(const QString &name)
 {
-    for (int i = 0; i < propertyList.count(); i++)
-    {
-        if (propertyList[i].name == name)
-        {
-            propertyList.removeAt(i);
-            return;
-        }
-    }
+    int index = findProperty(name);
+    if (index != -1)
+        propertyList.removeAt(index);
 }
 
-void Properties::setIntValue(const QString &name, qint32 value)
+Properties::PropertyEntry &Properties::prepareProperty(const QString &name, PropertyType type, int rawSize)
 {
-    PropertyEntry property{};
-    if (exists(name))
+    int index = findProperty(name);
+    if (index != -1)
     {
-        for (int i = 0; i < propertyList.count(); i++)
-        {
-            if (propertyList[i].name == name)
-            {
-                property = propertyList[i];
-                break;
-            }
-        }
-        if (property.type != "IntProperty")
+        if (propertyList[index].propertyType != type)
             CRASH();
-    }
-    else
-    {
-        property.valueRaw = ByteBuffer(sizeof(qint32));
-        property.type = "IntProperty";
-        if (!package->existsNameId(property.type))
-            package->addName(property.type);
+        propertyList[index].fetched = true;
+        return propertyList[index];
     }
 
-    if (!package->existsNameId(name))
-        package->addName(name);
-    property.name = name;
+    PropertyEntry property{};
+    if (rawSize != -1)
+        property.valueRaw = ByteBuffer(rawSize);
+    property.propertyType = type;
+    property.typeId = getTypeNameId(type);
+    property.nameId = getOrAddNameId(name);
     property.fetched = true;
+    propertyList.push_front(property);
+    return propertyList.front();
+}
 
+void Properties::setIntValue(const QString &name, qint32 value)
+{
+    PropertyEntry &property = prepareProperty(name, IntProperty, sizeof(qint32));
     memcpy(property.valueRaw.ptr(), &value, sizeof(qint32));
     property.valueInt = value;
-    if (exists(name))
-    {
-        for (int i = 0; i < propertyList.count(); i++)
-        {
-            if (propertyList[i].name == name)
-            {
-                propertyList[i] = property;
-                break;
-            }
-        }
-    }
-    else
-        propertyList.push_front(property);
 }
 
 void Properties::setFloatValue(const QString &name, float value)
 {
-    PropertyEntry property{};
-    if (exists(name))
-    {
-        for (int i = 0; i < propertyList.count(); i++)
-        {
-            if (propertyList[i].name == name)
-            {
-                property = propertyList[i];
-                break;
-            }
-        }
-        if (property.type != "FloatProperty")
-            CRASH();
-    }
-    else
-    {
-        property.valueRaw = ByteBuffer(sizeof(float));
-        property.type = "FloatProperty";
-        if (!package->existsNameId(property.type))
-            package->addName(property.type);
-    }
-
-    if (!package->existsNameId(name))
-        package->addName(name);
-    property.name = name;
-    property.fetched = true;
-
+    PropertyEntry &property = prepareProperty(name, FloatProperty, sizeof(float));
     memcpy(property.valueRaw.ptr(), &value, sizeof(float));
     property.valueFloat = value;
-    if (exists(name))
-    {
-        for (int i = 0; i < propertyList.count(); i++)
-        {
-            if (propertyList[i].name == name)
-            {
-                propertyList[i] = property;
-                break;
-            }
-        }
-    }
-    else
-        propertyList.push_front(property);
 }
 
 void Properties::setByteValue(const QString &name, const QString &valueName,
                                const QString &valueNameType, qint32 valueInt)
 {
-    PropertyEntry property{};
-    if (exists(name))
-    {
-        for (int i = 0; i < propertyList.count(); i++)
-        {
-            if (propertyList[i].name == name)
-            {
-                property = propertyList[i];
-                break;
-            }
-        }
-        if (property.type != "ByteProperty")
-            CRASH();
-    }
-    else
-    {
-        property.valueRaw = ByteBuffer(16);
+    bool added = !exists(name);
+    PropertyEntry &property = prepareProperty(name, ByteProperty, 16);
+    if (added)
         memset(property.valueRaw.ptr() + 4, 0, sizeof(qint32));
-        property.type = "ByteProperty";
-        if (!package->existsNameId(property.type))
-            package->addName(property.type);
-    }
-
-    if (!package->existsNameId(name))
-        package->addName(name);
-    property.name = name;
-    property.fetched = true;
 
-    if (!package->existsNameId(valueName))
-        package->addName(valueName);
-    if (!package->existsNameId(valueNameType))
-        package->addName(valueNameType);
-    qint32 nameTypeId = package->getNameId(valueNameType);
-    qint32 nameId = package->getNameId(valueName);
+    qint32 nameId = getOrAddNameId(valueName);
+    qint32 nameTypeId = getOrAddNameId(valueNameType);
     memcpy(property.valueRaw.ptr(), &nameTypeId, sizeof(qint32));
     memcpy(property.valueRaw.ptr() + 8, &nameId, sizeof(qint32));
     memcpy(property.valueRaw.ptr() + 12, &valueInt, sizeof(qint32));
     property.valueName = valueName;
     property.valueInt = valueInt;
-    if (exists(name))
-    {
-        for (int i = 0; i < propertyList.count(); i++)
-        {
-            if (propertyList[i].name == name)
-            {
-                propertyList[i] = property;
-                break;
-            }
-        }
-    }
-    else
-        propertyList.push_front(property);
 }
 
 void Properties::setBoolValue(const QString &name, bool value)
 {
-    PropertyEntry property{};
-    if (exists(name))
-    {
-        for (int i = 0; i < propertyList.count(); i++)
-        {
-            if (propertyList[i].name == name)
-            {
-                property = propertyList[i];
-                break;
-            }
-        }
-        if (property.type != "BoolProperty")
-            CRASH();
-    }
-    else
-    {
-        property.valueRaw = ByteBuffer(1);
-        property.type = "BoolProperty";
-        if (!package->existsNameId(property.type))
-            package->addName(property.type);
-    }
-
-    if (!package->existsNameId(name))
-        package->addName(name);
-    property.name = name;
-    property.fetched = true;
-
+    PropertyEntry &property = prepareProperty(name, BoolProperty, 1);
     if (value)
         property.valueRaw.ptr()[0] = 1;
     else
         property.valueRaw.ptr()[0] = 0;
     property.valueBool = value;
-
-    if (exists(name))
-    {
-        for (int i = 0; i < propertyList.count(); i++)
-        {
-            if (propertyList[i].name == name)
-            {
-                propertyList[i] = property;
-                break;
-            }
-        }
-    }
-    else
-        propertyList.push_front(property);
 }
 
 void Properties::setNameValue(const QString &name, const QString &valueName)
 {
-    PropertyEntry property{};
-    if (exists(name))
-    {
-        for (int i = 0; i < propertyList.count(); i++)
-        {
-            if (propertyList[i].name == name)
-            {
-                property = propertyList[i];
-                break;
-            }
-        }
-        if (property.type != "NameProperty")
-            CRASH();
-    }
-    else
-    {
-        property.valueRaw = ByteBuffer(8);
-        property.type = "NameProperty";
-        if (!package->existsNameId(property.type))
-            package->addName(property.type);
-    }
-
-    if (!package->existsNameId(name))
-        package->addName(name);
-    property.name = name;
-    property.fetched = true;
+    PropertyEntry &property = prepareProperty(name, NameProperty, 8);
 
-    if (!package->existsNameId(valueName))
-        package->addName(valueName);
-
-    qint32 nameId = package->getNameId(valueName);
+    qint32 nameId = getOrAddNameId(valueName);
     memcpy(property.valueRaw.ptr(), &nameId, sizeof(qint32));
     memset(property.valueRaw.ptr() + 4, 0, sizeof(qint32));
     property.valueName = valueName;
-
-    if (exists(name))
-    {
-        for (int i = 0; i < propertyList.count(); i++)
-        {
-            if (propertyList[i].name == name)
-            {
-                propertyList[i] = property;
-                break;
-            }
-        }
-    }
-    else
-        propertyList.push_front(property);
 }
 
 void Properties::setStrValue(const QString &name, const QString &valueName)
 {
-    PropertyEntry property{};
-    if (exists(name))
-    {
-        for (int i = 0; i < propertyList.count(); i++)
-        {
-            if (propertyList[i].name == name)
-            {
-                property = propertyList[i];
-                break;
-            }
-        }
-        if (property.type != "StrProperty")
-            CRASH();
-    }
-    else
-    {
-        property.type = "StrProperty";
-    }
-
-    if (!package->existsNameId(name))
-        package->addName(name);
-    property.name = name;
-    property.fetched = true;
+    PropertyEntry &property = prepareProperty(name, StrProperty, -1);
 
     qint32 len = valueName.length();
     if (len != 0)
@@ -555,79 +416,28 @@ void Properties::setStrValue(const QString &name, const QString &valueName)
     }
     memcpy(property.valueRaw.ptr(), &len, sizeof(qint32));
     property.valueName = valueName;
-
-    if (exists(name))
-    {
-        for (int i = 0; i < propertyList.count(); i++)
-        {
-            if (propertyList[i].name == name)
-            {
-                propertyList[i] = property;
-                break;
-            }
-        }
-    }
-    else
-        propertyList.push_front(property);
 }
 
 void Properties::setStructValue(const QString &name, const QString &valueName, ByteBuffer valueStruct)
 {
-    PropertyEntry property{};
-    if (exists(name))
+    int index = findProperty(name);
+    if (index != -1)
     {
-        int index = -1;
-        for (int i = 0; i < propertyList.count(); i++)
-        {
-            if (propertyList[i].name == name)
-            {
-                index = i;
-                break;
-            }
-        }
         fetchValue(index);
-        property = propertyList[index];
-        if (property.type != "StructProperty" || property.valueStruct.size() != valueStruct.size())
+        if (propertyList[index].valueStruct.size() != valueStruct.size())
             CRASH();
     }
-    else
-    {
-        property.valueRaw = ByteBuffer(valueStruct.size() + 8);
+    PropertyEntry &property = prepareProperty(name, StructProperty, valueStruct.size() + 8);
+    if (index == -1)
         property.valueStruct = ByteBuffer(valueStruct.size());
-        property.type = "StructProperty";
-        if (!package->existsNameId(property.type))
-            package->addName(property.type);
-    }
-
-    if (!package->existsNameId(name))
-        package->addName(name);
-    property.name = name;
-    property.fetched = true;
     property.valueName = valueName;
     property.valueInt = 0;
 
-    if (!package->existsNameId(valueName))
-        package->addName(valueName);
-
-    qint32 nameId = package->getNameId(valueName);
+    qint32 nameId = getOrAddNameId(valueName);
     memcpy(property.valueRaw.ptr(), &nameId, sizeof(qint32));
     memcpy(property.valueRaw.ptr() + 4, &property.valueInt, sizeof(qint32));
     memcpy(property.valueRaw.ptr() + 8, valueStruct.ptr(), valueStruct.size());
     memcpy(property.valueStruct.ptr(), valueStruct.ptr(), valueStruct.size());
-
-    if (exists(name))
-    {
-        for (int i = 0; i < propertyList.count(); i++)
-        {
-            if (propertyList[i].name == name)
-            {
-                propertyList[i] = property;
-                break;
-            }
-        }
-    }
-    else
-        propertyList.push_front(property);
 }
 
 ByteBuffer Properties::toArray()
@@ -636,25 +446,26 @@ ByteBuffer Properties::toArray()
     mem.WriteUInt32(headerData);
     for (int i = 0; i < propertyList.count(); i++)
     {
-        mem.WriteInt32(package->getNameId(propertyList[i].name));
+        const PropertyEntry &property = propertyList[i];
+        mem.WriteInt32(property.nameId);
         mem.WriteInt32(0); // skip
-        if (propertyList[i].name == "None")
+        if (property.propertyType == NoneProperty)
             break;
-        mem.WriteInt32(package->getNameId(propertyList[i].type));
+        mem.WriteInt32(property.typeId);
         mem.WriteInt32(0); // skip
-        int size = propertyList[i].valueRaw.size();
-        if (propertyList[i].type == "StructProperty" ||
-            propertyList[i].type == "ByteProperty")
+        int size = property.valueRaw.size();
+        if (property.propertyType == StructProperty ||
+            property.propertyType == ByteProperty)
         {
             size -= 8;
         }
-        else if (propertyList[i].type == "BoolProperty")
+        else if (property.propertyType == BoolProperty)
         {
             size = 0;
         }
         mem.WriteInt32(size);
-        mem.WriteInt32(propertyList[i].index);
-        mem.WriteFromBuffer(propertyList[i].valueRaw.ptr(), propertyList[i].valueRaw.size());
+        mem.WriteInt32(property.index);
+        mem.WriteFromBuffer(property.valueRaw.ptr(), property.valueRaw.size());
     }
 
     return mem.ToArray();
@@ -30,13 +30,28 @@ class Properties
 {
 public:
 
+    enum PropertyType
+    {
+        UnknownProperty = 0,
+        NoneProperty,
+        IntProperty,
+        StrProperty,
+        FloatProperty,
+        NameProperty,
+        ObjectProperty,
+        StructProperty,
+        ByteProperty,
+        BoolProperty,
+    };
+
     class PropertyEntry
     {
         friend Properties;
 
     private:
-        QString type;
-        QString name;
+        int nameId;
+        int typeId;
+        PropertyType propertyType;
         QString valueNameType;
         QString valueName;
         qint32 valueInt;
@@ -73,11 +88,18 @@ public:
 private:
     uint headerData = 0;
     Package *package;
-    void getProperty(quint8 *data, int offset);
+    void parseProperties(const quint8 *data, int offset);
+    PropertyType getPropertyType(int typeId);
+    bool isNoneName(int nameId);
+    int getTypeNameId(PropertyType type);
+    int getOrAddNameId(const QString &name);
+    int findProperty(const QString &name);
+    int findProperty(int nameId);
+    PropertyEntry &prepareProperty(const QString &name, PropertyType type, int rawSize);
 
 public:
 
-    Properties(Package &pkg, const ByteBuffer &data, int propertyOffset);
+    Properties(Package &pkg, const ByteSpan &data, int propertyOffset);
     ~Properties();
     PropertyEntry getProperty(const QString &name);
     void fetchValue(const QString &name);
@@ -26,6 +26,7 @@
 
 #include <Helpers/FileStream.h>
 #include <Helpers/MiscHelpers.h>
+#include <Helpers/Logs.h>
 #include <GameData/TOCFile.h>
 #include <GameData/GameData.h>
 
@@ -79,157 +80,295 @@ static quint32 hashFilename(const void *data, quint32 length)
     return hash;
 }
 
+static bool hasTocExtension(const QString &path, const char *const *extensions)
+{
+    for (int i = 0; extensions[i] != nullptr; i++)
+    {
+        if (path.endsWith(extensions[i], Qt::CaseInsensitive))
+            return true;
+    }
+    return false;
+}
+
+static const char *const mainTocExtensions[] =
+{
+    ".pcc", ".upk", ".tfc", ".tlk", ".afc", ".cnd", ".ini", ".txt", ".bin", nullptr
+};
+
+static const char *const me1DlcTocExtensions[] =
+{
+    ".pcc", ".upk", ".tfc", ".tlk", ".afc", ".cnd", ".bik", ".ini", ".dlc", ".bin", nullptr
+};
+
+static const char *const dlcTocExtensions[] =
+{
+    ".pcc", ".upk", ".tfc", ".tlk", ".afc", ".cnd", ".bik", ".ini", ".txt", ".dlc", ".bin", nullptr
+};
+
+static std::mutex journalLock;
+static QSet<QString> changedFiles;
+static bool fileSetChanged = false;
+
+void TOCBinFile::RegisterChangedFile(const QString &path)
+{
+    std::lock_guard<std::mutex> guard(journalLock);
+    changedFiles.insert(path);
+}
+
+void TOCBinFile::RegisterNewFile(const QString &path)
+{
+    std::lock_guard<std::mutex> guard(journalLock);
+    changedFiles.insert(path);
+    fileSetChanged = true;
+}
+
 void TOCBinFile::UpdateAllTOCBinFiles(MeType gameType)
 {
+    {
+        std::lock_guard<std::mutex> guard(journalLock);
+        changedFiles.clear();
+        fileSetChanged = false;
+    }
+
+    g_GameData->ScanInventory();
     GenerateMainTocBinFile(gameType);
     if (gameType != MeType::ME1_TYPE)
         GenerateDLCsTocBinFiles();
 }
 
-void TOCBinFile::GenerateMainTocBinFile(MeType gameType)
+void TOCBinFile::UpdateChangedTOCBinFiles(MeType gameType)
 {
-    QStringList files;
-    QString gamePath = g_GameData->GamePath() + "/Game/ME" + QString::number((int)gameType);
-    int pathLen = gamePath.length();
-    QDirIterator MainIterator(g_GameData->MainData(), QDir::Files | QDir::NoSymLinks, QDirIterator::Subdirectories);
-    while (MainIterator.hasNext())
+    QSet<QString> files;
+    bool rebuild;
+    {
+        std::lock_guard<std::mutex> guard(journalLock);
+        files.swap(changedFiles);
+        rebuild = fileSetChanged;
+        fileSetChanged = false;
+    }
+
+    if (!rebuild)
     {
-#ifdef GUI
-        QApplication::processEvents();
-#endif
-        MainIterator.next();
-        if (MainIterator.filePath().endsWith(".pcc", Qt::CaseInsensitive) ||
-            MainIterator.filePath().endsWith(".upk", Qt::CaseInsensitive) ||
-            MainIterator.filePath().endsWith(".tfc", Qt::CaseInsensitive) ||
-            MainIterator.filePath().endsWith(".tlk", Qt::CaseInsensitive) ||
-            MainIterator.filePath().endsWith(".afc", Qt::CaseInsensitive) ||
-            MainIterator.filePath().endsWith(".cnd", Qt::CaseInsensitive) ||
-            MainIterator.filePath().endsWith(".ini", Qt::CaseInsensitive) ||
-            MainIterator.filePath().endsWith(".txt", Qt::CaseInsensitive) ||
-            MainIterator.filePath().endsWith(".bin", Qt::CaseInsensitive))
+        QMap<QString, QVector<FileEntry>> tocFiles;
+        foreach (QString path, files)
+        {
+            QString tocPath, entryPath;
+            if (!LocateTocEntry(gameType, path, tocPath, entryPath))
+                continue;
+            QFileInfo info(path);
+            if (!info.exists())
+            {
+                rebuild = true;
+                break;
+            }
+            AddTocFile(tocFiles[tocPath], entryPath, info.size());
+        }
+
+        for (auto it = tocFiles.cbegin(); !rebuild && it != tocFiles.cend(); ++it)
         {
-            files.push_back(MainIterator.filePath().mid(pathLen + 1));
+            if (!PatchTocBinFile(it.key(), it.value()))
+                rebuild = true;
         }
     }
 
-    QDirIterator MoviesIterator(g_GameData->bioGamePath() + "/Movies", QDir::Files | QDir::NoSymLinks, QDirIterator::Subdirectories);
-    while (MoviesIterator.hasNext())
+    if (rebuild)
     {
-        MoviesIterator.next();
-        if (MoviesIterator.filePath().endsWith(".bik", Qt::CaseInsensitive))
-            files.push_back(MoviesIterator.filePath().mid(pathLen + 1));
+        PINFO("TOC files need full rebuild.\n");
+        UpdateAllTOCBinFiles(gameType);
     }
+}
 
-    if (QDir(g_GameData->bioGamePath() + "/Content").exists())
+bool TOCBinFile::LocateTocEntry(MeType gameType, const QString &path, QString &tocPath, QString &entryPath)
+{
+    QString DLCPath = g_GameData->DLCData() + "/";
+    if (path.startsWith(DLCPath, Qt::CaseInsensitive))
     {
-        QDirIterator IsbIterator(g_GameData->bioGamePath() + "/Content", QDir::Files | QDir::NoSymLinks, QDirIterator::Subdirectories);
-        while (IsbIterator.hasNext())
+        QString DLCDir = path.mid(DLCPath.length()).section('/', 0, 0);
+        if (!DLCDir.startsWith("DLC_", Qt::CaseInsensitive))
+            return false;
+        entryPath = path.mid(DLCPath.length() + DLCDir.length() + 1);
+        if (gameType == MeType::ME1_TYPE)
         {
-            IsbIterator.next();
-            if (IsbIterator.filePath().endsWith(".isb", Qt::CaseInsensitive))
-                files.push_back(IsbIterator.filePath().mid(pathLen + 1));
+            if (!hasTocExtension(path, me1DlcTocExtensions))
+                return false;
+            tocPath = g_GameData->bioGamePath() + "/PCConsoleTOC.bin";
         }
+        else
+        {
+            if (!hasTocExtension(path, dlcTocExtensions) ||
+                !QFile::exists(DLCPath + DLCDir + g_GameData->DLCDataSuffix() + "/Mount.dlc"))
+            {
+                return false;
+            }
+            tocPath = DLCPath + DLCDir + "/PCConsoleTOC.bin";
+        }
+        return true;
     }
 
-    QDirIterator UsfIterator(gamePath + "/Engine", QDir::Files | QDir::NoSymLinks, QDirIterator::Subdirectories);
-    while (UsfIterator.hasNext())
+    if (path.startsWith(g_GameData->MainData() + "/", Qt::CaseInsensitive) &&
+        hasTocExtension(path, mainTocExtensions))
     {
-        UsfIterator.next();
-        if (UsfIterator.filePath().endsWith(".usf", Qt::CaseInsensitive))
-            files.push_back(UsfIterator.filePath().mid(pathLen + 1));
+        QString gamePath = g_GameData->GamePath() + "/Game/ME" + QString::number((int)gameType);
+        entryPath = path.mid(gamePath.length() + 1);
+        tocPath = g_GameData->bioGamePath() + "/PCConsoleTOC.bin";
+        return true;
     }
 
-    if (gameType == MeType::ME1_TYPE && QDir(g_GameData->DLCData()).exists())
+    return false;
+}
+
+bool TOCBinFile::PatchTocBinFile(const QString &tocPath, const QVector<FileEntry>& filesList)
+{
+    if (!QFile::exists(tocPath))
+        return false;
+
+    ByteBuffer buffer;
     {
-        int pathLen = g_GameData->DLCData().length();
-        QStringList DLCs = QDir(g_GameData->DLCData(), "DLC_*", QDir::NoSort, QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks).entryList();
-        foreach (QString DLCDir, DLCs)
+        FileStream tocFile = FileStream(tocPath, FileMode::Open, FileAccess::ReadOnly);
+        buffer = tocFile.ReadAllToBuffer();
+    }
+    quint8 *data = buffer.ptr();
+    qint64 length = buffer.size();
+    if (length < 12 || *reinterpret_cast<quint32 *>(data) != TOCTag)
+    {
+        buffer.Free();
+        return false;
+    }
+
+    quint32 tableSize = *reinterpret_cast<quint32 *>(data + 8);
+    if (tableSize == 0 || 12 + tableSize * 8LL > length)
+    {
+        buffer.Free();
+        return false;
+    }
+
+    bool modified = false;
+    for (const auto& fileEntry : filesList)
+    {
+        qint64 tablePos = 12 + (fileEntry.hashFilename % tableSize) * 8;
+        qint64 entryPos = tablePos + *reinterpret_cast<quint32 *>(data + tablePos);
+        quint32 count = *reinterpret_cast<quint32 *>(data + tablePos + 4);
+        bool found = false;
+        for (quint32 i = 0; i < count && entryPos + 28 < length; i++)
         {
-            QString validDlcPath = g_GameData->DLCData() + "/" + DLCDir + "/AutoLoad.ini";
-            if (!QFile::exists(validDlcPath))
-                continue;
-            QDirIterator iterator(g_GameData->DLCData() + "/" + DLCDir, QDir::Files | QDir::NoSymLinks, QDirIterator::Subdirectories);
-            while (iterator.hasNext())
+            auto name = reinterpret_cast<const char *>(data + entryPos + 28);
+            int nameLen = qstrnlen(name, length - entryPos - 28);
+            if (QString::fromLatin1(name, nameLen).compare(fileEntry.path, Qt::CaseInsensitive) == 0)
             {
-                iterator.next();
-                if (iterator.filePath().endsWith(".pcc", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".upk", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".tfc", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".tlk", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".afc", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".cnd", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".bik", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".ini", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".dlc", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".bin", Qt::CaseInsensitive))
+                auto size = reinterpret_cast<quint32 *>(data + entryPos + 4);
+                if (*size != fileEntry.size)
                 {
-                    files.push_back(iterator.filePath().mid(pathLen + DLCDir.length() + 2));
+                    *size = fileEntry.size;
+                    modified = true;
                 }
+                found = true;
+                break;
             }
+            entryPos += ((28 + (nameLen + 1) + 3) / 4) * 4; // align to 4
+        }
+        if (!found)
+        {
+            buffer.Free();
+            return false;
         }
     }
 
-    QVector<FileEntry> filesList;
-    for (int f = 0; f < files.count(); f++)
+    if (modified)
     {
-        FileEntry file{};
-        QString path = gamePath + "/" + files[f];
-        file.size = QFileInfo(path).size();
-        QString filenameToHash = BaseName(files[f]).toUpper();
-        file.hashFilename = hashFilename(filenameToHash.toStdString().c_str(), filenameToHash.length());
-        file.path = files[f].replace(QChar('/'), QChar('\\'), Qt::CaseInsensitive);
-        filesList.push_back(file);
+        FileStream tocFile = FileStream(tocPath, FileMode::Create, FileAccess::WriteOnly);
+        tocFile.WriteFromBuffer(buffer);
     }
-    QString tocFile = g_GameData->bioGamePath() + "/PCConsoleTOC.bin";
-    CreateTocBinFile(tocFile, filesList);
+    buffer.Free();
+
+    return true;
 }
 
-void TOCBinFile::GenerateDLCsTocBinFiles()
+void TOCBinFile::AddTocFile(QVector<FileEntry> &filesList, const QString &path, qint64 size)
+{
+    FileEntry file{};
+    file.size = size;
+    QString filenameToHash = BaseName(path).toUpper();
+    file.hashFilename = hashFilename(filenameToHash.toStdString().c_str(), filenameToHash.length());
+    file.path = QString(path).replace(QChar('/'), QChar('\\'), Qt::CaseInsensitive);
+    filesList.push_back(file);
+}
+
+void TOCBinFile::GenerateMainTocBinFile(MeType gameType)
 {
-    if (QDir(g_GameData->DLCData()).exists())
+    const FileInventory &inventory = g_GameData->inventory;
+    int basePathLen = g_GameData->GamePath().length();
+    QString gamePath = "/Game/ME" + QString::number((int)gameType);
+    int pathLen = gamePath.length();
+    QVector<FileEntry> filesList;
+
+    for (auto entry : inventory.Files(g_GameData->MainData().mid(basePathLen), true))
+    {
+        if (hasTocExtension(entry->path, mainTocExtensions))
+            AddTocFile(filesList, entry->path.mid(pathLen + 1), entry->size);
+    }
+
+    for (auto entry : inventory.Files((g_GameData->bioGamePath() + "/Movies").mid(basePathLen), true))
     {
-        int pathLen = g_GameData->DLCData().length();
-        QStringList DLCs = QDir(g_GameData->DLCData(), "DLC_*", QDir::NoSort, QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks).entryList();
+        if (entry->path.endsWith(".bik", Qt::CaseInsensitive))
+            AddTocFile(filesList, entry->path.mid(pathLen + 1), entry->size);
+    }
+
+    for (auto entry : inventory.Files((g_GameData->bioGamePath() + "/Content").mid(basePathLen), true))
+    {
+        if (entry->path.endsWith(".isb", Qt::CaseInsensitive))
+            AddTocFile(filesList, entry->path.mid(pathLen + 1), entry->size);
+    }
+
+    for (auto entry : inventory.Files(gamePath + "/Engine", true))
+    {
+        if (entry->path.endsWith(".usf", Qt::CaseInsensitive))
+            AddTocFile(filesList, entry->path.mid(pathLen + 1), entry->size);
+    }
+
+    if (gameType == MeType::ME1_TYPE)
+    {
+        QString DLCPath = g_GameData->DLCData().mid(basePathLen);
+        QStringList DLCs = inventory.SubDirs(DLCPath);
         foreach (QString DLCDir, DLCs)
         {
-            QStringList files;
-            QString validDlcPath = g_GameData->DLCData() + "/" + DLCDir + g_GameData->DLCDataSuffix() + "/Mount.dlc";
-            if (!QFile::exists(validDlcPath))
+            if (!DLCDir.startsWith("DLC_", Qt::CaseInsensitive))
                 continue;
-            QDirIterator iterator(g_GameData->DLCData() + "/" + DLCDir, QDir::Files | QDir::NoSymLinks, QDirIterator::Subdirectories);
-            while (iterator.hasNext())
+            if (!inventory.Find(DLCPath + "/" + DLCDir + "/AutoLoad.ini"))
+                continue;
+            int DLCPathLen = DLCPath.length() + DLCDir.length() + 2;
+            for (auto entry : inventory.Files(DLCPath + "/" + DLCDir, true))
             {
-                iterator.next();
-                if (iterator.filePath().endsWith(".pcc", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".upk", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".tfc", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".tlk", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".afc", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".cnd", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".bik", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".ini", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".txt", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".dlc", Qt::CaseInsensitive) ||
-                    iterator.filePath().endsWith(".bin", Qt::CaseInsensitive))
-                {
-                    files.push_back(iterator.filePath().mid(pathLen + DLCDir.length() + 2));
-                }
+                if (hasTocExtension(entry->path, me1DlcTocExtensions))
+                    AddTocFile(filesList, entry->path.mid(DLCPathLen), entry->size);
             }
+        }
+    }
 
-            QVector<FileEntry> filesList;
-            for (int f = 0; f < files.count(); f++)
-            {
-                FileEntry file{};
-                QString path = g_GameData->DLCData() + "/" + DLCDir + "/" + files[f];
-                file.size = QFileInfo(path).size();
-                QString filenameToHash = BaseName(files[f]).toUpper();
-                file.hashFilename = hashFilename(filenameToHash.toStdString().c_str(), filenameToHash.length());
-                file.path = files[f].replace(QChar('/'), QChar('\\'), Qt::CaseInsensitive);
-                filesList.push_back(file);
-            }
-            QString tocFile = g_GameData->DLCData() + "/" + DLCDir + "/PCConsoleTOC.bin";
-            CreateTocBinFile(tocFile, filesList);
+    QString tocFile = g_GameData->bioGamePath() + "/PCConsoleTOC.bin";
+    CreateTocBinFile(tocFile, filesList);
+}
+
+void TOCBinFile::GenerateDLCsTocBinFiles()
+{
+    const FileInventory &inventory = g_GameData->inventory;
+    int basePathLen = g_GameData->GamePath().length();
+    QString DLCPath = g_GameData->DLCData().mid(basePathLen);
+    QStringList DLCs = inventory.SubDirs(DLCPath);
+    foreach (QString DLCDir, DLCs)
+    {
+        if (!DLCDir.startsWith("DLC_", Qt::CaseInsensitive))
+            continue;
+        if (!inventory.Find(DLCPath + "/" + DLCDir + g_GameData->DLCDataSuffix() + "/Mount.dlc"))
+            continue;
+        int DLCPathLen = DLCPath.length() + DLCDir.length() + 2;
+        QVector<FileEntry> filesList;
+        for (auto entry : inventory.Files(DLCPath + "/" + DLCDir, true))
+        {
+            if (hasTocExtension(entry->path, dlcTocExtensions))
+                AddTocFile(filesList, entry->path.mid(DLCPathLen), entry->size);
         }
+        QString tocFile = g_GameData->DLCData() + "/" + DLCDir + "/PCConsoleTOC.bin";
+        CreateTocBinFile(tocFile, filesList);
     }
 }
 
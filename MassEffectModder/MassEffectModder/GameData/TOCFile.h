@@ -37,13 +37,19 @@ class TOCBinFile
 
 private:
 
+    static void AddTocFile(QVector<FileEntry> &filesList, const QString &path, qint64 size);
     static void GenerateMainTocBinFile(MeType gameType);
     static void GenerateDLCsTocBinFiles();
     static void CreateTocBinFile(QString &path, const QVector<FileEntry>& filesList);
+    static bool LocateTocEntry(MeType gameType, const QString &path, QString &tocPath, QString &entryPath);
+    static bool PatchTocBinFile(const QString &tocPath, const QVector<FileEntry>& filesList);
 
 public:
 
+    static void RegisterChangedFile(const QString &path);
+    static void RegisterNewFile(const QString &path);
     static void UpdateAllTOCBinFiles(MeType gameType);
+    static void UpdateChangedTOCBinFiles(MeType gameType);
 };
 
 #endif
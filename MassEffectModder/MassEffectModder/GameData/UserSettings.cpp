@@ -21,96 +21,97 @@
 
 #include <GameData/UserSettings.h>
 #include <Helpers/Exception.h>
+#include <Helpers/IpcChannel.h>
 #include <Helpers/MiscHelpers.h>
 
 void UserSettings::readLODIpc(MeType gameId, ConfigIni &engineConf)
 {
     if (gameId == MeType::ME1_TYPE)
     {
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_World=" + engineConf.Read("TEXTUREGROUP_World", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_WorldSpecular=" + engineConf.Read("TEXTUREGROUP_WorldSpecular", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_WorldNormalMap=" + engineConf.Read("TEXTUREGROUP_WorldNormalMap", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_AmbientLightMap=" + engineConf.Read("TEXTUREGROUP_AmbientLightMap", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_ShadowMap=" + engineConf.Read("TEXTUREGROUP_ShadowMap", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_RenderTarget=" + engineConf.Read("TEXTUREGROUP_RenderTarget", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Environment_64=" + engineConf.Read("TEXTUREGROUP_Environment_64", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Environment_128=" + engineConf.Read("TEXTUREGROUP_Environment_128", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Environment_256=" + engineConf.Read("TEXTUREGROUP_Environment_256", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Environment_512=" + engineConf.Read("TEXTUREGROUP_Environment_512", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Environment_1024=" + engineConf.Read("TEXTUREGROUP_Environment_1024", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_VFX_64=" + engineConf.Read("TEXTUREGROUP_VFX_64", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_VFX_128=" + engineConf.Read("TEXTUREGROUP_VFX_128", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_VFX_256=" + engineConf.Read("TEXTUREGROUP_VFX_256", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_VFX_512=" + engineConf.Read("TEXTUREGROUP_VFX_512", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_VFX_1024=" + engineConf.Read("TEXTUREGROUP_VFX_1024", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_APL_128=" + engineConf.Read("TEXTUREGROUP_APL_128", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_APL_256=" + engineConf.Read("TEXTUREGROUP_APL_256", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_APL_512=" + engineConf.Read("TEXTUREGROUP_APL_512", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_APL_1024=" + engineConf.Read("TEXTUREGROUP_APL_1024", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_UI=" + engineConf.Read("TEXTUREGROUP_UI", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Promotional=" + engineConf.Read("TEXTUREGROUP_Promotional", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Character_1024=" + engineConf.Read("TEXTUREGROUP_Character_1024", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Character_Diff=" + engineConf.Read("TEXTUREGROUP_Character_Diff", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Character_Norm=" + engineConf.Read("TEXTUREGROUP_Character_Norm", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Character_Spec=" + engineConf.Read("TEXTUREGROUP_Character_Spec", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_World=" + engineConf.Read("TEXTUREGROUP_World", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_WorldSpecular=" + engineConf.Read("TEXTUREGROUP_WorldSpecular", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_WorldNormalMap=" + engineConf.Read("TEXTUREGROUP_WorldNormalMap", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_AmbientLightMap=" + engineConf.Read("TEXTUREGROUP_AmbientLightMap", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_ShadowMap=" + engineConf.Read("TEXTUREGROUP_ShadowMap", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_RenderTarget=" + engineConf.Read("TEXTUREGROUP_RenderTarget", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Environment_64=" + engineConf.Read("TEXTUREGROUP_Environment_64", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Environment_128=" + engineConf.Read("TEXTUREGROUP_Environment_128", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Environment_256=" + engineConf.Read("TEXTUREGROUP_Environment_256", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Environment_512=" + engineConf.Read("TEXTUREGROUP_Environment_512", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Environment_1024=" + engineConf.Read("TEXTUREGROUP_Environment_1024", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_VFX_64=" + engineConf.Read("TEXTUREGROUP_VFX_64", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_VFX_128=" + engineConf.Read("TEXTUREGROUP_VFX_128", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_VFX_256=" + engineConf.Read("TEXTUREGROUP_VFX_256", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_VFX_512=" + engineConf.Read("TEXTUREGROUP_VFX_512", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_VFX_1024=" + engineConf.Read("TEXTUREGROUP_VFX_1024", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_APL_128=" + engineConf.Read("TEXTUREGROUP_APL_128", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_APL_256=" + engineConf.Read("TEXTUREGROUP_APL_256", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_APL_512=" + engineConf.Read("TEXTUREGROUP_APL_512", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_APL_1024=" + engineConf.Read("TEXTUREGROUP_APL_1024", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_UI=" + engineConf.Read("TEXTUREGROUP_UI", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Promotional=" + engineConf.Read("TEXTUREGROUP_Promotional", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Character_1024=" + engineConf.Read("TEXTUREGROUP_Character_1024", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Character_Diff=" + engineConf.Read("TEXTUREGROUP_Character_Diff", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Character_Norm=" + engineConf.Read("TEXTUREGROUP_Character_Norm", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Character_Spec=" + engineConf.Read("TEXTUREGROUP_Character_Spec", "SystemSettings"));
     }
     else if (gameId == MeType::ME2_TYPE)
     {
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_World=" + engineConf.Read("TEXTUREGROUP_World", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_WorldSpecular=" + engineConf.Read("TEXTUREGROUP_WorldSpecular", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_WorldNormalMap=" + engineConf.Read("TEXTUREGROUP_WorldNormalMap", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_AmbientLightMap=" + engineConf.Read("TEXTUREGROUP_AmbientLightMap", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_ShadowMap=" + engineConf.Read("TEXTUREGROUP_ShadowMap", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_RenderTarget=" + engineConf.Read("TEXTUREGROUP_RenderTarget", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Environment_64=" + engineConf.Read("TEXTUREGROUP_Environment_64", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Environment_128=" + engineConf.Read("TEXTUREGROUP_Environment_128", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Environment_256=" + engineConf.Read("TEXTUREGROUP_Environment_256", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Environment_512=" + engineConf.Read("TEXTUREGROUP_Environment_512", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Environment_1024=" + engineConf.Read("TEXTUREGROUP_Environment_1024", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_VFX_64=" + engineConf.Read("TEXTUREGROUP_VFX_64", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_VFX_128=" + engineConf.Read("TEXTUREGROUP_VFX_128", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_VFX_256=" + engineConf.Read("TEXTUREGROUP_VFX_256", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_VFX_512=" + engineConf.Read("TEXTUREGROUP_VFX_512", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_VFX_1024=" + engineConf.Read("TEXTUREGROUP_VFX_1024", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_APL_128=" + engineConf.Read("TEXTUREGROUP_APL_128", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_APL_256=" + engineConf.Read("TEXTUREGROUP_APL_256", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_APL_512=" + engineConf.Read("TEXTUREGROUP_APL_512", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_APL_1024=" + engineConf.Read("TEXTUREGROUP_APL_1024", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_UI=" + engineConf.Read("TEXTUREGROUP_UI", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Promotional=" + engineConf.Read("TEXTUREGROUP_Promotional", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Character_1024=" + engineConf.Read("TEXTUREGROUP_Character_1024", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Character_Diff=" + engineConf.Read("TEXTUREGROUP_Character_Diff", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Character_Norm=" + engineConf.Read("TEXTUREGROUP_Character_Norm", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Character_Spec=" + engineConf.Read("TEXTUREGROUP_Character_Spec", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_World=" + engineConf.Read("TEXTUREGROUP_World", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_WorldSpecular=" + engineConf.Read("TEXTUREGROUP_WorldSpecular", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_WorldNormalMap=" + engineConf.Read("TEXTUREGROUP_WorldNormalMap", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_AmbientLightMap=" + engineConf.Read("TEXTUREGROUP_AmbientLightMap", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_ShadowMap=" + engineConf.Read("TEXTUREGROUP_ShadowMap", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_RenderTarget=" + engineConf.Read("TEXTUREGROUP_RenderTarget", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Environment_64=" + engineConf.Read("TEXTUREGROUP_Environment_64", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Environment_128=" + engineConf.Read("TEXTUREGROUP_Environment_128", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Environment_256=" + engineConf.Read("TEXTUREGROUP_Environment_256", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Environment_512=" + engineConf.Read("TEXTUREGROUP_Environment_512", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Environment_1024=" + engineConf.Read("TEXTUREGROUP_Environment_1024", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_VFX_64=" + engineConf.Read("TEXTUREGROUP_VFX_64", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_VFX_128=" + engineConf.Read("TEXTUREGROUP_VFX_128", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_VFX_256=" + engineConf.Read("TEXTUREGROUP_VFX_256", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_VFX_512=" + engineConf.Read("TEXTUREGROUP_VFX_512", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_VFX_1024=" + engineConf.Read("TEXTUREGROUP_VFX_1024", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_APL_128=" + engineConf.Read("TEXTUREGROUP_APL_128", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_APL_256=" + engineConf.Read("TEXTUREGROUP_APL_256", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_APL_512=" + engineConf.Read("TEXTUREGROUP_APL_512", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_APL_1024=" + engineConf.Read("TEXTUREGROUP_APL_1024", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_UI=" + engineConf.Read("TEXTUREGROUP_UI", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Promotional=" + engineConf.Read("TEXTUREGROUP_Promotional", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Character_1024=" + engineConf.Read("TEXTUREGROUP_Character_1024", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Character_Diff=" + engineConf.Read("TEXTUREGROUP_Character_Diff", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Character_Norm=" + engineConf.Read("TEXTUREGROUP_Character_Norm", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Character_Spec=" + engineConf.Read("TEXTUREGROUP_Character_Spec", "SystemSettings"));
     }
     else if (gameId == MeType::ME3_TYPE)
     {
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_World=" + engineConf.Read("TEXTUREGROUP_World", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_WorldSpecular=" + engineConf.Read("TEXTUREGROUP_WorldSpecular", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_WorldNormalMap=" + engineConf.Read("TEXTUREGROUP_WorldNormalMap", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_AmbientLightMap=" + engineConf.Read("TEXTUREGROUP_AmbientLightMap", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_ShadowMap=" + engineConf.Read("TEXTUREGROUP_ShadowMap", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_RenderTarget=" + engineConf.Read("TEXTUREGROUP_RenderTarget", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Environment_64=" + engineConf.Read("TEXTUREGROUP_Environment_64", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Environment_128=" + engineConf.Read("TEXTUREGROUP_Environment_128", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Environment_256=" + engineConf.Read("TEXTUREGROUP_Environment_256", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Environment_512=" + engineConf.Read("TEXTUREGROUP_Environment_512", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Environment_1024=" + engineConf.Read("TEXTUREGROUP_Environment_1024", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_VFX_64=" + engineConf.Read("TEXTUREGROUP_VFX_64", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_VFX_128=" + engineConf.Read("TEXTUREGROUP_VFX_128", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_VFX_256=" + engineConf.Read("TEXTUREGROUP_VFX_256", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_VFX_512=" + engineConf.Read("TEXTUREGROUP_VFX_512", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_VFX_1024=" + engineConf.Read("TEXTUREGROUP_VFX_1024", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_APL_128=" + engineConf.Read("TEXTUREGROUP_APL_128", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_APL_256=" + engineConf.Read("TEXTUREGROUP_APL_256", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_APL_512=" + engineConf.Read("TEXTUREGROUP_APL_512", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_APL_1024=" + engineConf.Read("TEXTUREGROUP_APL_1024", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_UI=" + engineConf.Read("TEXTUREGROUP_UI", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Promotional=" + engineConf.Read("TEXTUREGROUP_Promotional", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Character_1024=" + engineConf.Read("TEXTUREGROUP_Character_1024", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Character_Diff=" + engineConf.Read("TEXTUREGROUP_Character_Diff", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Character_Norm=" + engineConf.Read("TEXTUREGROUP_Character_Norm", "SystemSettings"));
-        ConsoleWrite(QString("[IPC]LODLINE ") + "TEXTUREGROUP_Character_Spec=" + engineConf.Read("TEXTUREGROUP_Character_Spec", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_World=" + engineConf.Read("TEXTUREGROUP_World", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_WorldSpecular=" + engineConf.Read("TEXTUREGROUP_WorldSpecular", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_WorldNormalMap=" + engineConf.Read("TEXTUREGROUP_WorldNormalMap", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_AmbientLightMap=" + engineConf.Read("TEXTUREGROUP_AmbientLightMap", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_ShadowMap=" + engineConf.Read("TEXTUREGROUP_ShadowMap", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_RenderTarget=" + engineConf.Read("TEXTUREGROUP_RenderTarget", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Environment_64=" + engineConf.Read("TEXTUREGROUP_Environment_64", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Environment_128=" + engineConf.Read("TEXTUREGROUP_Environment_128", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Environment_256=" + engineConf.Read("TEXTUREGROUP_Environment_256", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Environment_512=" + engineConf.Read("TEXTUREGROUP_Environment_512", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Environment_1024=" + engineConf.Read("TEXTUREGROUP_Environment_1024", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_VFX_64=" + engineConf.Read("TEXTUREGROUP_VFX_64", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_VFX_128=" + engineConf.Read("TEXTUREGROUP_VFX_128", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_VFX_256=" + engineConf.Read("TEXTUREGROUP_VFX_256", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_VFX_512=" + engineConf.Read("TEXTUREGROUP_VFX_512", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_VFX_1024=" + engineConf.Read("TEXTUREGROUP_VFX_1024", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_APL_128=" + engineConf.Read("TEXTUREGROUP_APL_128", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_APL_256=" + engineConf.Read("TEXTUREGROUP_APL_256", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_APL_512=" + engineConf.Read("TEXTUREGROUP_APL_512", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_APL_1024=" + engineConf.Read("TEXTUREGROUP_APL_1024", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_UI=" + engineConf.Read("TEXTUREGROUP_UI", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Promotional=" + engineConf.Read("TEXTUREGROUP_Promotional", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Character_1024=" + engineConf.Read("TEXTUREGROUP_Character_1024", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Character_Diff=" + engineConf.Read("TEXTUREGROUP_Character_Diff", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Character_Norm=" + engineConf.Read("TEXTUREGROUP_Character_Norm", "SystemSettings"));
+        IpcChannel::Send(IpcEvent::LodLine, "TEXTUREGROUP_Character_Spec=" + engineConf.Read("TEXTUREGROUP_Character_Spec", "SystemSettings"));
     }
     else
     {
@@ -46,12 +46,8 @@ void LayoutMain::CheckGameFilesSelected(MeType gameType)
 
     QString errors;
     QStringList modList;
-    Resources resources;
 
-    resources.loadMD5Tables();
-
-    bool vanilla = Misc::checkGameFiles(gameType, resources,
-                                        errors, modList,
+    bool vanilla = Misc::checkGameFiles(gameType, errors, modList,
                                         &LayoutMain::CheckCallback,
                                         mainWindow);
 
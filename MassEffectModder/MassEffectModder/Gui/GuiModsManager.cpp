@@ -78,9 +78,7 @@ void LayoutMain::ExtractModsSelected(MeType gameType)
     }
 
     QList<TextureMapEntry> textures;
-    Resources resources;
-    resources.loadMD5Tables();
-    TreeScan::loadTexturesMap(gameType, resources, textures);
+    TreeScan::loadTexturesMap(gameType, textures);
 
     g_logs->BufferClearErrors();
     g_logs->BufferEnableErrors(true);
@@ -165,9 +163,7 @@ void LayoutMain::CreateModSelected(MeType gameType)
     g_logs->BufferEnableErrors(true);
 
     QList<TextureMapEntry> textures;
-    Resources resources;
-    resources.loadMD5Tables();
-    TreeScan::loadTexturesMap(gameType, resources, textures);
+    TreeScan::loadTexturesMap(gameType, textures);
     if (!Misc::convertDataModtoMem(list, modFile, gameType, textures, false, false, false, 0.2f,
                               &LayoutMain::CreateModCallback, mainWindow))
     {
@@ -252,13 +252,11 @@ void LayoutInstallModsManager::InstallMods(QStringList &mods)
         return;
     }
 
-    Resources resources;
-    resources.loadMD5Tables();
 
     g_logs->BufferClearErrors();
     g_logs->BufferEnableErrors(true);
 
-    if (!Misc::InstallMods(gameType, resources, mods, false, false, false, false, -1,
+    if (!Misc::InstallMods(gameType, mods, false, false, false, false, -1,
                            &LayoutInstallModsManager::InstallModsCallback, mainWindow))
     {
         QMessageBox::critical(this, "Installing MEM mods", "Installation failed!");
@@ -88,8 +88,6 @@ void LayoutInstallerMain::StartSelected()
 {
     buttonStart->hide();
 
-    Resources resources;
-    resources.loadMD5Tables();
 
     ConfigIni configIni = ConfigIni();
     g_GameData->Init(gameId, configIni);
@@ -147,7 +145,7 @@ void LayoutInstallerMain::StartSelected()
     g_logs->BufferClearErrors();
     g_logs->BufferEnableErrors(true);
 
-    if (!Misc::InstallMods(gameId, resources, modFiles, false, false, false, false, -1,
+    if (!Misc::InstallMods(gameId, modFiles, false, false, false, false, -1,
                            &LayoutInstallerMain::InstallCallback, this))
     {
         QMessageBox::critical(this, "Installing MEM mods", "Installation failed!");
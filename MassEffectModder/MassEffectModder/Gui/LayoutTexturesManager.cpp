@@ -35,6 +35,7 @@
 #include <Misc/Misc.h>
 #include <Texture/Texture.h>
 #include <Texture/TextureMovie.h>
+#include <Texture/TextureView.h>
 
 LayoutTexturesManager::LayoutTexturesManager(MainWindow *window, MeType type)
     : mainWindow(window), gameType(type)
@@ -226,10 +227,8 @@ bool LayoutTexturesManager::Startup()
     QString filename = path + QString("/mele%1map.bin").arg(static_cast<int>(gameType));
     if (QFile::exists(filename))
     {
-        FileStream fs = FileStream(filename, FileMode::Open, FileAccess::ReadOnly);
-        uint tag = fs.ReadUInt32();
-        uint version = fs.ReadUInt32();
-        if (tag != textureMapBinTag || version != textureMapBinVersion)
+        QStringList packages = QStringList();
+        if (!TreeScan::loadTexturesMapPackages(filename, packages))
         {
             QMessageBox::critical(this, "Texture Manager",
                                   QString("Detected wrong or old version of textures scan file!") +
@@ -240,29 +239,6 @@ bool LayoutTexturesManager::Startup()
             mainWindow->LockClose(false);
             return false;
         }
-
-        uint countTexture = fs.ReadUInt32();
-        for (uint i = 0; i < countTexture; i++)
-        {
-            fs.Skip(fs.ReadInt32());
-            fs.SkipInt32();
-            uint countPackages = fs.ReadUInt32();
-            for (uint k = 0; k < countPackages; k++)
-            {
-                fs.Skip(8);
-                fs.Skip(fs.ReadInt32());
-            }
-        }
-
-        QStringList packages = QStringList();
-        int numPackages = fs.ReadInt32();
-        for (int i = 0; i < numPackages; i++)
-        {
-            QString pkgPath;
-            fs.ReadStringASCII(pkgPath, fs.ReadInt32());
-            pkgPath.replace(QChar('\\'), QChar('/'));
-            packages.push_back(pkgPath);
-        }
         for (int i = 0; i < packages.count(); i++)
         {
             bool found = false;
@@ -387,11 +363,9 @@ bool LayoutTexturesManager::Startup()
     {
         mainWindow->statusBar()->showMessage("Preparing to scan textures...");
         QApplication::processEvents();
-        resources.loadMD5Tables();
         g_logs->BufferClearErrors();
         g_logs->BufferEnableErrors(true);
-        TreeScan::PrepareListOfTextures(gameType, resources,
-                                        textures, true,
+        TreeScan::PrepareListOfTextures(gameType, textures, true,
                                         &LayoutTexturesManager::PrepareTexturesCallback,
                                         mainWindow);
         g_logs->BufferEnableErrors(false);
@@ -714,7 +688,7 @@ void LayoutTexturesManager::UpdateRight(const QListWidgetItem *item)
 
         Package package;
         package.Open(g_GameData->GamePath() + nodeTexture.path);
-        ByteBuffer exportData = package.getExportData(nodeTexture.exportID);
+        UniqueByteBuffer exportData = TextureView::getTopMipExportData(package, nodeTexture.exportID);
         if (exportData.ptr() == nullptr)
         {
             PERROR(QString(QString("Error: Texture ") + package.exportsTable[nodeTexture.exportID].objectName +
@@ -723,8 +697,7 @@ void LayoutTexturesManager::UpdateRight(const QListWidgetItem *item)
                     "\nSkipping...\n").toStdString().c_str());
             return;
         }
-        Texture texture(package, nodeTexture.exportID, exportData);
-        exportData.Free();
+        TextureView texture(package, nodeTexture.exportID, std::move(exportData));
         ByteBuffer data = texture.getTopImageData();
         if (data.ptr() == nullptr)
         {
@@ -784,7 +757,7 @@ void LayoutTexturesManager::UpdateRight(const QListWidgetItem *item)
             TextureMapPackageEntry nodeTexture = textures[viewTexture.indexInTextures].list[index2];
             Package package;
             package.Open(g_GameData->GamePath() + nodeTexture.path);
-            ByteBuffer exportData = package.getExportData(nodeTexture.exportID);
+            UniqueByteBuffer exportData = package.getExportData(nodeTexture.exportID);
             if (exportData.ptr() == nullptr)
             {
                 text += "Error: Texture " + package.exportsTable[nodeTexture.exportID].objectName +
@@ -810,8 +783,7 @@ void LayoutTexturesManager::UpdateRight(const QListWidgetItem *item)
             }
             else
             {
-                Texture texture(package, nodeTexture.exportID, exportData);
-                exportData.Free();
+                TextureView texture(package, nodeTexture.exportID, std::move(exportData));
                 text += "\nTexture instance: " + QString::number(index2 + 1) + "\n";
                 text += "  Texture name:       " + package.exportsTable[nodeTexture.exportID].objectName + "\n";
                 text += "  Export Id:          " + QString::number(nodeTexture.exportID + 1) + "\n";
@@ -981,7 +953,7 @@ void LayoutTexturesManager::ReplaceTexture(const QListWidgetItem *item, bool con
     {
         modEntry.injectedMovieTexture.Free();
     }
-    TOCBinFile::UpdateAllTOCBinFiles(gameType);
+    TOCBinFile::UpdateChangedTOCBinFiles(gameType);
     mainWindow->statusBar()->clearMessage();
     UpdateRight(item);
     if (g_logs->BufferGetErrors() != "")
@@ -1054,7 +1026,7 @@ void LayoutTexturesManager::ExtractTexture(const ViewTexture& viewTexture, bool
     }
     Package package;
     package.Open(g_GameData->GamePath() + nodeTexture.path);
-    ByteBuffer exportData = package.getExportData(nodeTexture.exportID);
+    UniqueByteBuffer exportData = package.getExportData(nodeTexture.exportID);
     if (exportData.ptr() == nullptr)
     {
         QMessageBox::critical(this, "Extracting texture", QString("Error: Texture ") +
@@ -1094,8 +1066,7 @@ void LayoutTexturesManager::ExtractTexture(const ViewTexture& viewTexture, bool
     }
     else
     {
-        Texture texture(package, nodeTexture.exportID, exportData);
-        exportData.Free();
+        Texture texture(package, nodeTexture.exportID, std::move(exportData));
 
         uint crc = Misc::GetCRCFromTextureMap(textures, nodeTexture.exportID, nodeTexture.path);
         if (crc == 0)
@@ -1173,8 +1144,7 @@ void LayoutTexturesManager::ExtractTexture(const ViewTexture& viewTexture, bool
                     LockGui(false);
                     return;
                 }
-                mipmaps.push_back(new MipMap(data, texture.mipMapsList[k].width, texture.mipMapsList[k].height, pixelFormat));
-                data.Free();
+                mipmaps.push_back(new MipMap(UniqueByteBuffer(std::move(data)), texture.mipMapsList[k].width, texture.mipMapsList[k].height, pixelFormat));
             }
             Image image = Image(mipmaps, pixelFormat);
             FileStream fs = FileStream(outputFile, FileMode::Create, FileAccess::WriteOnly);
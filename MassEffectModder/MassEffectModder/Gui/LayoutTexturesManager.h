@@ -116,7 +116,6 @@ private:
 
     ConfigIni      configIni{};
     QList<TextureMapEntry> textures;
-    Resources      resources;
     MeType         gameType;
 
     static void PrepareTexturesCallback(void *handle, int progress, const QString &stage);
@@ -0,0 +1,560 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include "ArchiveStream.h"
+#include "FileStream.h"
+
+#include <Wrappers.h>
+
+#include <QTextCodec>
+
+const QChar ArchiveStream::EntrySeparator = '|';
+
+static void *OpenZipArchive(const QString &archive, int &numEntries)
+{
+#if defined(_WIN32)
+    return ZipOpenFromFile(archive.toStdWString().c_str(), &numEntries);
+#else
+    return ZipOpenFromFile(archive.toStdString().c_str(), &numEntries);
+#endif
+}
+
+// Entries without UTF-8 flag are usually CP437, listing and lookup must
+// decode names the same way so entry paths round trip
+static QString DecodeEntryName(const char *name)
+{
+    QTextCodec::ConverterState state;
+    QString decoded = QTextCodec::codecForName("UTF-8")->toUnicode(name, static_cast<int>(strlen(name)), &state);
+    if (state.invalidChars == 0)
+        return decoded;
+    QTextCodec *codec = QTextCodec::codecForName("IBM 437");
+    if (codec != nullptr)
+        return codec->toUnicode(name);
+    return QString::fromLatin1(name);
+}
+
+static bool LocateZipEntry(void *handle, int numEntries, const QString &entry)
+{
+    for (int i = 0; i < numEntries; i++)
+    {
+        char fileName[260];
+        unsigned long long size = 0;
+        unsigned long fileFlags = 0;
+        if (ZipGetCurrentFileInfo(handle, fileName, sizeof(fileName), &size, &fileFlags) != 0)
+            return false;
+        if (DecodeEntryName(fileName) == entry)
+            return true;
+        if (ZipGoToNextFile(handle) != 0)
+            return false;
+    }
+    return false;
+}
+
+ArchiveStream::ArchiveStream(const QString &archive, const QString &entry)
+    : handle(nullptr), file(nullptr), archivePath(archive), entryName(entry),
+      length(0), position(0), dataOffset(0), stored(false), opened(false),
+      readBuffer(nullptr), bufferPosition(0), bufferLength(0), decodedPosition(0)
+{
+    int numEntries = 0;
+    handle = OpenZipArchive(archivePath, numEntries);
+    if (handle == nullptr)
+        return;
+    if (!LocateZipEntry(handle, numEntries, entryName))
+    {
+        Close();
+        return;
+    }
+
+    char fileName[260];
+    unsigned long long size = 0;
+    unsigned long fileFlags = 0;
+    UINT64 offset = 0;
+    if (ZipGetCurrentFileInfo(handle, fileName, sizeof(fileName), &size, &fileFlags) != 0 ||
+        ZipOpenCurrentFile(handle) != 0 ||
+        ZipGetCurrentFileDataOffset(handle, &offset, &stored) != 0)
+    {
+        Close();
+        return;
+    }
+    length = size;
+    dataOffset = offset;
+
+    if (stored)
+    {
+        ZipCloseCurrentFile(handle);
+        ZipClose(handle);
+        handle = nullptr;
+        file = new QFile(archivePath);
+        if (!file->open(QIODevice::ReadOnly))
+        {
+            Close();
+            return;
+        }
+    }
+    else
+    {
+        readBuffer = static_cast<quint8 *>(std::malloc(readBufferSize));
+        if (readBuffer == nullptr)
+        {
+            CRASH_MSG("ArchiveStream: out of memory.");
+        }
+    }
+    opened = true;
+}
+
+ArchiveStream::~ArchiveStream()
+{
+    Close();
+}
+
+void ArchiveStream::Close()
+{
+    if (handle != nullptr)
+    {
+        ZipCloseCurrentFile(handle);
+        ZipClose(handle);
+        handle = nullptr;
+    }
+    delete file;
+    file = nullptr;
+    std::free(readBuffer);
+    readBuffer = nullptr;
+}
+
+bool ArchiveStream::IsArchive(const QString &path)
+{
+    return path.endsWith(".zip", Qt::CaseInsensitive);
+}
+
+bool ArchiveStream::IsEntryPath(const QString &path)
+{
+    return path.contains(EntrySeparator);
+}
+
+QString ArchiveStream::EntryPath(const QString &archive, const QString &entry)
+{
+    return archive + EntrySeparator + entry;
+}
+
+QString ArchiveStream::ArchiveFromEntryPath(const QString &path)
+{
+    return path.section(EntrySeparator, 0, 0);
+}
+
+QString ArchiveStream::EntryFromEntryPath(const QString &path)
+{
+    return path.section(EntrySeparator, 1);
+}
+
+QStringList ArchiveStream::ListEntries(const QString &archive, const QString &extension)
+{
+    QStringList entries;
+    int numEntries = 0;
+    void *handle = OpenZipArchive(archive, numEntries);
+    if (handle == nullptr)
+        return entries;
+
+    for (int i = 0; i < numEntries; i++)
+    {
+        char fileName[260];
+        unsigned long long size = 0;
+        unsigned long fileFlags = 0;
+        if (ZipGetCurrentFileInfo(handle, fileName, sizeof(fileName), &size, &fileFlags) != 0)
+            break;
+        QString name = DecodeEntryName(fileName);
+        if (size != 0 && name.endsWith("." + extension, Qt::CaseInsensitive))
+            entries.push_back(EntryPath(archive, name));
+        ZipGoToNextFile(handle);
+    }
+    ZipClose(handle);
+
+    entries.sort(Qt::CaseInsensitive);
+    return entries;
+}
+
+std::unique_ptr<Stream> ArchiveStream::OpenRead(const QString &path)
+{
+    if (IsEntryPath(path))
+    {
+        std::unique_ptr<ArchiveStream> stream(new ArchiveStream(ArchiveFromEntryPath(path),
+                                                                EntryFromEntryPath(path)));
+        if (!stream->isOpen())
+            return nullptr;
+        return stream;
+    }
+    return std::unique_ptr<Stream>(new FileStream(path, FileMode::Open, FileAccess::ReadOnly));
+}
+
+bool ArchiveStream::ExtractTo(const QString &outputFile)
+{
+    if (!opened)
+        return false;
+
+    QFile output(outputFile);
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    std::unique_ptr<quint8[]> buffer(new quint8[readBufferSize]);
+    if (stored && !file->seek(dataOffset))
+        return false;
+    if (!stored && decodedPosition != 0)
+        RestartDecoding();
+
+    qint64 remaining = length;
+    while (remaining > 0)
+    {
+        qint64 size;
+        if (stored)
+        {
+            size = file->read(reinterpret_cast<char *>(buffer.get()),
+                              qMin(remaining, static_cast<qint64>(readBufferSize)));
+        }
+        else
+        {
+            size = ZipReadCurrentFileChunk(handle, buffer.get(), readBufferSize);
+        }
+        if (size <= 0 || size > remaining)
+            return false;
+        if (output.write(reinterpret_cast<const char *>(buffer.get()), size) != size)
+            return false;
+        remaining -= size;
+    }
+    if (!stored)
+    {
+        decodedPosition = length;
+        bufferPosition = 0;
+        bufferLength = 0;
+    }
+
+    return true;
+}
+
+void ArchiveStream::RestartDecoding()
+{
+    if (ZipCloseCurrentFile(handle) != 0 || ZipOpenCurrentFile(handle) != 0)
+    {
+        auto error = (QString("Error: Failed to reopen ") + entryName + " in archive: " + archivePath + "\n").toStdString();
+        CRASH_MSG(error.c_str());
+    }
+    decodedPosition = 0;
+    bufferPosition = 0;
+    bufferLength = 0;
+}
+
+void ArchiveStream::FillBuffer(qint64 offset)
+{
+    if (offset < decodedPosition)
+        RestartDecoding();
+
+    do
+    {
+        int readSize = ZipReadCurrentFileChunk(handle, readBuffer, readBufferSize);
+        if (readSize <= 0)
+        {
+            auto error = (QString("Error: Failed to decompress ") + entryName + " in archive: " + archivePath + "\n").toStdString();
+            CRASH_MSG(error.c_str());
+        }
+        bufferPosition = decodedPosition;
+        bufferLength = readSize;
+        decodedPosition += readSize;
+    } while (offset >= decodedPosition);
+}
+
+void ArchiveStream::CopyFrom(Stream &, qint64, qint64)
+{
+    CRASH_MSG("ArchiveStream: stream is read only.");
+}
+
+void ArchiveStream::ReadToBuffer(quint8 *buffer, qint64 count)
+{
+    if (position + count > length)
+    {
+        CRASH_MSG("ArchiveStream::ReadToBuffer() - Error: read out of buffer.");
+    }
+
+    if (stored)
+    {
+        if (!file->seek(dataOffset + position) || file->read(reinterpret_cast<char *>(buffer), count) != count)
+        {
+            auto error = (QString("Error: ") + file->errorString() + ", File: " + archivePath).toStdString();
+            CRASH_MSG(error.c_str());
+        }
+        position += count;
+        return;
+    }
+
+    while (count != 0)
+    {
+        if (position < bufferPosition || position >= bufferPosition + bufferLength)
+            FillBuffer(position);
+        qint64 size = qMin(count, bufferPosition + bufferLength - position);
+        memcpy(buffer, readBuffer + (position - bufferPosition), static_cast<size_t>(size));
+        buffer += size;
+        position += size;
+        count -= size;
+    }
+}
+
+ByteBuffer ArchiveStream::ReadToBuffer(qint64 count)
+{
+    ByteBuffer buffer(count);
+    ReadToBuffer(buffer.ptr(), count);
+    return buffer;
+}
+
+void ArchiveStream::WriteFromBuffer(quint8 *, qint64)
+{
+    CRASH_MSG("ArchiveStream: stream is read only.");
+}
+
+void ArchiveStream::WriteFromBuffer(const ByteBuffer &)
+{
+    CRASH_MSG("ArchiveStream: stream is read only.");
+}
+
+void ArchiveStream::ReadStringASCII(QString &str, qint64 count)
+{
+    std::unique_ptr<char[]> buffer (new char[static_cast<size_t>(count) + 1]);
+
+    buffer.get()[count] = 0;
+    ReadToBuffer(reinterpret_cast<quint8 *>(buffer.get()), count);
+    str = QString(buffer.get());
+}
+
+void ArchiveStream::ReadStringASCIINull(QString &str)
+{
+    str = "";
+    do
+    {
+        auto c = static_cast<char>(ReadByte());
+        if (c == 0)
+            return;
+        str += c;
+    } while (position < length);
+}
+
+void ArchiveStream::ReadStringUnicode16(QString &str, qint64 count)
+{
+    str = "";
+    for (qint64 n = 0; n < count; n++)
+    {
+        quint16 c = ReadUInt16();
+        str += QChar(static_cast<ushort>(c));
+    }
+}
+
+void ArchiveStream::ReadStringUnicode16Null(QString &str)
+{
+    str = "";
+    do
+    {
+        quint16 c = ReadUInt16();
+        if (c == 0)
+            return;
+        str += QChar(static_cast<ushort>(c));
+    } while (position < length);
+}
+
+void ArchiveStream::WriteStringASCII(const QString &)
+{
+    CRASH_MSG("ArchiveStream: stream is read only.");
+}
+
+void ArchiveStream::WriteStringASCIINull(const QString &)
+{
+    CRASH_MSG("ArchiveStream: stream is read only.");
+}
+
+void ArchiveStream::WriteStringUnicode16(const QString &)
+{
+    CRASH_MSG("ArchiveStream: stream is read only.");
+}
+
+void ArchiveStream::WriteStringUnicode16Null(const QString &)
+{
+    CRASH_MSG("ArchiveStream: stream is read only.");
+}
+
+qint64 ArchiveStream::ReadInt64()
+{
+    qint64 value;
+    ReadToBuffer(reinterpret_cast<quint8 *>(&value), sizeof(qint64));
+    return value;
+}
+
+quint64 ArchiveStream::ReadUInt64()
+{
+    quint64 value;
+    ReadToBuffer(reinterpret_cast<quint8 *>(&value), sizeof(quint64));
+    return value;
+}
+
+qint32 ArchiveStream::ReadInt32()
+{
+    qint32 value;
+    ReadToBuffer(reinterpret_cast<quint8 *>(&value), sizeof(qint32));
+    return value;
+}
+
+quint32 ArchiveStream::ReadUInt32()
+{
+    quint32 value;
+    ReadToBuffer(reinterpret_cast<quint8 *>(&value), sizeof(quint32));
+    return value;
+}
+
+qint16 ArchiveStream::ReadInt16()
+{
+    qint16 value;
+    ReadToBuffer(reinterpret_cast<quint8 *>(&value), sizeof(qint16));
+    return value;
+}
+
+quint16 ArchiveStream::ReadUInt16()
+{
+    quint16 value;
+    ReadToBuffer(reinterpret_cast<quint8 *>(&value), sizeof(quint16));
+    return value;
+}
+
+quint8 ArchiveStream::ReadByte()
+{
+    quint8 value;
+    ReadToBuffer(reinterpret_cast<quint8 *>(&value), sizeof(quint8));
+    return value;
+}
+
+void ArchiveStream::WriteInt64(qint64)
+{
+    CRASH_MSG("ArchiveStream: stream is read only.");
+}
+
+void ArchiveStream::WriteUInt64(quint64)
+{
+    CRASH_MSG("ArchiveStream: stream is read only.");
+}
+
+void ArchiveStream::WriteInt32(qint32)
+{
+    CRASH_MSG("ArchiveStream: stream is read only.");
+}
+
+void ArchiveStream::WriteUInt32(quint32)
+{
+    CRASH_MSG("ArchiveStream: stream is read only.");
+}
+
+void ArchiveStream::WriteInt16(qint16)
+{
+    CRASH_MSG("ArchiveStream: stream is read only.");
+}
+
+void ArchiveStream::WriteUInt16(quint16)
+{
+    CRASH_MSG("ArchiveStream: stream is read only.");
+}
+
+void ArchiveStream::WriteByte(quint8)
+{
+    CRASH_MSG("ArchiveStream: stream is read only.");
+}
+
+void ArchiveStream::WriteZeros(qint64)
+{
+    CRASH_MSG("ArchiveStream: stream is read only.");
+}
+
+void ArchiveStream::Seek(qint64 offset, SeekOrigin origin)
+{
+    switch (origin)
+    {
+    case SeekOrigin::Begin:
+    {
+        if (offset < 0)
+        {
+            CRASH_MSG("ArchiveStream: out of stream.");
+        }
+        position = offset;
+        break;
+    }
+    case SeekOrigin::Current:
+    {
+        qint64 newOffset = position + offset;
+        if (newOffset < 0)
+        {
+            CRASH_MSG("ArchiveStream: out of stream.");
+        }
+        position = newOffset;
+        break;
+    }
+    case SeekOrigin::End:
+    {
+        qint64 newOffset = length + offset;
+        if (newOffset < 0)
+        {
+            CRASH_MSG("ArchiveStream: out of stream.");
+        }
+        position = newOffset;
+        break;
+    }
+    }
+}
+
+void ArchiveStream::SeekBegin()
+{
+    Seek(0, SeekOrigin::Begin);
+}
+
+void ArchiveStream::SeekEnd()
+{
+    Seek(0, SeekOrigin::End);
+}
+
+void ArchiveStream::JumpTo(qint64 offset)
+{
+    Seek(offset, SeekOrigin::Begin);
+}
+
+void ArchiveStream::Skip(qint64 offset)
+{
+    Seek(offset, SeekOrigin::Current);
+}
+
+void ArchiveStream::SkipByte()
+{
+    Seek(sizeof(quint8), SeekOrigin::Current);
+}
+
+void ArchiveStream::SkipInt16()
+{
+    Seek(sizeof(quint16), SeekOrigin::Current);
+}
+
+void ArchiveStream::SkipInt32()
+{
+    Seek(sizeof(qint32), SeekOrigin::Current);
+}
+
+void ArchiveStream::SkipInt64()
+{
+    Seek(sizeof(quint64), SeekOrigin::Current);
+}
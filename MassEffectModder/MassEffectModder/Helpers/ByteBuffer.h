@@ -24,8 +24,13 @@
 
 #include <Helpers/Exception.h>
 
+// Copy of ByteBuffer is shallow handle to same memory which must be released
+// by explicit Free() on one of copies. It is kept for data stored in Qt
+// containers, which need copyable types. Use UniqueByteBuffer otherwise.
 struct ByteBuffer
 {
+    friend struct UniqueByteBuffer;
+
 private:
 
     quint8 *_ptr;
@@ -33,6 +38,21 @@ private:
 
 public:
 
+#ifdef BYTEBUFFER_COPY_STATS
+    static std::atomic<qint64> &CopiedBytes()
+    {
+        static std::atomic<qint64> copiedBytes{};
+        return copiedBytes;
+    }
+
+    static void CountCopy(qint64 bytes)
+    {
+        CopiedBytes() += bytes;
+    }
+#else
+    static void CountCopy(qint64 /*bytes*/) {}
+#endif
+
     ByteBuffer()
     {
         _ptr = nullptr;
@@ -54,6 +74,7 @@ public:
             CRASH_MSG((QString("ByteBuffer: Out of memory! - amount: ") + QString::number(size)).toStdString().c_str());
         memcpy(_ptr, ptr, size);
         _size = size;
+        CountCopy(size);
     }
 
     ByteBuffer(const float *ptr, quint64 size)
@@ -63,8 +84,12 @@ public:
             CRASH_MSG((QString("ByteBuffer: Out of memory! - amount: ") + QString::number(size)).toStdString().c_str());
         memcpy(_ptr, ptr, size);
         _size = size;
+        CountCopy(size);
     }
 
+    ByteBuffer(const ByteBuffer &other) = default;
+    ByteBuffer &operator=(const ByteBuffer &other) = default;
+
     void Free()
     {
         delete[] _ptr;
@@ -87,4 +112,152 @@ public:
     }
 };
 
+// Owning buffer, memory is released in destructor. Copy is not allowed,
+// ownership is passed by move only.
+struct UniqueByteBuffer
+{
+private:
+
+    std::unique_ptr<quint8[]> _ptr;
+    qint64 _size;
+
+public:
+
+    UniqueByteBuffer()
+    {
+        _size = 0;
+    }
+
+    explicit UniqueByteBuffer(quint64 size)
+    {
+        _ptr.reset(new quint8[size]);
+        if (_ptr == nullptr)
+            CRASH_MSG((QString("UniqueByteBuffer: Out of memory! - amount: ") + QString::number(size)).toStdString().c_str());
+        _size = size;
+    }
+
+    UniqueByteBuffer(const quint8 *ptr, quint64 size)
+        : UniqueByteBuffer(size)
+    {
+        memcpy(_ptr.get(), ptr, size);
+        ByteBuffer::CountCopy(size);
+    }
+
+    // Takes over memory of buffer, buffer is left empty
+    explicit UniqueByteBuffer(ByteBuffer &&buffer)
+    {
+        _ptr.reset(buffer._ptr);
+        _size = buffer._size;
+        buffer._ptr = nullptr;
+        buffer._size = 0;
+    }
+
+    UniqueByteBuffer(const UniqueByteBuffer &other) = delete;
+    UniqueByteBuffer &operator=(const UniqueByteBuffer &other) = delete;
+
+    UniqueByteBuffer(UniqueByteBuffer &&other) noexcept
+    {
+        _ptr = std::move(other._ptr);
+        _size = other._size;
+        other._size = 0;
+    }
+
+    UniqueByteBuffer &operator=(UniqueByteBuffer &&other) noexcept
+    {
+        if (this != &other)
+        {
+            // unique_ptr assignment releases memory owned so far
+            _ptr = std::move(other._ptr);
+            _size = other._size;
+            other._size = 0;
+        }
+        return *this;
+    }
+
+    ~UniqueByteBuffer() = default;
+
+    void Free()
+    {
+        _ptr.reset();
+        _size = 0;
+    }
+
+    // Hands memory over to shallow ByteBuffer, caller must Free() it
+    [[nodiscard]] ByteBuffer release()
+    {
+        ByteBuffer buffer;
+        buffer._size = _size;
+        buffer._ptr = _ptr.release();
+        _size = 0;
+        return buffer;
+    }
+
+    [[nodiscard]] quint8 *ptr() const
+    {
+        return _ptr.get();
+    }
+
+    [[nodiscard]] float *ptrAsFloat() const
+    {
+        return (float *)_ptr.get();
+    }
+
+    [[nodiscard]] qint64 size() const
+    {
+        return _size;
+    }
+};
+
+// Non-owning view of bytes, valid as long as memory it points to
+struct ByteSpan
+{
+private:
+
+    const quint8 *_ptr;
+    qint64 _size;
+
+public:
+
+    ByteSpan()
+    {
+        _ptr = nullptr;
+        _size = 0;
+    }
+
+    ByteSpan(const quint8 *ptr, qint64 size)
+    {
+        _ptr = ptr;
+        _size = size;
+    }
+
+    ByteSpan(const ByteBuffer &buffer)
+    {
+        _ptr = buffer.ptr();
+        _size = buffer.size();
+    }
+
+    ByteSpan(const UniqueByteBuffer &buffer)
+    {
+        _ptr = buffer.ptr();
+        _size = buffer.size();
+    }
+
+    [[nodiscard]] ByteSpan subSpan(qint64 offset, qint64 count) const
+    {
+        if (offset < 0 || count < 0 || offset + count > _size)
+            CRASH_MSG("ByteSpan: out of range.");
+        return ByteSpan(_ptr + offset, count);
+    }
+
+    [[nodiscard]] const quint8 *ptr() const
+    {
+        return _ptr;
+    }
+
+    [[nodiscard]] qint64 size() const
+    {
+        return _size;
+    }
+};
+
 #endif
@@ -0,0 +1,156 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include <Helpers/CacheFile.h>
+#include <Helpers/MemoryStream.h>
+
+CacheFileReader::CacheFileReader(const QString &path, qint64 maxSize)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        failed = true;
+        return;
+    }
+    data = maxSize < 0 ? file.readAll() : file.read(maxSize);
+    if (file.error() != QFileDevice::NoError)
+        failed = true;
+}
+
+bool CacheFileReader::Available(qint64 count)
+{
+    if (failed || count < 0 || count > Remaining())
+    {
+        failed = true;
+        return false;
+    }
+    return true;
+}
+
+bool CacheFileReader::CheckCount(qint32 count, qint64 minEntrySize)
+{
+    if (failed || count < 0 || count * minEntrySize > Remaining())
+        failed = true;
+    return !failed;
+}
+
+quint8 CacheFileReader::ReadByte()
+{
+    quint8 value = 0;
+    ReadToBuffer(&value, sizeof(value));
+    return value;
+}
+
+qint32 CacheFileReader::ReadInt32()
+{
+    qint32 value = 0;
+    ReadToBuffer(reinterpret_cast<quint8 *>(&value), sizeof(value));
+    return value;
+}
+
+quint32 CacheFileReader::ReadUInt32()
+{
+    quint32 value = 0;
+    ReadToBuffer(reinterpret_cast<quint8 *>(&value), sizeof(value));
+    return value;
+}
+
+qint64 CacheFileReader::ReadInt64()
+{
+    qint64 value = 0;
+    ReadToBuffer(reinterpret_cast<quint8 *>(&value), sizeof(value));
+    return value;
+}
+
+quint64 CacheFileReader::ReadUInt64()
+{
+    quint64 value = 0;
+    ReadToBuffer(reinterpret_cast<quint8 *>(&value), sizeof(value));
+    return value;
+}
+
+void CacheFileReader::ReadToBuffer(quint8 *buffer, qint64 count)
+{
+    if (!Available(count))
+    {
+        memset(buffer, 0, static_cast<size_t>(qMax(count, 0LL)));
+        return;
+    }
+    memcpy(buffer, data.constData() + position, static_cast<size_t>(count));
+    position += count;
+}
+
+ByteBuffer CacheFileReader::ReadToBuffer(qint64 count)
+{
+    if (!Available(count))
+        return {};
+    ByteBuffer buffer(reinterpret_cast<const quint8 *>(data.constData()) + position, count);
+    position += count;
+    return buffer;
+}
+
+void CacheFileReader::ReadStringASCII(QString &str, qint64 count)
+{
+    str = "";
+    if (!Available(count))
+        return;
+    str = QString::fromLatin1(data.constData() + position, static_cast<int>(count));
+    position += count;
+}
+
+void CacheFileReader::ReadStringUnicode16Null(QString &str)
+{
+    str = "";
+    qint64 end = position;
+    for (; end + 2 <= data.size(); end += 2)
+    {
+        if (data[static_cast<int>(end)] == 0 && data[static_cast<int>(end + 1)] == 0)
+            break;
+    }
+    if (!Available(end + 2 - position))
+        return;
+    while (position < end)
+    {
+        quint16 c;
+        memcpy(&c, data.constData() + position, sizeof(c));
+        str += QChar(static_cast<ushort>(c));
+        position += 2;
+    }
+    position += 2;
+}
+
+bool WriteCacheFile(const QString &path, MemoryStream &stream)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    ByteBuffer buffer = stream.ToArray();
+    qint64 written = file.write(reinterpret_cast<const char *>(buffer.ptr()), buffer.size());
+    bool status = written == buffer.size();
+    buffer.Free();
+    if (!status)
+    {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
@@ -0,0 +1,65 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#ifndef CACHE_FILE_H
+#define CACHE_FILE_H
+
+#include <Helpers/ByteBuffer.h>
+
+class MemoryStream;
+
+// Reader of cache files with bounds checks. Reading past end of data
+// marks reader as failed and returns zeros, caller checks Failed().
+class CacheFileReader
+{
+private:
+
+    QByteArray data;
+    qint64 position = 0;
+    bool failed = false;
+
+    bool Available(qint64 count);
+
+public:
+
+    // Reads whole file, or only its first maxSize bytes if not negative
+    explicit CacheFileReader(const QString &path, qint64 maxSize = -1);
+
+    bool Failed() const { return failed; }
+    qint64 Remaining() const { return data.size() - position; }
+    bool CheckCount(qint32 count, qint64 minEntrySize);
+
+    quint8 ReadByte();
+    qint32 ReadInt32();
+    quint32 ReadUInt32();
+    qint64 ReadInt64();
+    quint64 ReadUInt64();
+    void ReadToBuffer(quint8 *buffer, qint64 count);
+    ByteBuffer ReadToBuffer(qint64 count);
+    void ReadStringASCII(QString &str, qint64 count);
+    void ReadStringUnicode16Null(QString &str);
+};
+
+// Replace file with stream content at once, readers never see partial file
+bool WriteCacheFile(const QString &path, MemoryStream &stream);
+
+#endif
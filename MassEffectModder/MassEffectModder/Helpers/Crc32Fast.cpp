@@ -0,0 +1,259 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include <Helpers/Crc32Fast.h>
+
+#include <algorithm>
+#include <vector>
+#include <omp.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CRC32_PCLMUL
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define PCLMUL_TARGET
+#else
+#include <cpuid.h>
+#define PCLMUL_TARGET __attribute__((target("sse2,pclmul")))
+#endif
+#endif
+
+static const uint32_t Polynomial = 0xEDB88320;
+
+enum
+{
+    PclmulMinLength = 64,
+    ParallelMinLength = 4 * 1024 * 1024,
+    ParallelMinPartLength = 1024 * 1024,
+};
+
+#ifdef CRC32_PCLMUL
+
+static bool detectPclmul()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 1)) != 0;
+#else
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+    return (ecx & bit_PCLMUL) != 0;
+#endif
+}
+
+bool crc32_pclmul_supported()
+{
+    static const bool supported = detectPclmul();
+    return supported;
+}
+
+// Folding constants for reflected polynomial from Intel paper
+// "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction"
+PCLMUL_TARGET static uint32_t crc32_pclmul_blocks(const uint8_t* buffer, size_t length, uint32_t crc)
+{
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+    const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163cd6124);
+    const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 0x00));
+    __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 0x10));
+    __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 0x20));
+    __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+    buffer += 64;
+    length -= 64;
+
+    // fold four 128 bit lanes in parallel
+    while (length >= 64)
+    {
+        __m128i x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        __m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        __m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        __m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 0x30)));
+        buffer += 64;
+        length -= 64;
+    }
+
+    // fold lanes into single 128 bit value
+    __m128i x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    // fold remaining 16 bytes blocks
+    while (length >= 16)
+    {
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer))), x5);
+        buffer += 16;
+        length -= 16;
+    }
+
+    // fold 128 bits to 64 bits
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(x1, 4)));
+}
+
+uint32_t crc32_pclmul(const void* data, size_t length, uint32_t previousCrc32)
+{
+    const uint8_t* buffer = static_cast<const uint8_t*>(data);
+    if (length >= PclmulMinLength)
+    {
+        size_t blocksLength = length & ~static_cast<size_t>(15);
+        previousCrc32 = ~crc32_pclmul_blocks(buffer, blocksLength, ~previousCrc32);
+        buffer += blocksLength;
+        length -= blocksLength;
+    }
+    return crc32_16bytes(buffer, length, previousCrc32);
+}
+
+#else
+
+bool crc32_pclmul_supported()
+{
+    return false;
+}
+
+uint32_t crc32_pclmul(const void* data, size_t length, uint32_t previousCrc32)
+{
+    return crc32_16bytes_prefetch(data, length, previousCrc32);
+}
+
+#endif
+
+// GF(2) polynomial arithmetic modulo CRC polynomial, same as zlib's crc32_combine()
+static uint32_t multModP(uint32_t a, uint32_t b)
+{
+    uint32_t m = 1u << 31;
+    uint32_t p = 0;
+    for (;;)
+    {
+        if (a & m)
+        {
+            p ^= b;
+            if ((a & (m - 1)) == 0)
+                break;
+        }
+        m >>= 1;
+        b = (b & 1) ? (b >> 1) ^ Polynomial : b >> 1;
+    }
+    return p;
+}
+
+struct PowersTable
+{
+    uint32_t x2n[32];
+
+    PowersTable()
+    {
+        // x^(2^n) mod p, starting with x^1
+        uint32_t p = 1u << 30;
+        x2n[0] = p;
+        for (int n = 1; n < 32; n++)
+            x2n[n] = p = multModP(p, p);
+    }
+};
+
+uint32_t crc32_combine_parts(uint32_t crc1, uint32_t crc2, size_t length2)
+{
+    static const PowersTable powers;
+    // multiply crc1 by x^(8 * length2)
+    uint32_t p = 1u << 31;
+    unsigned int k = 3;
+    while (length2)
+    {
+        if (length2 & 1)
+            p = multModP(powers.x2n[k & 31], p);
+        length2 >>= 1;
+        k++;
+    }
+    return multModP(p, crc1) ^ crc2;
+}
+
+uint32_t crc32_hw(const void* data, size_t length, uint32_t previousCrc32)
+{
+    if (crc32_pclmul_supported())
+        return crc32_pclmul(data, length, previousCrc32);
+    return crc32_16bytes_prefetch(data, length, previousCrc32);
+}
+
+uint32_t crc32_parallel(const void* data, size_t length, uint32_t previousCrc32)
+{
+    int threads = omp_get_max_threads();
+    if (length < ParallelMinLength || threads < 2 || omp_in_parallel())
+        return crc32_hw(data, length, previousCrc32);
+
+    int parts = static_cast<int>(std::min(static_cast<size_t>(threads), length / ParallelMinPartLength));
+    size_t partLength = ((length / parts) + 63) & ~static_cast<size_t>(63);
+    parts = static_cast<int>((length + partLength - 1) / partLength);
+    std::vector<uint32_t> crcs(parts);
+    const uint8_t* buffer = static_cast<const uint8_t*>(data);
+
+    #pragma omp parallel for
+    for (int i = 0; i < parts; i++)
+    {
+        size_t offset = i * partLength;
+        size_t size = std::min(partLength, length - offset);
+        crcs[i] = crc32_hw(buffer + offset, size, i == 0 ? previousCrc32 : 0);
+    }
+
+    uint32_t crc = crcs[0];
+    for (int i = 1; i < parts; i++)
+    {
+        size_t offset = i * partLength;
+        crc = crc32_combine_parts(crc, crcs[i], std::min(partLength, length - offset));
+    }
+    return crc;
+}
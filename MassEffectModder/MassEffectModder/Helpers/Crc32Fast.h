@@ -0,0 +1,41 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#ifndef CRC32_FAST_H
+#define CRC32_FAST_H
+
+#include <Helpers/Crc32.h>
+
+// All functions compute zlib's CRC32, results are identical to crc32_16bytes_prefetch()
+
+/// true if CPU supports carry-less multiplication used by crc32_pclmul()
+bool crc32_pclmul_supported();
+/// compute CRC32 by folding 64 bytes blocks with PCLMULQDQ, requires crc32_pclmul_supported()
+uint32_t crc32_pclmul(const void* data, size_t length, uint32_t previousCrc32 = 0);
+/// compute CRC32 of concatenated data from CRC32 of both parts and length of second part
+uint32_t crc32_combine_parts(uint32_t crc1, uint32_t crc2, size_t length2);
+/// compute CRC32 using fastest algorithm supported by CPU
+uint32_t crc32_hw(const void* data, size_t length, uint32_t previousCrc32 = 0);
+/// compute CRC32 of large buffer split across OpenMP threads
+uint32_t crc32_parallel(const void* data, size_t length, uint32_t previousCrc32 = 0);
+
+#endif
@@ -20,6 +20,13 @@
  */
 
 #include "FileStream.h"
+#include "MemoryStream.h"
+
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
 
 void FileStream::CheckFileIOErrorStatus()
 {
@@ -88,6 +95,78 @@ void FileStream::Close()
     file->close();
 }
 
+// Copy between files inside kernel, returns amount of bytes copied.
+// Partial copy is possible, rest is left to regular copy path.
+qint64 FileStream::CopyFromFileKernel(FileStream &source, qint64 count)
+{
+#if defined(__linux__)
+    file->flush();
+    source.file->flush();
+    int inFd = source.file->handle();
+    int outFd = file->handle();
+    if (inFd == -1 || outFd == -1)
+        return 0;
+
+    qint64 inStart = source.file->pos();
+    qint64 outStart = file->pos();
+    loff_t inOffset = inStart;
+    loff_t outOffset = outStart;
+    bool useSendfile = false;
+    qint64 copied = 0;
+
+#ifdef GUI
+    QElapsedTimer timer;
+    timer.start();
+#endif
+    while (copied < count)
+    {
+#ifdef GUI
+        if (timer.elapsed() > 100)
+        {
+            QApplication::processEvents();
+            timer.restart();
+        }
+#endif
+        auto size = static_cast<size_t>(qMin(count - copied, static_cast<qint64>(CopyBufferSize) * 64));
+        ssize_t done;
+        if (!useSendfile)
+        {
+            done = copy_file_range(inFd, &inOffset, outFd, &outOffset, size, 0);
+            if (done == -1 && (errno == ENOSYS || errno == EXDEV ||
+                               errno == EINVAL || errno == EOPNOTSUPP))
+            {
+                useSendfile = true;
+                continue;
+            }
+        }
+        else
+        {
+            if (lseek(outFd, outOffset, SEEK_SET) == -1)
+                break;
+            done = sendfile(outFd, inFd, &inOffset, size);
+            if (done > 0)
+                outOffset += done;
+        }
+        if (done == -1 && errno == EINTR)
+            continue;
+        if (done <= 0)
+            break;
+        copied += done;
+    }
+
+    source.file->seek(inStart + copied);
+    source.CheckFileIOErrorStatus();
+    file->seek(outStart + copied);
+    CheckFileIOErrorStatus();
+
+    return copied;
+#else
+    Q_UNUSED(source);
+    Q_UNUSED(count);
+    return 0;
+#endif
+}
+
 void FileStream::CopyFrom(Stream &stream, qint64 count, qint64 bufferSize)
 {
     if (count == 0)
@@ -96,11 +175,39 @@ void FileStream::CopyFrom(Stream &stream, qint64 count, qint64 bufferSize)
     if (count < 0)
         CRASH();
 
+    auto fileStream = dynamic_cast<FileStream *>(&stream);
+    if (fileStream && fileStream != this)
+    {
+        count -= CopyFromFileKernel(*fileStream, count);
+        if (count == 0)
+            return;
+    }
+
 #ifdef GUI
     QElapsedTimer timer;
     timer.start();
 #endif
-    std::unique_ptr<quint8[]> buffer (new quint8[static_cast<unsigned long>(bufferSize)]);
+    auto memoryStream = dynamic_cast<MemoryStream *>(&stream);
+    if (memoryStream)
+    {
+        // Write directly from source memory
+        do
+        {
+#ifdef GUI
+            if (timer.elapsed() > 100)
+            {
+                QApplication::processEvents();
+                timer.restart();
+            }
+#endif
+            ByteSpan span = memoryStream->ReadSpan(qMin(bufferSize, count));
+            WriteFromBuffer(const_cast<quint8 *>(span.ptr()), span.size());
+            count -= span.size();
+        } while (count != 0);
+        return;
+    }
+
+    std::unique_ptr<quint8[]> buffer (new quint8[static_cast<unsigned long>(qMin(bufferSize, count))]);
     do
     {
 #ifdef GUI
@@ -46,6 +46,7 @@ private:
     QFile *file;
 
     void CheckFileIOErrorStatus();
+    qint64 CopyFromFileKernel(FileStream &source, qint64 count);
 
 public:
 
@@ -61,7 +62,7 @@ public:
     void Flush() override;
     void Close() override;
 
-    void CopyFrom(Stream &stream, qint64 count, qint64 bufferSize = 10000) override;
+    void CopyFrom(Stream &stream, qint64 count, qint64 bufferSize = CopyBufferSize) override;
     void ReadToBuffer(quint8 *buffer, qint64 count) override;
     ByteBuffer ReadToBuffer(qint64 count) override;
     ByteBuffer ReadAllToBuffer();
@@ -0,0 +1,301 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <Helpers/IpcChannel.h>
+#include <Helpers/MiscHelpers.h>
+#include <Helpers/Logs.h>
+
+#include <QtEndian>
+
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+static const char *ipcEventNames[] =
+{
+    "AMOUNT_MEMORY_GB",
+    "CACHE_LIMIT",
+    "CACHE_USAGE",
+    "ERROR",
+    "ERROR_ADDED_FILE",
+    "ERROR_FILEMARKER_FOUND",
+    "ERROR_FILE_NOT_COMPATIBLE",
+    "ERROR_NO_BUILDABLE_FILES",
+    "ERROR_REFERENCED_TFC_NOT_FOUND",
+    "ERROR_REMOVED_FILE",
+    "ERROR_TEXTURE_MAP_MISSING",
+    "ERROR_TEXTURE_MAP_WRONG",
+    "ERROR_TEXTURE_SCAN_DIAGNOSTIC",
+    "ERROR_VANILLA_MOD_FILE",
+    "EXCEPTION_OCCURRED",
+    "GAMEPATH",
+    "LODLINE",
+    "MOD",
+    "MOD_OVERRIDE",
+    "PROCESSING_FILE",
+    "STAGE_ADD",
+    "STAGE_CONTEXT",
+    "STAGE_TIMING",
+    "STAGE_WEIGHT",
+    "TASK_PROGRESS",
+    "VERSION",
+};
+static_assert(sizeof(ipcEventNames) / sizeof(ipcEventNames[0]) == static_cast<size_t>(IpcEvent::Count),
+              "IPC event names do not match IpcEvent");
+
+std::mutex IpcChannel::lock;
+std::mutex IpcChannel::writeLock;
+std::condition_variable IpcChannel::wakeup;
+std::thread IpcChannel::emitterThread;
+bool IpcChannel::emitterExit = false;
+QStringList IpcChannel::queue;
+int IpcChannel::pendingProgress = -1;
+qint64 IpcChannel::lastProgressTime = 0;
+int IpcChannel::socketHandle = -1;
+int IpcChannel::progressIntervalMs = 100;
+QString IpcChannel::socketPath;
+
+QString IpcChannel::Format(IpcEvent event, const QString &data)
+{
+    QString message = ipcEventNames[static_cast<int>(event)];
+    if (data.length() != 0)
+        message += " " + data;
+    return message;
+}
+
+bool IpcChannel::Start()
+{
+    if (emitterThread.joinable())
+        return true;
+
+    if (socketPath.length() != 0)
+    {
+#if defined(_WIN32)
+        PERROR("IPC socket transport is not supported on this platform, using console.\n");
+#else
+        QByteArray path = socketPath.toUtf8();
+        struct sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (path.size() >= static_cast<int>(sizeof(address.sun_path)))
+        {
+            PERROR(QString("IPC socket path is too long: ") + socketPath + "\n");
+            return false;
+        }
+        memcpy(address.sun_path, path.constData(), path.size());
+        socketHandle = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (socketHandle == -1 ||
+            ::connect(socketHandle, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) != 0)
+        {
+            PERROR(QString("Failed to connect IPC socket: ") + socketPath + "\n");
+            if (socketHandle != -1)
+                close(socketHandle);
+            socketHandle = -1;
+            return false;
+        }
+#if defined(__APPLE__)
+        int noSigPipe = 1;
+        setsockopt(socketHandle, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+#endif
+    }
+
+    emitterExit = false;
+    emitterThread = std::thread(&IpcChannel::EmitterLoop);
+    return true;
+}
+
+void IpcChannel::Stop(bool crashed)
+{
+    if (!emitterThread.joinable())
+        return;
+
+    if (crashed)
+    {
+        // Emitter may be the crashed thread or hold the lock, never join it here,
+        // only make sure exit() does not terminate on a joinable thread
+        Flush(true);
+        if (lock.try_lock())
+        {
+            emitterExit = true;
+            lock.unlock();
+            wakeup.notify_one();
+        }
+        emitterThread.detach();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        emitterExit = true;
+    }
+    wakeup.notify_one();
+    emitterThread.join();
+
+#if !defined(_WIN32)
+    if (socketHandle != -1)
+    {
+        close(socketHandle);
+        socketHandle = -1;
+    }
+#endif
+}
+
+void IpcChannel::Send(IpcEvent event, const QString &data)
+{
+    if (!emitterThread.joinable())
+    {
+        ConsoleWrite("[IPC]" + Format(event, data));
+        ConsoleSync();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        QueueProgress();
+        queue.append(Format(event, data));
+    }
+    wakeup.notify_one();
+}
+
+void IpcChannel::Progress(int progress)
+{
+    if (!emitterThread.joinable() || progressIntervalMs <= 0)
+    {
+        Send(IpcEvent::TaskProgress, QString::number(progress));
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    pendingProgress = progress;
+}
+
+// Must be called with lock held
+void IpcChannel::QueueProgress()
+{
+    if (pendingProgress == -1)
+        return;
+
+    queue.append(Format(IpcEvent::TaskProgress, QString::number(pendingProgress)));
+    pendingProgress = -1;
+    lastProgressTime = QDateTime::currentMSecsSinceEpoch();
+}
+
+void IpcChannel::Write(const QStringList &messages)
+{
+    if (messages.count() == 0)
+        return;
+
+#if !defined(_WIN32)
+    if (socketHandle != -1)
+    {
+        // Binary framing: 32-bit little endian length followed by UTF-8 message
+        QByteArray frames;
+        for (const auto &message : messages)
+        {
+            QByteArray payload = message.toUtf8();
+            quint32 length = qToLittleEndian<quint32>(payload.size());
+            frames.append(reinterpret_cast<const char *>(&length), sizeof(length));
+            frames.append(payload);
+        }
+        qint64 offset = 0;
+        while (offset < frames.size())
+        {
+#if defined(MSG_NOSIGNAL)
+            ssize_t written = send(socketHandle, frames.constData() + offset, frames.size() - offset, MSG_NOSIGNAL);
+#else
+            ssize_t written = send(socketHandle, frames.constData() + offset, frames.size() - offset, 0);
+#endif
+            if (written <= 0)
+            {
+                close(socketHandle);
+                socketHandle = -1;
+                PERROR("IPC socket connection lost, using console.\n");
+                break;
+            }
+            offset += written;
+        }
+        if (socketHandle != -1)
+            return;
+    }
+#endif
+
+    ConsoleWrite("[IPC]" + messages.join("\n[IPC]"));
+    ConsoleSync();
+}
+
+void IpcChannel::WriteQueued(bool force)
+{
+    QStringList messages;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        qint64 now = QDateTime::currentMSecsSinceEpoch();
+        if (force || emitterExit || now - lastProgressTime >= progressIntervalMs)
+            QueueProgress();
+        messages.swap(queue);
+    }
+    Write(messages);
+}
+
+void IpcChannel::EmitterLoop()
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            if (queue.count() == 0 && !emitterExit)
+                wakeup.wait_for(guard, std::chrono::milliseconds(qMax(progressIntervalMs, 10)));
+        }
+
+        std::lock_guard<std::mutex> guard(writeLock);
+        WriteQueued(false);
+
+        std::lock_guard<std::mutex> guardQueue(lock);
+        if (emitterExit && queue.count() == 0 && pendingProgress == -1)
+            break;
+    }
+}
+
+void IpcChannel::Flush(bool crashed)
+{
+    if (!emitterThread.joinable())
+        return;
+
+    if (!crashed)
+    {
+        std::lock_guard<std::mutex> guard(writeLock);
+        WriteQueued(true);
+        return;
+    }
+
+    // Emitter may be the crashed thread, do not wait for it forever
+    for (int retry = 0; retry < 100; retry++)
+    {
+        if (writeLock.try_lock())
+        {
+            WriteQueued(true);
+            writeLock.unlock();
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
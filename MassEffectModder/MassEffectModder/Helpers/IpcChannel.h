@@ -0,0 +1,91 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef IPC_CHANNEL_H
+#define IPC_CHANNEL_H
+
+#include <thread>
+#include <condition_variable>
+
+enum class IpcEvent
+{
+    AmountMemoryGB,
+    CacheLimit,
+    CacheUsage,
+    Error,
+    ErrorAddedFile,
+    ErrorFileMarkerFound,
+    ErrorFileNotCompatible,
+    ErrorNoBuildableFiles,
+    ErrorReferencedTfcNotFound,
+    ErrorRemovedFile,
+    ErrorTextureMapMissing,
+    ErrorTextureMapWrong,
+    ErrorTextureScanDiagnostic,
+    ErrorVanillaModFile,
+    ExceptionOccurred,
+    GamePath,
+    LodLine,
+    Mod,
+    ModOverride,
+    ProcessingFile,
+    StageAdd,
+    StageContext,
+    StageTiming,
+    StageWeight,
+    TaskProgress,
+    Version,
+    Count
+};
+
+class IpcChannel
+{
+private:
+
+    static std::mutex lock;
+    static std::mutex writeLock;
+    static std::condition_variable wakeup;
+    static std::thread emitterThread;
+    static bool emitterExit;
+    static QStringList queue;
+    static int pendingProgress;
+    static qint64 lastProgressTime;
+    static int socketHandle;
+
+    static QString Format(IpcEvent event, const QString &data);
+    static void QueueProgress();
+    static void Write(const QStringList &messages);
+    static void WriteQueued(bool force);
+    static void EmitterLoop();
+
+public:
+
+    static int progressIntervalMs;
+    static QString socketPath;
+
+    static bool Start();
+    static void Stop(bool crashed = false);
+    static void Send(IpcEvent event, const QString &data = QString());
+    static void Progress(int progress);
+    static void Flush(bool crashed = false);
+};
+
+#endif
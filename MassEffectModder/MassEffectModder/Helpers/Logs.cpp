@@ -32,9 +32,20 @@ Logs::Logs() :
         timeStampEnabled(false),
         consoleEnabled(false),
         fileEnabled(false),
-        errorBufferEnabled(false)
+        errorBufferEnabled(false),
+        logFile(nullptr),
+        queueHead(&queueStub),
+        queueTail(&queueStub),
+        queuePending(0),
+        writerExit(false)
 {
     startedTimestamp = QDateTime::currentMSecsSinceEpoch();
+    queueStub.next = nullptr;
+}
+
+Logs::~Logs()
+{
+    StopWriter();
 }
 
 void Logs::ChangeLogLevel(LOG_LEVEL level)
@@ -59,6 +70,8 @@ void Logs::EnableOutputConsole(bool enable)
 
 void Logs::EnableOutputFile(const QString &path, bool enable)
 {
+    StopWriter();
+
     logPath = path;
     if (!enable)
     {
@@ -74,8 +87,16 @@ void Logs::EnableOutputFile(const QString &path, bool enable)
 #if defined(_WIN32)
         unsigned char bom[] = { 0xFF, 0xFE };
         fwrite(bom, 1, sizeof(bom), file);
-#endif
         fclose(file);
+        file = _wfopen(logPath.toStdWString().c_str(), L"a");
+        if (file == nullptr)
+            return;
+#define _O_U16TEXT  0x20000
+        _setmode(_fileno(file), _O_U16TEXT);
+#endif
+        logFile = file;
+        writerExit = false;
+        writerThread = std::thread(&Logs::WriterLoop, this);
         fileEnabled = enable;
     }
 }
@@ -90,6 +111,115 @@ void Logs::BufferEnableErrors(bool enable)
     errorBufferEnabled = enable;
 }
 
+// Intrusive multi-producer single-consumer queue, producers never block
+void Logs::Enqueue(LogEntry *entry)
+{
+    entry->next.store(nullptr, std::memory_order_relaxed);
+    LogEntry *prev = queueHead.exchange(entry, std::memory_order_acq_rel);
+    prev->next.store(entry, std::memory_order_release);
+}
+
+Logs::LogEntry *Logs::Dequeue()
+{
+    LogEntry *tail = queueTail;
+    LogEntry *next = tail->next.load(std::memory_order_acquire);
+    if (tail == &queueStub)
+    {
+        if (next == nullptr)
+            return nullptr;
+        queueTail = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if (next)
+    {
+        queueTail = next;
+        return tail;
+    }
+    if (tail != queueHead.load(std::memory_order_acquire))
+        return nullptr;
+    Enqueue(&queueStub);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next)
+    {
+        queueTail = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+// Must be called with writerLock held
+void Logs::WriteQueued()
+{
+    QString batch;
+    LogEntry *entry;
+    while ((entry = Dequeue()) != nullptr)
+    {
+        batch += entry->message;
+        delete entry;
+    }
+    queuePending = 0;
+    if (batch.isEmpty() || logFile == nullptr)
+        return;
+
+#if defined(_WIN32)
+    std::fputws(batch.toStdWString().c_str(), logFile);
+#else
+    QByteArray data = batch.toUtf8();
+    std::fwrite(data.constData(), 1, data.size(), logFile);
+#endif
+    std::fflush(logFile);
+}
+
+void Logs::WriterLoop()
+{
+    std::unique_lock<std::mutex> guard(writerLock);
+    while (!writerExit)
+    {
+        writerWakeup.wait_for(guard, std::chrono::milliseconds(LOG_FLUSH_INTERVAL_MS));
+        WriteQueued();
+    }
+    WriteQueued();
+}
+
+void Logs::StopWriter()
+{
+    if (!writerThread.joinable())
+        return;
+
+    fileEnabled = false;
+    writerExit = true;
+    writerWakeup.notify_one();
+    writerThread.join();
+    fclose(logFile);
+    logFile = nullptr;
+}
+
+void Logs::Flush(bool crashed)
+{
+    if (!writerThread.joinable())
+        return;
+
+    if (!crashed)
+    {
+        std::lock_guard<std::mutex> guard(writerLock);
+        WriteQueued();
+        return;
+    }
+
+    // Writer may be the crashed thread, do not wait for it forever
+    for (int retry = 0; retry < 100; retry++)
+    {
+        if (writerLock.try_lock())
+        {
+            WriteQueued();
+            writerLock.unlock();
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
 void Logs::Print(int level, const QString &message, int flags)
 {
     if (logLevel < level)
@@ -98,14 +228,29 @@ void Logs::Print(int level, const QString &message, int flags)
     qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
     QString timestampStr;
 
+    if (timeStampEnabled)
+        timestampStr = QString("[") + (startedTimestamp - timestamp) + "] ";
+
+    if (fileEnabled && (flags & LOG_FILE))
+    {
+        auto *entry = new LogEntry;
+        entry->message = timestampStr + message;
+        Enqueue(entry);
+        if (++queuePending >= LOG_FLUSH_BATCH || level <= LOG_ERROR)
+            writerWakeup.notify_one();
+    }
+
+    if (!(errorBufferEnabled && (flags & LOG_ERROR_BUFFER) && level == LOG_ERROR) &&
+        !(consoleEnabled && (flags & LOG_CONSOLE)))
+    {
+        return;
+    }
+
     lock.lock();
 
     if (errorBufferEnabled && (flags & LOG_ERROR_BUFFER) && level == LOG_ERROR)
         errorsString += message;
 
-    if (timeStampEnabled)
-        timestampStr = QString("[") + (startedTimestamp - timestamp) + "] ";
-
     if (consoleEnabled && (flags & LOG_CONSOLE))
     {
 #if defined(_WIN32)
@@ -115,32 +260,13 @@ void Logs::Print(int level, const QString &message, int flags)
 #endif
     }
 
-    if (fileEnabled && (flags & LOG_FILE))
-    {
-#if defined(_WIN32)
-        FILE *file = _wfopen(logPath.toStdWString().c_str(), L"a");
-#else
-        FILE *file = fopen(logPath.toUtf8().data(), "a");
-#endif
-        if (file)
-        {
-#if defined(_WIN32)
-#define _O_U16TEXT  0x20000
-            _setmode(_fileno(file), _O_U16TEXT);
-            std::fputws((timestampStr + message).toStdWString().c_str(), file);
-#else
-            std::fputs((timestampStr + message).toUtf8().data(), file);
-#endif
-            fclose(file);
-        }
-    }
-
     lock.unlock();
 }
 
 void Logs::PrintCrash(const std::string &message)
 {
     Print(LOG_NONE, QString(message.c_str()), LOG_ALL_OUTPUTS);
+    Flush(true);
 }
 
 void Logs::PrintError(const QString &message)
@@ -22,6 +22,9 @@
 #ifndef LOGS_H
 #define LOGS_H
 
+#include <thread>
+#include <condition_variable>
+
 enum LOG_LEVEL {
     LOG_NONE,
     LOG_ERROR,
@@ -35,10 +38,19 @@ enum LOG_LEVEL {
 #define LOG_ERROR_BUFFER  0x04
 #define LOG_ALL_OUTPUTS   (LOG_CONSOLE | LOG_FILE | LOG_ERROR_BUFFER)
 
+#define LOG_FLUSH_INTERVAL_MS  100
+#define LOG_FLUSH_BATCH        512
+
 class Logs
 {
 private:
 
+    struct LogEntry
+    {
+        std::atomic<LogEntry *> next;
+        QString message;
+    };
+
     std::mutex      lock;
     qint64          startedTimestamp;
     int             logLevel;
@@ -47,20 +59,37 @@ private:
 
     bool            timeStampEnabled;
     bool            consoleEnabled;
-    bool            fileEnabled;
+    std::atomic<bool> fileEnabled;
     bool            errorBufferEnabled;
 
+    FILE                    *logFile;
+    std::atomic<LogEntry *> queueHead;
+    LogEntry                *queueTail;
+    LogEntry                queueStub;
+    std::atomic<int>        queuePending;
+    std::mutex              writerLock;
+    std::condition_variable writerWakeup;
+    std::thread             writerThread;
+    std::atomic<bool>       writerExit;
+
     void Print(int level, const QString &message, int flags);
+    void Enqueue(LogEntry *entry);
+    LogEntry *Dequeue();
+    void WriteQueued();
+    void WriterLoop();
+    void StopWriter();
 
 public:
 
     Logs();
+    ~Logs();
     void PrintCrash(const std::string &message);
 
     void PrintInfo(const QString &message);
     void PrintError(const QString &message);
     void PrintDebug(const QString &message);
 
+    bool IsLevelEnabled(int level) { return logLevel >= level; }
     void ChangeLogLevel(LOG_LEVEL level);
     void BufferClearErrors();
     QString BufferGetErrors();
@@ -68,6 +97,7 @@ public:
     void EnableOutputConsole(bool enable);
     void EnableOutputFile(const QString &path, bool enable);
     void EnableTimeStamp(bool enable);
+    void Flush(bool crashed = false);
     QString GetLogPath() { return logPath; }
 };
 
@@ -76,8 +106,8 @@ extern Logs *g_logs;
 bool CreateLogs();
 void ReleaseLogs();
 
-#define PINFO g_logs->PrintInfo
-#define PERROR g_logs->PrintError
-#define PDEBUG g_logs->PrintDebug
+#define PINFO(...) do { if (g_logs->IsLevelEnabled(LOG_INFO)) g_logs->PrintInfo(__VA_ARGS__); } while (0)
+#define PERROR(...) do { if (g_logs->IsLevelEnabled(LOG_ERROR)) g_logs->PrintError(__VA_ARGS__); } while (0)
+#define PDEBUG(...) do { if (g_logs->IsLevelEnabled(LOG_DEBUG)) g_logs->PrintDebug(__VA_ARGS__); } while (0)
 
 #endif
@@ -43,22 +43,28 @@ MemoryStream::MemoryStream(const ByteBuffer &buffer)
     }
     internalBufferSize = length = buffer.size();
     memcpy(internalBuffer, buffer.ptr(), length);
+    ByteBuffer::CountCopy(length);
     position = 0;
 }
 
 MemoryStream::MemoryStream(const ByteBuffer &buffer, qint64 offset)
 {
-    internalBuffer = static_cast<quint8 *>(std::malloc(static_cast<size_t>(buffer.size())));
+    if (offset > buffer.size())
+    {
+        CRASH_MSG("MemoryStream: out of range.");
+    }
+    internalBuffer = static_cast<quint8 *>(std::malloc(static_cast<size_t>(buffer.size() - offset)));
     if (internalBuffer == nullptr)
     {
         CRASH_MSG("MemoryStream: out of memory.");
     }
-    internalBufferSize = length = buffer.size();
+    internalBufferSize = length = buffer.size() - offset;
     memcpy(internalBuffer, buffer.ptr() + offset, length);
+    ByteBuffer::CountCopy(length);
     position = 0;
 }
 
-MemoryStream::MemoryStream(const ByteBuffer &buffer, qint64 offset, qint64 count)
+MemoryStream::MemoryStream(const ByteSpan &buffer, qint64 offset, qint64 count)
 {
     internalBuffer = static_cast<quint8 *>(std::malloc(static_cast<size_t>(count)));
     if (internalBuffer == nullptr )
@@ -71,6 +77,7 @@ MemoryStream::MemoryStream(const ByteBuffer &buffer, qint64 offset, qint64 count
     }
     internalBufferSize = length = count;
     memcpy(internalBuffer, buffer.ptr() + offset, length);
+    ByteBuffer::CountCopy(length);
     position = 0;
 }
 
@@ -143,9 +150,23 @@ MemoryStream::MemoryStream(QString &filename)
     position = 0;
 }
 
+MemoryStream::MemoryStream(const quint8 *buffer, qint64 count)
+{
+    internalBuffer = const_cast<quint8 *>(buffer);
+    internalBufferSize = length = count;
+    position = 0;
+    ownBuffer = false;
+}
+
+MemoryStream::MemoryStream(const ByteSpan &span)
+    : MemoryStream(span.ptr(), span.size())
+{
+}
+
 MemoryStream::~MemoryStream()
 {
-    std::free(internalBuffer);
+    if (ownBuffer)
+        std::free(internalBuffer);
 }
 
 ByteBuffer MemoryStream::ToArray()
@@ -163,7 +184,22 @@ void MemoryStream::CopyFrom(Stream &stream, qint64 count, qint64 bufferSize)
     if (count < 0)
         CRASH();
 
-    std::unique_ptr<quint8[]> buffer (new quint8[static_cast<unsigned long>(bufferSize)]);
+    auto memoryStream = dynamic_cast<MemoryStream *>(&stream);
+    if (memoryStream && memoryStream != this)
+    {
+        WriteFromBuffer(memoryStream->ReadSpan(count));
+        return;
+    }
+
+    // Read straight into own buffer, no bounce buffer needed
+    if (memoryStream == nullptr)
+    {
+        stream.ReadToBuffer(PrepareWrite(count), count);
+        return;
+    }
+
+    // Copy within same stream, source can move on buffer grow
+    std::unique_ptr<quint8[]> buffer (new quint8[static_cast<unsigned long>(qMin(bufferSize, count))]);
     do
     {
         qint64 size = qMin(bufferSize, count);
@@ -184,6 +220,18 @@ void MemoryStream::ReadToBuffer(quint8 *buffer, qint64 count)
     position += count;
 }
 
+ByteSpan MemoryStream::ReadSpan(qint64 count)
+{
+    if (position + count > length)
+    {
+        CRASH_MSG("MemoryStream::ReadSpan() - Error: read out of buffer.");
+    }
+
+    ByteSpan span(internalBuffer + position, count);
+    position += count;
+    return span;
+}
+
 ByteBuffer MemoryStream::ReadToBuffer(qint64 count)
 {
     ByteBuffer buffer(count);
@@ -191,8 +239,12 @@ ByteBuffer MemoryStream::ReadToBuffer(qint64 count)
     return buffer;
 }
 
-void MemoryStream::WriteFromBuffer(quint8 *buffer, qint64 count)
+quint8 *MemoryStream::PrepareWrite(qint64 count)
 {
+    if (!ownBuffer)
+    {
+        CRASH_MSG("MemoryStream: write to read-only view.");
+    }
     qint64 newPosition = position + count;
     if (newPosition > internalBufferSize)
     {
@@ -206,8 +258,14 @@ void MemoryStream::WriteFromBuffer(quint8 *buffer, qint64 count)
     }
     if (newPosition > length)
         length = newPosition;
-    memcpy(internalBuffer + position, buffer, static_cast<size_t>(count));
-    position += count;
+    quint8 *ptr = internalBuffer + position;
+    position = newPosition;
+    return ptr;
+}
+
+void MemoryStream::WriteFromBuffer(quint8 *buffer, qint64 count)
+{
+    memcpy(PrepareWrite(count), buffer, static_cast<size_t>(count));
 }
 
 void MemoryStream::WriteFromBuffer(const ByteBuffer &buffer)
@@ -215,6 +273,11 @@ void MemoryStream::WriteFromBuffer(const ByteBuffer &buffer)
     WriteFromBuffer(buffer.ptr(), buffer.size());
 }
 
+void MemoryStream::WriteFromBuffer(const ByteSpan &span)
+{
+    WriteFromBuffer(const_cast<quint8 *>(span.ptr()), span.size());
+}
+
 void MemoryStream::ReadStringASCII(QString &str, qint64 count)
 {
     std::unique_ptr<char[]> buffer (new char[static_cast<size_t>(count) + 1]);
@@ -38,16 +38,22 @@ private:
     qint64 position;
     quint8 *internalBuffer;
     qint64 internalBufferSize;
+    bool ownBuffer = true;
+
+    quint8 *PrepareWrite(qint64 count);
 
 public:
 
     MemoryStream();
     MemoryStream(const ByteBuffer &buffer);
     MemoryStream(const ByteBuffer &buffer, qint64 offset);
-    MemoryStream(const ByteBuffer &buffer, qint64 offset, qint64 count);
+    MemoryStream(const ByteSpan &buffer, qint64 offset, qint64 count);
     MemoryStream(QString &filename, qint64 offset, qint64 count);
     MemoryStream(QString &filename, qint64 count);
     MemoryStream(QString &filename);
+    // Read-only view, buffer is not copied and must outlive the stream
+    MemoryStream(const quint8 *buffer, qint64 count);
+    explicit MemoryStream(const ByteSpan &span);
     ~MemoryStream() override;
 
     qint64 Length() override { return length; }
@@ -57,11 +63,14 @@ public:
     void Close() override {}
     ByteBuffer ToArray();
 
-    void CopyFrom(Stream &stream, qint64 count, qint64 bufferSize = 10000) override;
+    void CopyFrom(Stream &stream, qint64 count, qint64 bufferSize = CopyBufferSize) override;
     void ReadToBuffer(quint8 *buffer, qint64 count) override;
     ByteBuffer ReadToBuffer(qint64 count) override;
     void WriteFromBuffer(quint8 *buffer, qint64 count) override;
     void WriteFromBuffer(const ByteBuffer &buffer) override;
+    void WriteFromBuffer(const ByteSpan &span);
+    // View of next count bytes, advances position without copying
+    ByteSpan ReadSpan(qint64 count);
     void ReadStringASCII(QString &str, qint64 count) override;
     void ReadStringASCIINull(QString &str) override;
     void ReadStringUnicode16(QString &str, qint64 count) override;
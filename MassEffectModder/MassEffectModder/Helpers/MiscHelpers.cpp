@@ -23,9 +23,11 @@
 #include <windows.h>
 #elif defined(__APPLE__)
 #include <sys/sysctl.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #elif defined(__linux__)
 #include <sys/sysinfo.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #else
 #error not supported system!
@@ -58,6 +60,38 @@ int DetectAmountMemoryGB()
     return amountGB;
 }
 
+bool GetFileStat(const QString &path, qint64 &size, qint64 &mtime, quint64 &inode)
+{
+#if defined(_WIN32)
+    HANDLE handle = CreateFileW(reinterpret_cast<const wchar_t *>(QDir::toNativeSeparators(path).utf16()),
+                                0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+    BY_HANDLE_FILE_INFORMATION info;
+    bool status = GetFileInformationByHandle(handle, &info) != 0;
+    CloseHandle(handle);
+    if (!status)
+        return false;
+    size = (static_cast<qint64>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+    mtime = (static_cast<qint64>(info.ftLastWriteTime.dwHighDateTime) << 32) |
+            info.ftLastWriteTime.dwLowDateTime;
+    inode = (static_cast<quint64>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+#else
+    struct stat st{};
+    if (stat(QFile::encodeName(path).constData(), &st) != 0)
+        return false;
+    size = st.st_size;
+#if defined(__APPLE__)
+    mtime = static_cast<qint64>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    mtime = static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+    inode = st.st_ino;
+#endif
+    return true;
+}
+
 #define MAX_MSG_SIZE 4000
 
 void ConsoleWrite(const QString &message)
@@ -25,6 +25,7 @@
 #include <Types/MemTypes.h>
 
 int DetectAmountMemoryGB();
+bool GetFileStat(const QString &path, qint64 &size, qint64 &mtime, quint64 &inode);
 void ConsoleWrite(const QString &message);
 void ConsoleSync();
 QString BaseName(const QString &path);
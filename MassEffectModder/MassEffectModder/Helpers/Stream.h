@@ -41,6 +41,11 @@ protected:
 
 public:
 
+    enum
+    {
+        CopyBufferSize = 0x100000,
+    };
+
     virtual ~Stream() = 0;
 
     virtual qint64 Length()  = 0;
@@ -49,7 +54,7 @@ public:
     virtual void Flush() = 0;
     virtual void Close() = 0;
 
-    virtual void CopyFrom(Stream &stream, qint64 count, qint64 bufferSize = 10000) = 0;
+    virtual void CopyFrom(Stream &stream, qint64 count, qint64 bufferSize = CopyBufferSize) = 0;
     virtual void ReadToBuffer(quint8 *buffer, qint64 count) = 0;
     virtual ByteBuffer ReadToBuffer(qint64 count) = 0;
     virtual void WriteFromBuffer(quint8 *buffer, qint64 count) = 0;
@@ -28,7 +28,7 @@
 
 Image::Image(int width, int height)
 {
-    ByteBuffer pixels(width * height * 4 * sizeof(float));
+    UniqueByteBuffer pixels(width * height * 4 * sizeof(float));
     float *ptr = pixels.ptrAsFloat();
     int offset = 0;
     for (int h = 0; h < height; h++)
@@ -44,8 +44,7 @@ Image::Image(int width, int height)
     }
 
     pixelFormat = PixelFormat::Internal;
-    mipMaps.push_back(new MipMap(pixels, width, height, PixelFormat::Internal));
-    pixels.Free();
+    mipMaps.push_back(new MipMap(std::move(pixels), width, height, PixelFormat::Internal));
 }
 
 Image::Image(const QString &fileName, ImageFormat format)
@@ -299,10 +298,9 @@ void Image::LoadImageFromBuffer(ByteBuffer data, ImageFormat format, bool &sourc
         return;
     }
 
-    ByteBuffer pixels((quint8 *)imageBuffer, imageSize);
+    UniqueByteBuffer pixels((quint8 *)imageBuffer, imageSize);
     delete[] imageBuffer;
-    mipMaps.push_back(new MipMap(pixels, imageWidth, imageHeight, PixelFormat::Internal));
-    pixels.Free();
+    mipMaps.push_back(new MipMap(std::move(pixels), imageWidth, imageHeight, PixelFormat::Internal));
     pixelFormat = PixelFormat::Internal;
 }
 
@@ -311,7 +309,7 @@ void Image::convertInternalToRGBE()
     if (pixelFormat != PixelFormat::Internal)
         CRASH();
     auto mipmap = mipMaps.first();
-    auto pixels = InternalToRGBE(mipmap->getRefData(), mipmap->getWidth(), mipmap->getHeight());
+    UniqueByteBuffer pixels(InternalToRGBE(mipmap->getRefData(), mipmap->getWidth(), mipmap->getHeight()));
     int width = mipmap->getWidth();
     int height = mipmap->getHeight();
     foreach(MipMap *mip, mipMaps)
@@ -320,8 +318,7 @@ void Image::convertInternalToRGBE()
         delete mip;
     }
     mipMaps.clear();
-    mipMaps.push_back(new MipMap(pixels, width, height, PixelFormat::RGBE));
-    pixels.Free();
+    mipMaps.push_back(new MipMap(std::move(pixels), width, height, PixelFormat::RGBE));
     pixelFormat = PixelFormat::RGBE;
 }
 
@@ -330,11 +327,11 @@ void Image::convertInternalToRGBA10(bool clearAlpha)
     if (pixelFormat != PixelFormat::Internal)
         CRASH();
     auto mipmap = mipMaps.first();
-    ByteBuffer pixels;
+    UniqueByteBuffer pixels;
     if (clearAlpha)
-        pixels = InternalToR10G10B10A2ClearAlpha(mipmap->getRefData(), mipmap->getWidth(), mipmap->getHeight());
+        pixels = UniqueByteBuffer(InternalToR10G10B10A2ClearAlpha(mipmap->getRefData(), mipmap->getWidth(), mipmap->getHeight()));
     else
-        pixels = InternalToR10G10B10A2(mipmap->getRefData(), mipmap->getWidth(), mipmap->getHeight());
+        pixels = UniqueByteBuffer(InternalToR10G10B10A2(mipmap->getRefData(), mipmap->getWidth(), mipmap->getHeight()));
     int width = mipmap->getWidth();
     int height = mipmap->getHeight();
     foreach(MipMap *mip, mipMaps)
@@ -343,8 +340,7 @@ void Image::convertInternalToRGBA10(bool clearAlpha)
         delete mip;
     }
     mipMaps.clear();
-    mipMaps.push_back(new MipMap(pixels, width, height, PixelFormat::R10G10B10A2));
-    pixels.Free();
+    mipMaps.push_back(new MipMap(std::move(pixels), width, height, PixelFormat::R10G10B10A2));
     pixelFormat = PixelFormat::R10G10B10A2;
 }
 
@@ -353,7 +349,7 @@ void Image::convertInternalToRGBA16()
     if (pixelFormat != PixelFormat::Internal)
         CRASH();
     auto mipmap = mipMaps.first();
-    auto pixels = InternalToR16G16B16A16(mipmap->getRefData(), mipmap->getWidth(), mipmap->getHeight());
+    UniqueByteBuffer pixels(InternalToR16G16B16A16(mipmap->getRefData(), mipmap->getWidth(), mipmap->getHeight()));
     int width = mipmap->getWidth();
     int height = mipmap->getHeight();
     foreach(MipMap *mip, mipMaps)
@@ -362,8 +358,7 @@ void Image::convertInternalToRGBA16()
         delete mip;
     }
     mipMaps.clear();
-    mipMaps.push_back(new MipMap(pixels, width, height, PixelFormat::R16G16B16A16));
-    pixels.Free();
+    mipMaps.push_back(new MipMap(std::move(pixels), width, height, PixelFormat::R16G16B16A16));
     pixelFormat = PixelFormat::R16G16B16A16;
 }
 
@@ -986,10 +981,9 @@ void Image::correctMips(PixelFormat dstFormat, bool dxt1HasAlpha, float dxt1Thre
 
     if (dstFormat != pixelFormat || (dstFormat == PixelFormat::DXT1 && !dxt1HasAlpha))
     {
-        auto top = convertToFormat(PixelFormat::Internal,
-                                   tempData, width, height, dstFormat, dxt1HasAlpha, dxt1Threshold, bc7quality);
-        mipMaps.push_back(new MipMap(top, width, height, dstFormat));
-        top.Free();
+        UniqueByteBuffer top(convertToFormat(PixelFormat::Internal,
+                                             tempData, width, height, dstFormat, dxt1HasAlpha, dxt1Threshold, bc7quality));
+        mipMaps.push_back(new MipMap(std::move(top), width, height, dstFormat));
         pixelFormat = dstFormat;
     }
     if (dstFormat == PixelFormat::RGBE)
@@ -1042,10 +1036,9 @@ void Image::correctMips(PixelFormat dstFormat, bool dxt1HasAlpha, float dxt1Thre
         auto tempDataDownscaled = downscaleInternal(tempData, prevW, prevH);
         if (pixelFormat != PixelFormat::Internal)
         {
-            auto converted = convertToFormat(PixelFormat::Internal, tempDataDownscaled, origW, origH,
-                                             pixelFormat, dxt1HasAlpha, dxt1Threshold, bc7quality);
-            mipMaps.push_back(new MipMap(converted, origW, origH, pixelFormat));
-            converted.Free();
+            UniqueByteBuffer converted(convertToFormat(PixelFormat::Internal, tempDataDownscaled, origW, origH,
+                                                       pixelFormat, dxt1HasAlpha, dxt1Threshold, bc7quality));
+            mipMaps.push_back(new MipMap(std::move(converted), origW, origH, pixelFormat));
         }
         else
         {
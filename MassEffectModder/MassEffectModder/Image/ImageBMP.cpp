@@ -112,7 +112,7 @@ void Image::LoadImageBMP(Stream &stream)
     Bshift = getShiftFromMask(Bmask);
     Ashift = getShiftFromMask(Amask);
 
-    auto buffer = ByteBuffer(imageWidth * imageHeight * 4 * sizeof(float));
+    auto buffer = UniqueByteBuffer(imageWidth * imageHeight * 4 * sizeof(float));
     float *ptr = buffer.ptrAsFloat();
     int pos = downToTop ? imageWidth * (imageHeight - 1) * 4 : 0;
     int delta = downToTop ? -imageWidth * 4 * 2 : 0;
@@ -171,7 +171,5 @@ void Image::LoadImageBMP(Stream &stream)
 
     pixelFormat = PixelFormat::Internal;
 
-    mipMaps.push_back(new MipMap(buffer, imageWidth, imageHeight, PixelFormat::Internal));
-
-    buffer.Free();
+    mipMaps.push_back(new MipMap(std::move(buffer), imageWidth, imageHeight, PixelFormat::Internal));
 }
@@ -255,9 +255,8 @@ void Image::LoadImageDDS(Stream &stream, bool &source8Bits)
         }
 
         int size = MipMap::getBufferSize(w, h, pixelFormat);
-        ByteBuffer tempData = stream.ReadToBuffer(size);
-        mipMaps.push_back(new MipMap(tempData, origW, origH, pixelFormat));
-        tempData.Free();
+        UniqueByteBuffer tempData(stream.ReadToBuffer(size));
+        mipMaps.push_back(new MipMap(std::move(tempData), origW, origH, pixelFormat));
     }
 }
 
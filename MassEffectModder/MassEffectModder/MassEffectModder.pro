@@ -17,6 +17,8 @@ CONFIG += sdk_no_version_check
 
 equals(GUI_MODE, true) {
     TARGET = MassEffectModder
+} else:equals(BENCH_MODE, true) {
+    TARGET = MassEffectModderBench
 } else {
     TARGET = MassEffectModderNoGui
 }
@@ -24,13 +26,20 @@ equals(GUI_MODE, true) {
 TEMPLATE = app
 
 SOURCES += \
+    GameData/FileInventory.cpp \
     GameData/GameData.cpp \
+    GameData/MarkersManifest.cpp \
     GameData/Package.cpp \
+    GameData/PackageCache.cpp \
     GameData/Properties.cpp \
     GameData/TOCFile.cpp \
     GameData/UserSettings.cpp \
+    Helpers/ArchiveStream.cpp \
+    Helpers/CacheFile.cpp \
     Helpers/Crc32.cpp \
+    Helpers/Crc32Fast.cpp \
     Helpers/FileStream.cpp \
+    Helpers/IpcChannel.cpp \
     Helpers/Logs.cpp \
     Helpers/MemoryStream.cpp \
     Helpers/MiscHelpers.cpp \
@@ -40,9 +49,11 @@ SOURCES += \
     Image/ImageDDS.cpp \
     Image/ImageTGA.cpp \
     Md5/MD5BadEntries.cpp \
+    Md5/MD5Cache.cpp \
     Md5/MD5ModEntries.cpp \
     MipMaps/MipMap.cpp \
     MipMaps/MipMapsReplace.cpp \
+    Misc/ImageBatch.cpp \
     Misc/Misc.cpp \
     Misc/MiscCheckGame.cpp \
     Misc/MiscMods.cpp \
@@ -50,13 +61,15 @@ SOURCES += \
     Misc/MiscProcessGame.cpp \
     Misc/MiscTexture.cpp \
     Program/ConfigIni.cpp \
-    Program/Main.cpp \
     Program/SignalHandler.cpp \
     Resources/Resources.cpp \
     Texture/Texture.cpp \
     Texture/TextureCube.cpp \
+    Texture/TextureMapView.cpp \
     Texture/TextureMovie.cpp \
-    Texture/TextureScan.cpp
+    Texture/TextureScan.cpp \
+    Texture/TextureScanCache.cpp \
+    Texture/TextureView.cpp
 
 equals(GUI_MODE, true) {
 SOURCES += \
@@ -72,6 +85,11 @@ SOURCES += \
     Gui/LayoutTexturesManager.cpp \
     Gui/PixmapLabel.cpp \
     Gui/Updater.cpp
+} else:equals(BENCH_MODE, true) {
+SOURCES += \
+    Bench/Bench.cpp \
+    Bench/BenchData.cpp \
+    Bench/BenchMain.cpp
 } else {
 SOURCES += \
     CmdLine/CmdLineHelp.cpp \
@@ -79,19 +97,31 @@ SOURCES += \
     CmdLine/CmdLineTools.cpp
 }
 
+!equals(BENCH_MODE, true) {
+SOURCES += \
+    Program/Main.cpp
+}
+
 PRECOMPILED_HEADER = Types/Precompiled.h
 
 HEADERS += \
+    GameData/FileInventory.h \
     GameData/GameData.h \
+    GameData/MarkersManifest.h \
     GameData/Package.h \
+    GameData/PackageCache.h \
     GameData/Properties.h \
     GameData/TOCFile.h \
     GameData/UserSettings.h \
+    Helpers/ArchiveStream.h \
     Helpers/ByteBuffer.h \
     Helpers/BinarySearch.h \
+    Helpers/CacheFile.h \
     Helpers/Crc32.h \
+    Helpers/Crc32Fast.h \
     Helpers/Exception.h \
     Helpers/FileStream.h \
+    Helpers/IpcChannel.h \
     Helpers/Logs.h \
     Helpers/MemoryStream.h \
     Helpers/MiscHelpers.h \
@@ -99,7 +129,9 @@ HEADERS += \
     Helpers/Stream.h \
     Image/Image.h \
     Md5/MD5BadEntries.h \
+    Md5/MD5Cache.h \
     Md5/MD5ModEntries.h \
+    Misc/ImageBatch.h \
     Misc/Misc.h \
     MipMaps/MipMap.h \
     MipMaps/MipMaps.h \
@@ -108,8 +140,11 @@ HEADERS += \
     Resources/Resources.h \
     Texture/Texture.h \
     Texture/TextureCube.h \
+    Texture/TextureMapView.h \
     Texture/TextureMovie.h \
     Texture/TextureScan.h \
+    Texture/TextureScanCache.h \
+    Texture/TextureView.h \
     Types/MemTypes.h
 equals(GUI_MODE, true) {
 HEADERS += \
@@ -123,6 +158,10 @@ HEADERS += \
     Gui/LayoutTexturesManager.h \
     Gui/PixmapLabel.h \
     Gui/Updater.h
+} else:equals(BENCH_MODE, true) {
+HEADERS += \
+    Bench/Bench.h \
+    Bench/BenchData.h
 } else {
 HEADERS += \
     CmdLine/CmdLineParams.h \
@@ -166,6 +205,10 @@ equals(RELEASE_IN_DEBUG_MODE, true) {
 QMAKE_CXXFLAGS +=
 QMAKE_CXXFLAGS_DEBUG += -g
 
+CONFIG(debug, debug | release) {
+    DEFINES += BYTEBUFFER_COPY_STATS
+}
+
 win32-g++: {
     # Disable compiler warning
     QMAKE_CXXFLAGS += -Wno-deprecated-copy
@@ -0,0 +1,161 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <Md5/MD5Cache.h>
+#include <Misc/Misc.h>
+#include <GameData/GameData.h>
+#include <Helpers/CacheFile.h>
+#include <Helpers/MemoryStream.h>
+#include <Helpers/MiscHelpers.h>
+#include <Helpers/Logs.h>
+
+bool MD5Cache::forceRehash = false;
+
+MD5Cache::MD5Cache(MeType gameId)
+{
+    QString path = QStandardPaths::standardLocations(QStandardPaths::GenericConfigLocation).first() +
+            "/MassEffectModder";
+    if (!QDir(path).exists())
+        QDir(path).mkpath(path);
+    cachePath = path + QString("/mele%1md5.bin").arg((int)gameId);
+    if (!forceRehash)
+        Load();
+}
+
+void MD5Cache::Load()
+{
+    if (!QFile(cachePath).exists())
+        return;
+
+    CacheFileReader fs(cachePath);
+    if (fs.ReadUInt32() != md5CacheBinTag)
+    {
+        PDEBUG("MD5Cache: wrong cache file, ignoring: " + cachePath + "\n");
+        return;
+    }
+    if (fs.ReadUInt32() != md5CacheBinVersion)
+    {
+        PDEBUG("MD5Cache: unsupported cache version, ignoring: " + cachePath + "\n");
+        return;
+    }
+    int count = fs.ReadInt32();
+    // key terminator, size, mtime, inode and digest
+    if (!fs.CheckCount(count, 2 + 8 + 8 + 8 + 16))
+    {
+        PDEBUG("MD5Cache: broken cache file, ignoring: " + cachePath + "\n");
+        return;
+    }
+    entries.reserve(count);
+    for (int i = 0; i < count && !fs.Failed(); i++)
+    {
+        QString key;
+        CacheEntry entry{};
+        fs.ReadStringUnicode16Null(key);
+        entry.size = fs.ReadInt64();
+        entry.mtime = fs.ReadInt64();
+        entry.inode = fs.ReadUInt64();
+        fs.ReadToBuffer(entry.md5, sizeof(entry.md5));
+        entries.insert(key, entry);
+    }
+    if (fs.Failed() || fs.Remaining() != 0)
+    {
+        PDEBUG("MD5Cache: broken cache file, ignoring: " + cachePath + "\n");
+        entries.clear();
+    }
+}
+
+void MD5Cache::Save()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if (!modified)
+        return;
+
+    MemoryStream mem;
+    mem.WriteUInt32(md5CacheBinTag);
+    mem.WriteUInt32(md5CacheBinVersion);
+    mem.WriteInt32(entries.count());
+    for (auto it = entries.constBegin(); it != entries.constEnd(); it++)
+    {
+        mem.WriteStringUnicode16Null(it.key());
+        mem.WriteInt64(it.value().size);
+        mem.WriteInt64(it.value().mtime);
+        mem.WriteUInt64(it.value().inode);
+        mem.WriteFromBuffer(const_cast<quint8 *>(it.value().md5), sizeof(it.value().md5));
+    }
+    if (!WriteCacheFile(cachePath, mem))
+    {
+        PDEBUG("MD5Cache: failed to write cache file: " + cachePath + "\n");
+        return;
+    }
+    modified = false;
+}
+
+QByteArray MD5Cache::GetMD5(const QString &relativePath)
+{
+    QString path = g_GameData->GamePath() + relativePath;
+    qint64 size, mtime;
+    quint64 inode;
+    const FileInventory::Entry *file = g_GameData->inventory.Find(relativePath);
+    if (file != nullptr)
+    {
+        size = file->size;
+        mtime = file->mtime;
+        inode = file->inode;
+    }
+    else if (!GetFileStat(path, size, mtime, inode))
+    {
+        QByteArray md5;
+        Misc::calculateMD5(path, md5);
+        return md5;
+    }
+
+    QString key = relativePath.toLower();
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = entries.constFind(key);
+        if (it != entries.constEnd() && it.value().size == size &&
+            it.value().mtime == mtime && it.value().inode == inode)
+        {
+            return QByteArray(reinterpret_cast<const char *>(it.value().md5), sizeof(it.value().md5));
+        }
+    }
+
+    QByteArray md5;
+    if (!Misc::calculateMD5(path, md5))
+    {
+        // Do not remember digest of file which could not be read
+        std::lock_guard<std::mutex> guard(lock);
+        if (entries.remove(key) != 0)
+            modified = true;
+        return md5;
+    }
+
+    CacheEntry entry{};
+    entry.size = size;
+    entry.mtime = mtime;
+    entry.inode = inode;
+    memcpy(entry.md5, md5.data(), sizeof(entry.md5));
+    std::lock_guard<std::mutex> guard(lock);
+    entries.insert(key, entry);
+    modified = true;
+
+    return md5;
+}
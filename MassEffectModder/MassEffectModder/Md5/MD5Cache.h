@@ -0,0 +1,55 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef MD5_CACHE_H
+#define MD5_CACHE_H
+
+#include <Types/MemTypes.h>
+
+class MD5Cache
+{
+private:
+
+    struct CacheEntry
+    {
+        qint64 size;
+        qint64 mtime;
+        quint64 inode;
+        quint8 md5[16];
+    };
+
+    QHash<QString, CacheEntry> entries;
+    std::mutex lock;
+    QString cachePath;
+    bool modified = false;
+
+    void Load();
+
+public:
+
+    static bool forceRehash;
+
+    explicit MD5Cache(MeType gameId);
+    QByteArray GetMD5(const QString &relativePath);
+    void Save();
+};
+
+#endif
@@ -43,6 +43,11 @@ MipMap::MipMap(int w, int h, PixelFormat format)
 }
 
 MipMap::MipMap(const ByteBuffer &src, int w, int h, PixelFormat format, bool skipCheck)
+    : MipMap(UniqueByteBuffer(src.ptr(), src.size()), w, h, format, skipCheck)
+{
+}
+
+MipMap::MipMap(UniqueByteBuffer &&src, int w, int h, PixelFormat format, bool skipCheck)
 {
     width = origWidth = w;
     height = origHeight = h;
@@ -65,7 +70,7 @@ MipMap::MipMap(const ByteBuffer &src, int w, int h, PixelFormat format, bool ski
             CRASH_MSG("Data size is not valid.");
     }
 
-    buffer = ByteBuffer(src.ptr(), src.size());
+    buffer = src.release();
 }
 
 int MipMap::getBufferSize(int w, int h, PixelFormat format)
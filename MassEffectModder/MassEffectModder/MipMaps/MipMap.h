@@ -29,6 +29,7 @@ class MipMap
 {
 private:
 
+    // Kept as shallow ByteBuffer, mipmaps are stored by value in Qt containers
     ByteBuffer buffer;
     int width;
     int height;
@@ -39,6 +40,7 @@ public:
 
     MipMap(int w, int h, PixelFormat format);
     MipMap(const ByteBuffer &data, int w, int h, PixelFormat format, bool skipCheck = false);
+    MipMap(UniqueByteBuffer &&data, int w, int h, PixelFormat format, bool skipCheck = false);
     void Free() { buffer.Free(); }
     static int getBufferSize(int w, int h, PixelFormat format);
     ByteBuffer& getRefData() { return buffer; }
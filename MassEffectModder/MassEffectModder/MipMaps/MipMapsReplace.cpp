@@ -22,9 +22,13 @@
 #include <MipMaps/MipMaps.h>
 #include <GameData/GameData.h>
 #include <GameData/Package.h>
+#include <GameData/TOCFile.h>
 #include <Texture/Texture.h>
 #include <Texture/TextureMovie.h>
+#include <Texture/TextureView.h>
 #include <Misc/Misc.h>
+#include <Helpers/ArchiveStream.h>
+#include <Helpers/IpcChannel.h>
 #include <Helpers/MiscHelpers.h>
 #include <Helpers/Logs.h>
 #include <Helpers/QSort.h>
@@ -196,8 +200,7 @@ bool MipMaps::VerifyTextures(QList<TextureMapEntry> &textures,
             lastProgress = newProgress;
             if (g_ipc)
             {
-                ConsoleWrite(QString("[IPC]TASK_PROGRESS ") + QString::number(newProgress));
-                ConsoleSync();
+                IpcChannel::Progress(newProgress);
             }
             else if (callback)
             {
@@ -225,11 +228,10 @@ bool MipMaps::VerifyTextures(QList<TextureMapEntry> &textures,
                     {
                         if (g_ipc)
                         {
-                            ConsoleWrite(QString("[IPC]ERROR Texture ") + foundTexture.name +
-                                         " has broken export data in package: " +
-                                         matchedTexture.path + "Export Id: " +
-                                         QString::number(matchedTexture.exportID + 1) + " Skipping...");
-                            ConsoleSync();
+                            IpcChannel::Send(IpcEvent::Error, QString("Texture ") + foundTexture.name +
+                                             " has broken export data in package: " +
+                                             matchedTexture.path + "Export Id: " +
+                                             QString::number(matchedTexture.exportID + 1) + " Skipping...");
                         }
                         else
                         {
@@ -241,20 +243,18 @@ bool MipMaps::VerifyTextures(QList<TextureMapEntry> &textures,
                         errors = true;
                         continue;
                     }
-                    Texture texture = Texture(package, matchedTexture.exportID, exportData);
-                    exportData.Free();
+                    TextureView texture(package, matchedTexture.exportID, std::move(exportData));
                     for (int m = 0; m < matchedTexture.crcs.count(); m++)
                     {
-                        if (matchedTexture.crcs[m] != texture.getCrcData(texture.getMipMapDataByIndex(m)))
+                        if (matchedTexture.crcs[m] != texture.getCrcMipmapByIndex(m))
                         {
                             if (g_ipc)
                             {
-                                ConsoleWrite(QString("[IPC]ERROR Texture ") + foundTexture.name +
-                                             " CRC does not match, mipmap: " +
-                                             QString::number(m) + ", Package: " +
-                                             matchedTexture.path + ", Export Id: " +
-                                             QString::number(matchedTexture.exportID + 1));
-                                ConsoleSync();
+                                IpcChannel::Send(IpcEvent::Error, QString("Texture ") + foundTexture.name +
+                                                 " CRC does not match, mipmap: " +
+                                                 QString::number(m) + ", Package: " +
+                                                 matchedTexture.path + ", Export Id: " +
+                                                 QString::number(matchedTexture.exportID + 1));
                             }
                             else
                             {
@@ -292,17 +292,15 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
 
     if (g_ipc)
     {
-        ConsoleWrite(QString("[IPC]AMOUNT_MEMORY_GB ") + QString::number(memoryAmount));
-        ConsoleWrite(QString("[IPC]CACHE_LIMIT ") + QString::number(cacheLimit));
-        ConsoleSync();
+        IpcChannel::Send(IpcEvent::AmountMemoryGB, QString::number(memoryAmount));
+        IpcChannel::Send(IpcEvent::CacheLimit, QString::number(cacheLimit));
     }
 
     for (int e = 0; e < map.count(); e++)
     {
         if (g_ipc)
         {
-            ConsoleWrite(QString("[IPC]PROCESSING_FILE ") + map[e].packagePath);
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::ProcessingFile, map[e].packagePath);
         }
         else
         {
@@ -316,8 +314,7 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
             lastProgress = newProgress;
             if (g_ipc)
             {
-                ConsoleWrite(QString("[IPC]TASK_PROGRESS ") + QString::number(newProgress));
-                ConsoleSync();
+                IpcChannel::Progress(newProgress);
             }
             else if (callback)
             {
@@ -326,12 +323,11 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
         }
 
         Package package{};
-        if (package.Open(g_GameData->GamePath() + map[e].packagePath) != 0)
+        if (package.Open(g_GameData->GamePath() + map[e].packagePath, false, false, true) != 0)
         {
             if (g_ipc)
             {
-                ConsoleWrite(QString("[IPC]ERROR Issue opening package file: ") + map[e].packagePath);
-                ConsoleSync();
+                IpcChannel::Send(IpcEvent::Error, QString("Issue opening package file: ") + map[e].packagePath);
             }
             else
             {
@@ -357,10 +353,9 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
             {
                 if (g_ipc)
                 {
-                    ConsoleWrite(QString("[IPC]ERROR Texture ") + mod.textureName +
-                                 " has broken export data in package: " +
-                                 matched.path + "\nExport Id: " + QString::number(matched.exportID + 1) + "\nSkipping...");
-                    ConsoleSync();
+                    IpcChannel::Send(IpcEvent::Error, QString("Texture ") + mod.textureName +
+                                     " has broken export data in package: " +
+                                     matched.path + "\nExport Id: " + QString::number(matched.exportID + 1) + "\nSkipping...");
                 }
                 else
                 {
@@ -383,16 +378,18 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
                 }
                 else
                 {
-                    FileStream fs = FileStream(mod.memPath, FileMode::Open, FileAccess::ReadOnly);
-                    fs.JumpTo(mod.memEntryOffset);
-                    data = Misc::decompressData(fs, mod.memEntrySize);
+                    std::unique_ptr<Stream> fs = ArchiveStream::OpenRead(mod.memPath);
+                    if (fs)
+                    {
+                        fs->JumpTo(mod.memEntryOffset);
+                        data = Misc::decompressData(*fs, mod.memEntrySize);
+                    }
                 }
                 if (data.size() == 0)
                 {
                     if (g_ipc)
                     {
-                        ConsoleWrite(QString("[IPC]ERROR ") + mod.textureName + " MEM file: " + mod.memPath);
-                        ConsoleSync();
+                        IpcChannel::Send(IpcEvent::Error, mod.textureName + " MEM file: " + mod.memPath);
                     }
                     PERROR(QString("Failed decompress data: ") + mod.textureName +
                            " MEM file: " + mod.memPath + "\n");
@@ -422,6 +419,7 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
                             else if (files.count() == 0)
                             {
                                 FileStream fs = FileStream(DLCArchiveFile, FileMode::Create, FileAccess::WriteOnly);
+                                TOCBinFile::RegisterNewFile(DLCArchiveFile);
                                 fs.WriteFromBuffer(textureMovie.getProperties().getProperty("TFCFileGuid").getValueStruct());
                                 archiveFile = DLCArchiveFile;
                             }
@@ -454,6 +452,7 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
                                     textureMovie.getProperties().setNameValue("TextureFileCacheName", tfcNewName);
                                     textureMovie.getProperties().setStructValue("TFCFileGuid", "Guid", guid);
                                     FileStream fs = FileStream(archiveFile, FileMode::Create, FileAccess::WriteOnly);
+                                    TOCBinFile::RegisterNewFile(archiveFile);
                                     fs.WriteFromBuffer(guid);
                                     guid.Free();
                                     break;
@@ -473,6 +472,7 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
                                 CRASH_MSG("No more TFC files available!");
                         }
                         FileStream archiveFs = FileStream(archiveFile, FileMode::Open, FileAccess::ReadWrite);
+                        TOCBinFile::RegisterChangedFile(archiveFile);
                         archiveFs.SeekEnd();
                         textureMovie.replaceMovieData(data, archiveFs.Position());
                         archiveFs.WriteFromBuffer(data);
@@ -480,6 +480,7 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
                     else
                     {
                         FileStream archiveFs = FileStream(archiveFile, FileMode::Open, FileAccess::ReadWrite);
+                        TOCBinFile::RegisterChangedFile(archiveFile);
                         archiveFs.JumpTo(textureMovie.getDataOffset());
                         archiveFs.WriteFromBuffer(data);
                     }
@@ -498,16 +499,13 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
                     ByteBuffer bufferTextureData = textureMovie.toArray();
                     newData.WriteFromBuffer(bufferTextureData);
                     bufferTextureData.Free();
-                    ByteBuffer bufferTexture = newData.ToArray();
-                    package.setExportData(matched.exportID, bufferTexture);
-                    bufferTexture.Free();
+                    package.setExportData(matched.exportID, UniqueByteBuffer(newData.ToArray()));
                 }
                 bufferProperties.Free();
             }
             else
             {
-                Texture texture = Texture(package, matched.exportID, exportData);
-                exportData.Free();
+                Texture texture = Texture(package, matched.exportID, std::move(exportData));
                 QString fmt = texture.getProperties().getProperty("Format").getValueName();
                 PixelFormat pixelFormat = Image::getPixelFormatType(fmt);
                 texture.removeEmptyMips();
@@ -523,15 +521,18 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
                     }
                     else
                     {
-                        FileStream fs = FileStream(mod.memPath, FileMode::Open, FileAccess::ReadOnly);
-                        fs.JumpTo(mod.memEntryOffset);
-                        ByteBuffer data = Misc::decompressData(fs, mod.memEntrySize);
+                        std::unique_ptr<Stream> fs = ArchiveStream::OpenRead(mod.memPath);
+                        ByteBuffer data;
+                        if (fs)
+                        {
+                            fs->JumpTo(mod.memEntryOffset);
+                            data = Misc::decompressData(*fs, mod.memEntrySize);
+                        }
                         if (data.size() == 0)
                         {
                             if (g_ipc)
                             {
-                                ConsoleWrite(QString("[IPC]ERROR ") + mod.textureName + " MEM file: " + mod.memPath);
-                                ConsoleSync();
+                                IpcChannel::Send(IpcEvent::Error, mod.textureName + " MEM file: " + mod.memPath);
                             }
                             PERROR(QString("Failed decompress data: ") + mod.textureName +
                                    " MEM file: " + mod.memPath + "\n");
@@ -569,9 +570,8 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
                     {
                         if (g_ipc)
                         {
-                            ConsoleWrite(QString("[IPC]ERROR Texture ") + mod.textureName +
-                                         " has zero mips after mips filtering.\nSkipping...");
-                            ConsoleSync();
+                            IpcChannel::Send(IpcEvent::Error, QString("Texture ") + mod.textureName +
+                                             " has zero mips after mips filtering.\nSkipping...");
                         }
                         else
                         {
@@ -590,12 +590,11 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
                             matched.crcs.push_back(texture.getCrcData(image->getMipMaps()[m]->getRefData()));
                         mod.cacheCprMipmapsStorageType = StorageTypes::extOodle;
                         mod.cacheCprMipmapsDecompressedSize.push_back(image->getMipMaps()[m]->getRefData().size());
-                        auto data = Package::compressData(image->getMipMaps()[m]->getRefData(),
-                                                            mod.cacheCprMipmapsStorageType);
-                        mod.cacheCprMipmaps.push_back(MipMap(data, image->getMipMaps()[m]->getOrigWidth(),
-                                                      image->getMipMaps()[m]->getOrigHeight(), mod.cachedPixelFormat, true));
+                        UniqueByteBuffer data(Package::compressData(image->getMipMaps()[m]->getRefData(),
+                                                                    mod.cacheCprMipmapsStorageType));
                         mod.cacheSize += data.size();
-                        data.Free();
+                        mod.cacheCprMipmaps.push_back(MipMap(std::move(data), image->getMipMaps()[m]->getOrigWidth(),
+                                                      image->getMipMaps()[m]->getOrigHeight(), mod.cachedPixelFormat, true));
                     }
                     cacheUsage += mod.cacheSize;
                 }
@@ -696,6 +695,7 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
                             else if (files.count() == 0)
                             {
                                 FileStream fs = FileStream(DLCArchiveFile, FileMode::Create, FileAccess::WriteOnly);
+                                TOCBinFile::RegisterNewFile(DLCArchiveFile);
                                 fs.WriteFromBuffer(texture.getProperties().getProperty("TFCFileGuid").getValueStruct());
                                 archiveFile = DLCArchiveFile;
                             }
@@ -730,6 +730,7 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
                                 texture.getProperties().setNameValue("TextureFileCacheName", tfcNewName);
                                 texture.getProperties().setStructValue("TFCFileGuid", "Guid", guid);
                                 FileStream fs = FileStream(archiveFile, FileMode::Create, FileAccess::WriteOnly);
+                                TOCBinFile::RegisterNewFile(archiveFile);
                                 fs.WriteFromBuffer(guid);
                                 guid.Free();
                                 break;
@@ -797,6 +798,7 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
                         {
                             triggerCacheArc = true;
                             FileStream fs = FileStream(archiveFile, FileMode::Open, FileAccess::ReadWrite);
+                            TOCBinFile::RegisterChangedFile(archiveFile);
                             fs.SeekEnd();
                             mipmap.dataOffset = (uint)fs.Position();
                             fs.WriteFromBuffer(mipmap.newData);
@@ -834,9 +836,7 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
                     ByteBuffer bufferTextureData = texture.toArray(0, false); // filled later
                     newData.WriteFromBuffer(bufferTextureData);
                     bufferTextureData.Free();
-                    ByteBuffer bufferTexture = newData.ToArray();
-                    package.setExportData(matched.exportID, bufferTexture);
-                    bufferTexture.Free();
+                    package.setExportData(matched.exportID, UniqueByteBuffer(newData.ToArray()));
                 }
                 {
                     MemoryStream newData;
@@ -845,9 +845,7 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
                     ByteBuffer bufferTextureData = texture.toArray(packageDataOffset);
                     newData.WriteFromBuffer(bufferTextureData);
                     bufferTextureData.Free();
-                    ByteBuffer bufferTexture = newData.ToArray();
-                    package.setExportData(matched.exportID, bufferTexture);
-                    bufferTexture.Free();
+                    package.setExportData(matched.exportID, UniqueByteBuffer(newData.ToArray()));
                 }
                 bufferProperties.Free();
 
@@ -860,8 +858,7 @@ QString MipMaps::replaceTextures(QList<MapPackagesToMod> &map, QList<TextureMapE
 
                 if (g_ipc)
                 {
-                    ConsoleWrite(QString("[IPC]CACHE_USAGE ") + QString::number(cacheUsage));
-                    ConsoleSync();
+                    IpcChannel::Send(IpcEvent::CacheUsage, QString::number(cacheUsage));
                 }
 
                 mod.instance--;
@@ -957,9 +954,8 @@ QString MipMaps::replaceModsFromList(QList<TextureMapEntry> &textures, QStringLi
             {
                 if (g_ipc)
                 {
-                    ConsoleWrite(QString("[IPC]MOD_OVERRIDE ") + mod.textureName +
-                                 QString::asprintf("_0x%08X", mod.textureCrc) + ", " + mod.memPath);
-                    ConsoleSync();
+                    IpcChannel::Send(IpcEvent::ModOverride, mod.textureName +
+                                     QString::asprintf("_0x%08X", mod.textureCrc) + ", " + mod.memPath);
                 }
                 else
                 {
@@ -0,0 +1,142 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <Misc/ImageBatch.h>
+#include <MipMaps/MipMap.h>
+#include <Helpers/MiscHelpers.h>
+
+#include <condition_variable>
+
+int ImageBatch::memoryBudgetMB = 0;
+
+qint64 ImageBatch::GetMemoryBudget()
+{
+    if (memoryBudgetMB > 0)
+        return static_cast<qint64>(memoryBudgetMB) * 1024 * 1024;
+
+    int memoryGB = DetectAmountMemoryGB();
+    if (memoryGB <= 0)
+        memoryGB = 4;
+    return static_cast<qint64>(memoryGB) * 1024 * 1024 * 1024 / 2;
+}
+
+qint64 ImageBatch::EstimateMemory(int width, int height, PixelFormat pixelFormat, qint64 fileSize)
+{
+    if (width <= 0 || height <= 0 || pixelFormat == PixelFormat::UnknownPixelFormat)
+        return fileSize * 4;
+
+    // Source image, internal float copy and target format copy, each with full mip chain
+    qint64 internalSize = MipMap::getBufferSize(width, height, PixelFormat::Internal);
+    qint64 targetSize = MipMap::getBufferSize(width, height, pixelFormat);
+    return fileSize + (internalSize + targetSize * 2) * 4 / 3;
+}
+
+void ImageBatch::Run(const QVector<qint64> &estimates, const JobFunction &job,
+                     const ProgressFunction &progress)
+{
+    int total = estimates.count();
+    if (total == 0)
+        return;
+
+    // Biggest jobs go first, smaller ones fill the budget left by running jobs
+    std::vector<int> pending(total);
+    for (int i = 0; i < total; i++)
+        pending[i] = i;
+    std::stable_sort(pending.begin(), pending.end(), [&estimates](int a, int b)
+    {
+        return estimates[a] > estimates[b];
+    });
+
+    qint64 budget = GetMemoryBudget();
+    qint64 usedMemory = 0;
+    int running = 0;
+    int completed = 0;
+    std::mutex lock;
+    std::condition_variable released;
+
+    int reported = 0;
+    #pragma omp parallel
+    {
+#ifdef GUI
+        // Progress callback pumps GUI events, only main thread may run it
+        bool coordinated = omp_get_num_threads() > 1;
+#else
+        bool coordinated = false;
+#endif
+        std::unique_lock<std::mutex> guard(lock);
+        if (coordinated && omp_get_thread_num() == 0)
+        {
+            while (completed != total)
+            {
+                released.wait_for(guard, std::chrono::milliseconds(100));
+                if (progress)
+                {
+                    int done = completed;
+                    guard.unlock();
+                    progress(done, total);
+                    guard.lock();
+                }
+            }
+        }
+        else
+        while (!pending.empty())
+        {
+            int picked = -1;
+            for (size_t i = 0; i < pending.size(); i++)
+            {
+                // Oversized job is still admitted when nothing else is running
+                if (running == 0 || usedMemory + estimates[pending[i]] <= budget)
+                {
+                    picked = static_cast<int>(i);
+                    break;
+                }
+            }
+            if (picked == -1)
+            {
+                released.wait(guard);
+                continue;
+            }
+            int index = pending[picked];
+            pending.erase(pending.begin() + picked);
+            usedMemory += estimates[index];
+            running++;
+            guard.unlock();
+
+            job(index);
+
+            guard.lock();
+            usedMemory -= estimates[index];
+            running--;
+            completed++;
+            released.notify_all();
+
+            // Whichever thread finishes a job reports, serialized by the lock
+            if (!coordinated && progress && reported != completed)
+            {
+                reported = completed;
+                progress(completed, total);
+            }
+        }
+    }
+
+    if (progress)
+        progress(total, total);
+}
@@ -0,0 +1,44 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef IMAGE_BATCH_H
+#define IMAGE_BATCH_H
+
+#include <Types/MemTypes.h>
+
+#include <functional>
+
+class ImageBatch
+{
+public:
+
+    typedef std::function<void (int index)> JobFunction;
+    typedef std::function<void (int completed, int total)> ProgressFunction;
+
+    static int memoryBudgetMB;
+
+    static qint64 GetMemoryBudget();
+    static qint64 EstimateMemory(int width, int height, PixelFormat pixelFormat, qint64 fileSize);
+    static void Run(const QVector<qint64> &estimates, const JobFunction &job,
+                    const ProgressFunction &progress = nullptr);
+};
+
+#endif
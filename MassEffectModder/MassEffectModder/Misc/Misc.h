@@ -30,6 +30,8 @@
 #include <Types/MemTypes.h>
 
 class MipMaps;
+class TextureMapView;
+class MD5Cache;
 
 struct MD5ModFileEntry
 {
@@ -47,13 +49,18 @@ public:
         SizeOfChunkBlock = 8,
         SizeOfChunk = 12,
         MaxBlockSize = 0x40000, // 256KB
+        MD5ReadBlockSize = 0x800000, // 8MB
+        KnownDigestVanilla = -1,
+        MarkersBatchFactor = 16,
     };
 
     typedef void (*ProgressCallback)(void *handle, int progress, const QString &stage);
 
 private:
 
-    static bool checkGameFilesSub(FileStream *fs, QStringList &files, QList<MD5FileEntry> &entries,
+    static void buildKnownDigests(QHash<QByteArray, int> &digests);
+    static bool checkGameFilesSub(FileStream *fs, QStringList &files, const MD5Table &entries,
+                                  const QHash<QByteArray, int> &knownDigests, MD5Cache &md5Cache,
                                   int &lastProgress, int &progress, int allFilesCount,
                                   QString &errors, QStringList &mods,
                                   ProgressCallback callback, void *callbackHandle);
@@ -84,12 +91,13 @@ public:
     static uint GetCRCFromTextureMap(QList<TextureMapEntry> &textures, int exportId,
                                      const QString &path);
     static TextureMapEntry FoundTextureInTheMap(QList<TextureMapEntry> &textures, uint crc);
+    static TextureMapEntry FoundTextureInTheMap(TextureMapView &mapView, uint crc);
     static TextureMapEntry FoundTextureInTheInternalMap(MeType gameId, uint crc);
     static bool compareFileInfoPath(const QFileInfo &e1, const QFileInfo &e2);
     static bool convertDataModtoMem(QFileInfoList &files, QString &memFilePath,
                                     MeType gameId, QList<TextureMapEntry> &textures, bool fastMode, bool markToConvert, bool bc7format, float bc7quality,
                                     ProgressCallback callback, void *callbackHandle);
-    static bool InstallMods(MeType gameId, Resources &resources, QStringList &modFiles, bool guiInstallerMode, bool alotInstallerMode,
+    static bool InstallMods(MeType gameId, QStringList &modFiles, bool guiInstallerMode, bool alotInstallerMode,
                            bool skipMarkers, bool verify, int cacheAmount,
                            ProgressCallback callback, void *callbackHandle);
 
@@ -103,26 +111,27 @@ public:
     static bool ReportMods();
     static bool applyMods(QStringList &files, QList<TextureMapEntry> &textures, QStringList &pkgsToMarker,
                           MipMaps &mipMaps, bool alotMode, bool verify, int cacheAmount,
-                          ProgressCallback callback, void *callbackHandle);
+                          ProgressCallback callback, void *callbackHandle,
+                          TextureMapView *mapView = nullptr);
     static QString CorrectTexture(Image *image, Texture &texture, PixelFormat newPixelFormat,
                                   const QString &textureName, float bc7quality);
     static bool CorrectTexture(Image &image, TextureMapEntry &f, int numMips,
                               PixelFormat newPixelFormat, const QString &file, float bc7quality);
-    static bool CheckMEMHeader(FileStream &fs, const QString &file);
-    static bool CheckMEMGameVersion(FileStream &fs, const QString &file, int gameId);
+    static bool CheckMEMHeader(Stream &fs, const QString &file);
+    static bool CheckMEMGameVersion(Stream &fs, const QString &file, int gameId);
     static bool CheckImage(Image &image, TextureMapEntry &f, const QString &file, int index);
     static bool CheckImage(Image &image, Texture &texture, const QString &textureName);
     static bool DetectMarkToConvertFromFile(const QString &file);
     static bool DetectHashFromFile(const QString &file);
     static bool DetectBc7FromFile(const QString &file);
     static int GetNumberOfMipsFromMap(TextureMapEntry &f);
-    static QByteArray calculateMD5(const QString &filePath);
+    static bool calculateMD5(const QString &filePath, QByteArray &md5);
     static void detectMods(QStringList &mods);
     static bool detectMod();
     static void detectBrokenMod(QStringList &mods);
-    static bool CheckGameDataAndMods(MeType gameId, Resources &resources);
+    static bool CheckGameDataAndMods(MeType gameId);
     static bool ApplyPostInstall(MeType gameId, QStringList &mods);
-    static bool checkGameFiles(MeType gameType, Resources &resources, QString &errors,
+    static bool checkGameFiles(MeType gameType, QString &errors,
                                QStringList &mods, ProgressCallback callback,
                                void *callbackHandle);
     static bool compressData(ByteBuffer inputData, Stream &ouputStream, CompressionDataType compType = CompressionDataType::LZMA);
@@ -23,6 +23,8 @@
 #include <GameData/GameData.h>
 #include <Md5/MD5ModEntries.h>
 #include <Md5/MD5BadEntries.h>
+#include <Md5/MD5Cache.h>
+#include <Helpers/IpcChannel.h>
 #include <Helpers/MiscHelpers.h>
 #include <Helpers/Logs.h>
 #include <Helpers/FileStream.h>
@@ -30,12 +32,12 @@
 static bool generateModsMd5Entries = false;
 static bool generateMd5Entries = false;
 
-bool Misc::CheckGameDataAndMods(MeType gameId, Resources &resources)
+bool Misc::CheckGameDataAndMods(MeType gameId)
 {
     QString errors;
     QStringList modList;
 
-    bool vanilla = Misc::checkGameFiles(gameId, resources, errors, modList, nullptr, nullptr);
+    bool vanilla = Misc::checkGameFiles(gameId, errors, modList, nullptr, nullptr);
 
     if (!g_ipc)
     {
@@ -61,151 +63,153 @@ bool Misc::CheckGameDataAndMods(MeType gameId, Resources &resources)
     return vanilla;
 }
 
-bool Misc::checkGameFilesSub(FileStream *fs, QStringList &files, QList<MD5FileEntry> &entries,
+void Misc::buildKnownDigests(QHash<QByteArray, int> &digests)
+{
+    // Order of inserts keep priority of original lookups: mods, bad mods
+    // Vanilla digests are looked up directly in MD5 table first
+    digests.clear();
+    digests.reserve(modsEntriesSize + badMODSize);
+    for (int p = 0; p < badMODSize; p++)
+    {
+        digests.insert(QByteArray(reinterpret_cast<const char *>(badMOD[p].md5), 16), KnownDigestVanilla);
+    }
+    for (int p = 0; p < modsEntriesSize; p++)
+    {
+        digests.insert(QByteArray(reinterpret_cast<const char *>(modsEntries[p].md5), 16), p);
+    }
+}
+
+bool Misc::checkGameFilesSub(FileStream *fs, QStringList &files, const MD5Table &entries,
+                             const QHash<QByteArray, int> &knownDigests, MD5Cache &md5Cache,
                              int &lastProgress, int &progress, int allFilesCount,
                              QString &errors, QStringList &mods,
                              ProgressCallback callback, void *callbackHandle)
 {
     int vanilla = true;
-    for (int index = 0; index < files.count(); index++)
+    int batchSize = omp_get_max_threads() * 4;
+    QVector<QByteArray> digests;
+    for (int batchStart = 0; batchStart < files.count(); batchStart += batchSize)
     {
 #ifdef GUI
         QApplication::processEvents();
 #endif
-        int newProgress = (index + progress) * 100 / allFilesCount;
-        if (lastProgress != newProgress)
-        {
-            lastProgress = newProgress;
-            if (g_ipc)
-            {
-                ConsoleWrite(QString("[IPC]TASK_PROGRESS ") + QString::number(newProgress));
-                ConsoleSync();
-            }
-        }
-        if (!g_ipc && !callback)
-        {
-            PINFO("Checking: " + files[index] + "\n");
-        }
-        if (callback)
+        int batchCount = qMin(batchSize, files.count() - batchStart);
+        digests.fill(QByteArray(), batchCount);
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int n = 0; n < batchCount; n++)
         {
-            callback(callbackHandle, newProgress, "Checking file: " + files[index]);
+            digests[n] = md5Cache.GetMD5(files[batchStart + n]);
         }
-        QByteArray md5 = calculateMD5(g_GameData->GamePath() + files[index]);
-        bool found = false;
-        for (int p = 0; p < entries.count(); p++)
+
+        for (int n = 0; n < batchCount; n++)
         {
-            if (memcmp(md5.data(), entries[p].md5, 16) == 0)
+            int index = batchStart + n;
+            int newProgress = (index + progress) * 100 / allFilesCount;
+            if (lastProgress != newProgress)
             {
-                found = true;
-                break;
+                lastProgress = newProgress;
+                if (g_ipc)
+                {
+                    IpcChannel::Progress(newProgress);
+                }
             }
-        }
-        if (found)
-            continue;
-
-        found = false;
-        for (int p = 0; p < modsEntriesSize; p++)
-        {
-            if (memcmp(md5.data(), modsEntries[p].md5, 16) == 0)
+            if (!g_ipc && !callback)
             {
-                found = true;
-                bool found2 = false;
-                for (int s = 0; s < mods.count(); s++)
+                PINFO("Checking: " + files[index] + "\n");
+            }
+            if (callback)
+            {
+                callback(callbackHandle, newProgress, "Checking file: " + files[index]);
+            }
+            const QByteArray &md5 = digests[n];
+            if (md5.size() == 16 && entries.FindDigest(reinterpret_cast<const quint8 *>(md5.constData())))
+                continue;
+            auto known = knownDigests.constFind(md5);
+            if (known != knownDigests.constEnd())
+            {
+                int p = known.value();
+                if (p != KnownDigestVanilla)
                 {
-                    if (AsciiStringMatch(mods[s], modsEntries[p].modName))
+                    bool found = false;
+                    for (int s = 0; s < mods.count(); s++)
                     {
-                        found2 = true;
-                        break;
+                        if (AsciiStringMatch(mods[s], modsEntries[p].modName))
+                        {
+                            found = true;
+                            break;
+                        }
                     }
+                    if (!found)
+                        mods.push_back(modsEntries[p].modName);
                 }
-                if (!found2)
-                    mods.push_back(modsEntries[p].modName);
-                break;
+                continue;
             }
-        }
-        if (found)
-            continue;
 
-        found = false;
-        for (int p = 0; p < badMODSize; p++)
-        {
-            if (memcmp(md5.data(), badMOD[p].md5, 16) == 0)
+            bool foundFile = false;
+            quint8 md5Entry[16];
+            auto range = entries.FindPath(files[index]);
+            for (auto it = range.first; it != range.second; it++)
             {
-                found = true;
-                break;
-            }
-        }
-        if (found)
-            continue;
-
-        bool foundFile = false;
-        quint8 md5Entry[16];
-        QString file = files[index].toLower();
-        auto range = std::equal_range(entries.begin(), entries.end(),
-                                      file, Resources::ComparePath());
-        for (auto it = range.first; it != range.second; it++)
-        {
-            if (!AsciiStringMatch(it->path, file))
-                break;
-            if (generateMd5Entries)
-            {
-                if (memcmp(md5.data(), it->md5, 16) == 0)
+                if (generateMd5Entries)
+                {
+                    if (memcmp(md5.data(), it->md5, 16) == 0)
+                    {
+                        foundFile = true;
+                        break;
+                    }
+                }
+                else
                 {
                     foundFile = true;
+                    memcpy(md5Entry, it->md5, 16);
                     break;
                 }
             }
-            else
-            {
-                foundFile = true;
-                memcpy(md5Entry, it->md5, 16);
-                break;
-            }
-        }
-        if (!generateMd5Entries && !foundFile)
-            continue;
-        if (generateMd5Entries && foundFile)
-            continue;
+            if (!generateMd5Entries && !foundFile)
+                continue;
+            if (generateMd5Entries && foundFile)
+                continue;
 
-        vanilla = false;
+            vanilla = false;
 
-        if (generateModsMd5Entries)
-        {
-            fs->WriteStringASCII(QString("{\n\"") + files[index] + "\",\n{ ");
-            for (int i = 0; i < md5.count(); i++)
+            if (generateModsMd5Entries)
             {
-                fs->WriteStringASCII(QString::asprintf("0x%02X, ", (quint8)md5[i]));
+                fs->WriteStringASCII(QString("{\n\"") + files[index] + "\",\n{ ");
+                for (int i = 0; i < md5.count(); i++)
+                {
+                    fs->WriteStringASCII(QString::asprintf("0x%02X, ", (quint8)md5[i]));
+                }
+                fs->WriteStringASCII("},\n\"\",\n},\n");
             }
-            fs->WriteStringASCII("},\n\"\",\n},\n");
-        }
-        if (generateMd5Entries)
-        {
-            fs->WriteStringASCII(QString("{\n\"") + files[index] + "\",\n{ ");
-            for (int i = 0; i < md5.count(); i++)
+            if (generateMd5Entries)
             {
-                fs->WriteStringASCII(QString::asprintf("0x%02X, ", (quint8)md5[i]));
+                fs->WriteStringASCII(QString("{\n\"") + files[index] + "\",\n{ ");
+                for (int i = 0; i < md5.count(); i++)
+                {
+                    fs->WriteStringASCII(QString::asprintf("0x%02X, ", (quint8)md5[i]));
+                }
+                fs->WriteStringASCII(QString("},\n") +
+                                     QString::number(QFile(g_GameData->GamePath() + files[index]).size()) + ",\n},\n");
             }
-            fs->WriteStringASCII(QString("},\n") +
-                                 QString::number(QFile(g_GameData->GamePath() + files[index]).size()) + ",\n},\n");
-        }
 
-        if (!generateMd5Entries && !generateModsMd5Entries)
-        {
-            errors += "File " + files[index] + " has wrong MD5 checksum: ";
-            for (int i = 0; i < md5.count(); i++)
+            if (!generateMd5Entries && !generateModsMd5Entries)
             {
-                errors += QString::asprintf("%02X", (quint8)md5[i]);
-            }
-            errors += ", expected: ";
-            for (unsigned char i : md5Entry)
-            {
-                errors += QString::asprintf("%02X", i);
-            }
-            errors += "\n";
-            if (g_ipc)
-            {
-                ConsoleWrite(QString("[IPC]ERROR ") + files[index]);
-                ConsoleSync();
+                errors += "File " + files[index] + " has wrong MD5 checksum: ";
+                for (int i = 0; i < md5.count(); i++)
+                {
+                    errors += QString::asprintf("%02X", (quint8)md5[i]);
+                }
+                errors += ", expected: ";
+                for (unsigned char i : md5Entry)
+                {
+                    errors += QString::asprintf("%02X", i);
+                }
+                errors += "\n";
+                if (g_ipc)
+                {
+                    IpcChannel::Send(IpcEvent::Error, files[index]);
+                }
             }
         }
     }
@@ -213,23 +217,10 @@ bool Misc::checkGameFilesSub(FileStream *fs, QStringList &files, QList<MD5FileEn
     return vanilla;
 }
 
-bool Misc::checkGameFiles(MeType gameType, Resources &resources, QString &errors, QStringList &mods,
+bool Misc::checkGameFiles(MeType gameType, QString &errors, QStringList &mods,
                             ProgressCallback callback, void *callbackHandle)
 {
-    QList<MD5FileEntry> entries;
-
-    if (gameType == MeType::ME1_TYPE)
-    {
-        entries += resources.entriesME1;
-    }
-    else if (gameType == MeType::ME2_TYPE)
-    {
-        entries += resources.entriesME2;
-    }
-    else if (gameType == MeType::ME3_TYPE)
-    {
-        entries += resources.entriesME3;
-    }
+    const MD5Table &entries = Resources::GetMD5Table(gameType);
 
     int progress = 0;
     int allFilesCount = g_GameData->packageFiles.count();
@@ -243,19 +234,25 @@ bool Misc::checkGameFiles(MeType gameType, Resources &resources, QString &errors
     if (generateMd5Entries)
         fs = new FileStream("MD5FileEntryME" + QString::number((int)gameType) + ".cpp", FileMode::Create, FileAccess::WriteOnly);
 
+    QHash<QByteArray, int> knownDigests;
+    buildKnownDigests(knownDigests);
+    g_GameData->ScanInventory();
+    MD5Cache md5Cache(gameType);
+
     int lastProgress = -1;
     bool vanilla = true;
     bool state;
-    state = checkGameFilesSub(fs, g_GameData->packageFiles, entries, lastProgress, progress, allFilesCount,
+    state = checkGameFilesSub(fs, g_GameData->packageFiles, entries, knownDigests, md5Cache, lastProgress, progress, allFilesCount,
                                 errors, mods, callback, callbackHandle);
     if (!state)
         vanilla = false;
-    state = checkGameFilesSub(fs, g_GameData->tfcFiles, entries, lastProgress, progress, allFilesCount,
+    state = checkGameFilesSub(fs, g_GameData->tfcFiles, entries, knownDigests, md5Cache, lastProgress, progress, allFilesCount,
                                 errors, mods, callback, callbackHandle);
     if (!state)
         vanilla = false;
-    state = checkGameFilesSub(fs, g_GameData->othersFiles, entries, lastProgress, progress, allFilesCount,
+    state = checkGameFilesSub(fs, g_GameData->othersFiles, entries, knownDigests, md5Cache, lastProgress, progress, allFilesCount,
                                 errors, mods, callback, callbackHandle);
+    md5Cache.Save();
 
     if (generateModsMd5Entries || generateMd5Entries)
     {
@@ -19,9 +19,11 @@
  *
  */
 
+#include <Misc/ImageBatch.h>
 #include <Misc/Misc.h>
 #include <MipMaps/MipMaps.h>
 #include <Wrappers.h>
+#include <Helpers/IpcChannel.h>
 #include <Helpers/MiscHelpers.h>
 #include <Helpers/Logs.h>
 
@@ -32,8 +34,7 @@ uint Misc::scanFilenameForCRC(const QString &inputFile)
     {
         if (g_ipc)
         {
-            ConsoleWrite(QString("[IPC]ERROR_FILE_NOT_COMPATIBLE ") + BaseName(inputFile));
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::ErrorFileNotCompatible, BaseName(inputFile));
         }
         else
         {
@@ -47,8 +48,7 @@ uint Misc::scanFilenameForCRC(const QString &inputFile)
     {
         if (g_ipc)
         {
-            ConsoleWrite(QString("[IPC]ERROR_FILE_NOT_COMPATIBLE ") + BaseName(inputFile));
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::ErrorFileNotCompatible, BaseName(inputFile));
         }
         else
         {
@@ -64,8 +64,7 @@ uint Misc::scanFilenameForCRC(const QString &inputFile)
     {
         if (g_ipc)
         {
-            ConsoleWrite(QString("[IPC]ERROR_FILE_NOT_COMPATIBLE ") + BaseName(inputFile));
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::ErrorFileNotCompatible, BaseName(inputFile));
         }
         else
         {
@@ -78,7 +77,7 @@ uint Misc::scanFilenameForCRC(const QString &inputFile)
     return crc;
 }
 
-bool Misc::CheckMEMHeader(FileStream &fs, const QString &file)
+bool Misc::CheckMEMHeader(Stream &fs, const QString &file)
 {
     uint tag = fs.ReadUInt32();
     uint version = fs.ReadUInt32();
@@ -94,15 +93,14 @@ bool Misc::CheckMEMHeader(FileStream &fs, const QString &file)
         }
         if (g_ipc)
         {
-            ConsoleWrite(QString("[IPC]ERROR_FILE_NOT_COMPATIBLE ") + BaseName(file));
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::ErrorFileNotCompatible, BaseName(file));
         }
         return false;
     }
     return true;
 }
 
-bool Misc::CheckMEMGameVersion(FileStream &fs, const QString &file, int gameId)
+bool Misc::CheckMEMGameVersion(Stream &fs, const QString &file, int gameId)
 {
     uint gameType = 0;
     fs.JumpTo(fs.ReadInt64());
@@ -111,8 +109,7 @@ bool Misc::CheckMEMGameVersion(FileStream &fs, const QString &file, int gameId)
     {
         if (g_ipc)
         {
-            ConsoleWrite(QString("[IPC]ERROR_FILE_NOT_COMPATIBLE ") + BaseName(file));
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::ErrorFileNotCompatible, BaseName(file));
         }
         else
         {
@@ -166,39 +163,62 @@ bool Misc::convertDataModtoMem(QFileInfoList &files, QString &memFilePath,
     outFs.WriteUInt32(TextureModVersion);
     outFs.WriteInt64(0); // filled later
 
-    int lastProgress = -1;
-    for (int n = 0; n < files.count(); n++)
+    struct ImageJob
     {
-#ifdef GUI
-        QApplication::processEvents();
-#endif
-        QString file = files[n].absoluteFilePath();
+        QString file;
+        uint crc;
+        TextureMapEntry f;
+        bool markToConvert;
+        bool bc7format;
+        bool forceHash;
+        int slot;
+    };
+    QVector<ImageJob> imageJobs;
+    QVector<qint64> estimates;
+    std::mutex outputLock;
+
+    auto reportFile = [&](const QString &file)
+    {
+        std::lock_guard<std::mutex> guard(outputLock);
         if (g_ipc)
         {
-            ConsoleWrite(QString("[IPC]PROCESSING_FILE ") + BaseName(file));
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::ProcessingFile, BaseName(file));
         }
         else
         {
             PINFO(QString("File: ") + BaseName(file) + "\n");
         }
-        int newProgress = (n * 100) / files.count();
+    };
+
+    int lastProgress = -1;
+    auto reportProgress = [&](int processed)
+    {
+        int newProgress = (processed * 100) / files.count();
         if (lastProgress != newProgress)
         {
             lastProgress = newProgress;
             if (g_ipc)
             {
-                ConsoleWrite(QString("[IPC]TASK_PROGRESS ") + QString::number(newProgress));
-                ConsoleSync();
+                IpcChannel::Progress(newProgress);
             }
             if (callback)
             {
                 callback(callbackHandle, newProgress, "Converting");
             }
         }
+    };
+
+    for (int n = 0; n < files.count(); n++)
+    {
+#ifdef GUI
+        QApplication::processEvents();
+#endif
+        QString file = files[n].absoluteFilePath();
+        reportProgress(n - imageJobs.count());
 
         if (file.endsWith(".mem", Qt::CaseInsensitive))
         {
+            reportFile(file);
             FileStream fs = FileStream(file, FileMode::Open, FileAccess::ReadOnly);
             if (!CheckMEMHeader(fs, file))
                 continue;
@@ -267,61 +287,15 @@ bool Misc::convertDataModtoMem(QFileInfoList &files, QString &memFilePath,
                 }
             }
 
-            Image image(file, ImageFormat::UnknownImageFormat);
-            if (forceHash)
-            {
-                f.width = image.getMipMaps().first()->getOrigWidth();
-                f.height = image.getMipMaps().first()->getOrigHeight();
-            }
-
-            if (!Misc::CheckImage(image, f, file, -1))
-                continue;
-
-            if (!forceHash)
-            {
-                PixelFormat newPixelFormat = f.pixfmt;
-                if (entryMarkToConvert)
-                {
-                    if (image.getPixelFormat() == PixelFormat::Internal && !image.isSource8Bits())
-                        image.convertInternalToRGBA10(true);
-                    newPixelFormat = changeTextureType(f.pixfmt, image.getPixelFormat(), f.type, bc7format);
-                    if (f.pixfmt == newPixelFormat)
-                        PINFO(QString("Warning for texture: ") + BaseName(file)  +
-                              " This texture can not be converted to desired format...\n");
-                }
-
-                int numMips = Misc::GetNumberOfMipsFromMap(f);
-                CorrectTexture(image, f, numMips, newPixelFormat, file, bc7quality);
-            }
-            else if (image.getPixelFormat() == PixelFormat::Internal)
-            {
-                PINFO(QString("Warning for texture: ") + BaseName(file) +
-                      " This texture can not be included as non-DDS...\n");
-                continue;
-            }
-
-            auto data = image.StoreImageToDDS();
-            FileMod fileMod{};
-            fileMod.tag = FileTextureTag;
-            fileMod.name = f.name;
-            std::unique_ptr<Stream> dst (new MemoryStream());
-            Misc::compressData(data, *dst, fastMode ? CompressionDataType::Zlib : CompressionDataType::LZMA);
-            data.Free();
-            dst->SeekBegin();
-            fileMod.offset = outFs.Position();
-            fileMod.size = dst->Length();
-            quint32 textureFlags{};
-            if (entryMarkToConvert)
-                textureFlags |= (quint32)ModTextureFlags::MarkToConvert;
-            if (forceHash)
-                textureFlags |= (quint32)ModTextureFlags::ForceHash;
-            outFs.WriteUInt32(textureFlags);
-            outFs.WriteUInt32(crc);
-            outFs.CopyFrom(*dst, dst->Length());
-            modFiles.push_back(fileMod);
+            // Conversion is deferred to the batch below, the slot keeps order of entries
+            ImageJob job{ file, crc, f, entryMarkToConvert, bc7format, forceHash, modFiles.count() };
+            imageJobs.push_back(job);
+            estimates.push_back(ImageBatch::EstimateMemory(f.width, f.height, f.pixfmt, files[n].size()));
+            modFiles.push_back(FileMod{});
         }
         else if (file.endsWith(".bik", Qt::CaseInsensitive))
         {
+            reportFile(file);
             TextureMapEntry f;
 
             uint crc = scanFilenameForCRC(file);
@@ -353,8 +327,7 @@ bool Misc::convertDataModtoMem(QFileInfoList &files, QString &memFilePath,
             {
                 if (g_ipc)
                 {
-                    ConsoleWrite(QString("[IPC]ERROR_FILE_NOT_COMPATIBLE ") + BaseName(file));
-                    ConsoleSync();
+                    IpcChannel::Send(IpcEvent::ErrorFileNotCompatible, BaseName(file));
                 }
                 else
                 {
@@ -372,8 +345,7 @@ bool Misc::convertDataModtoMem(QFileInfoList &files, QString &memFilePath,
                 {
                     if (g_ipc)
                     {
-                        ConsoleWrite(QString("[IPC]ERROR_FILE_NOT_COMPATIBLE ") + BaseName(file));
-                        ConsoleSync();
+                        IpcChannel::Send(IpcEvent::ErrorFileNotCompatible, BaseName(file));
                     }
                     else
                     {
@@ -403,6 +375,84 @@ bool Misc::convertDataModtoMem(QFileInfoList &files, QString &memFilePath,
             outFs.CopyFrom(*dst, dst->Length());
             modFiles.push_back(fileMod);
         }
+        else
+        {
+            reportFile(file);
+        }
+    }
+
+    int processedFiles = files.count() - imageJobs.count();
+    ImageBatch::Run(estimates, [&](int index)
+    {
+        const ImageJob &job = imageJobs.at(index);
+        reportFile(job.file);
+
+        TextureMapEntry f = job.f;
+        Image image(job.file, ImageFormat::UnknownImageFormat);
+        if (job.forceHash)
+        {
+            f.width = image.getMipMaps().first()->getOrigWidth();
+            f.height = image.getMipMaps().first()->getOrigHeight();
+        }
+
+        if (!Misc::CheckImage(image, f, job.file, -1))
+            return;
+
+        if (!job.forceHash)
+        {
+            PixelFormat newPixelFormat = f.pixfmt;
+            if (job.markToConvert)
+            {
+                if (image.getPixelFormat() == PixelFormat::Internal && !image.isSource8Bits())
+                    image.convertInternalToRGBA10(true);
+                newPixelFormat = changeTextureType(f.pixfmt, image.getPixelFormat(), f.type, job.bc7format);
+                if (f.pixfmt == newPixelFormat)
+                    PINFO(QString("Warning for texture: ") + BaseName(job.file)  +
+                          " This texture can not be converted to desired format...\n");
+            }
+
+            int numMips = Misc::GetNumberOfMipsFromMap(f);
+            CorrectTexture(image, f, numMips, newPixelFormat, job.file, bc7quality);
+        }
+        else if (image.getPixelFormat() == PixelFormat::Internal)
+        {
+            PINFO(QString("Warning for texture: ") + BaseName(job.file) +
+                  " This texture can not be included as non-DDS...\n");
+            return;
+        }
+
+        auto data = image.StoreImageToDDS();
+        std::unique_ptr<Stream> dst (new MemoryStream());
+        Misc::compressData(data, *dst, fastMode ? CompressionDataType::Zlib : CompressionDataType::LZMA);
+        data.Free();
+        dst->SeekBegin();
+        quint32 textureFlags{};
+        if (job.markToConvert)
+            textureFlags |= (quint32)ModTextureFlags::MarkToConvert;
+        if (job.forceHash)
+            textureFlags |= (quint32)ModTextureFlags::ForceHash;
+
+        std::lock_guard<std::mutex> guard(outputLock);
+        FileMod &fileMod = modFiles[job.slot];
+        fileMod.tag = FileTextureTag;
+        fileMod.name = f.name;
+        fileMod.offset = outFs.Position();
+        fileMod.size = dst->Length();
+        outFs.WriteUInt32(textureFlags);
+        outFs.WriteUInt32(job.crc);
+        outFs.CopyFrom(*dst, dst->Length());
+    }, [&](int completed, int)
+    {
+#ifdef GUI
+        QApplication::processEvents();
+#endif
+        reportProgress(processedFiles + completed);
+    });
+
+    for (int i = modFiles.count() - 1; i >= 0; i--)
+    {
+        if (modFiles[i].tag == 0)
+            modFiles.removeAt(i);
     }
 
     if (modFiles.count() == 0)
@@ -412,8 +462,7 @@ bool Misc::convertDataModtoMem(QFileInfoList &files, QString &memFilePath,
             QFile(memFilePath).remove();
         if (g_ipc)
         {
-            ConsoleWrite("[IPC]ERROR_NO_BUILDABLE_FILES");
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::ErrorNoBuildableFiles);
             return true;
         }
 
@@ -477,8 +526,7 @@ bool Misc::extractMEM(MeType gameId, QFileInfoList &inputList, QString &outputDi
     {
         if (g_ipc)
         {
-            ConsoleWrite(QString("[IPC]PROCESSING_FILE ") + file.fileName());
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::ProcessingFile, file.fileName());
         }
         else
         {
@@ -528,8 +576,7 @@ bool Misc::extractMEM(MeType gameId, QFileInfoList &inputList, QString &outputDi
             {
                 if (g_ipc)
                 {
-                    ConsoleWrite(QString("[IPC]ERROR_FILE_NOT_COMPATIBLE ") + file.absoluteFilePath());
-                    ConsoleSync();
+                    IpcChannel::Send(IpcEvent::ErrorFileNotCompatible, file.absoluteFilePath());
                 }
                 PERROR(QString("Unknown tag for file: ") + QString::number(i + 1) + " of " +
                        QString::number(numFiles) + "\n");
@@ -545,8 +592,7 @@ bool Misc::extractMEM(MeType gameId, QFileInfoList &inputList, QString &outputDi
                 lastProgress = newProgress;
                 if (g_ipc)
                 {
-                    ConsoleWrite(QString("[IPC]TASK_PROGRESS ") + QString::number(newProgress));
-                    ConsoleSync();
+                    IpcChannel::Progress(newProgress);
                 }
                 if (callback)
                 {
@@ -559,8 +605,7 @@ bool Misc::extractMEM(MeType gameId, QFileInfoList &inputList, QString &outputDi
             {
                 if (g_ipc)
                 {
-                    ConsoleWrite(QString("[IPC]ERROR_FILE_NOT_COMPATIBLE ") + file.absoluteFilePath());
-                    ConsoleSync();
+                    IpcChannel::Send(IpcEvent::ErrorFileNotCompatible, file.absoluteFilePath());
                 }
                 PERROR(QString("Failed decompress data: ") + file.absoluteFilePath() + "\n");
                 PERROR("Extract MEM mod files failed.\n\n");
@@ -24,7 +24,10 @@
 #include <GameData/TOCFile.h>
 #include <GameData/UserSettings.h>
 #include <MipMaps/MipMaps.h>
+#include <Texture/TextureMapView.h>
 #include <Wrappers.h>
+#include <Helpers/ArchiveStream.h>
+#include <Helpers/IpcChannel.h>
 #include <Helpers/MiscHelpers.h>
 #include <Helpers/Logs.h>
 #include <Helpers/FileStream.h>
@@ -33,9 +36,12 @@ bool Misc::applyMods(QStringList &files, QList<TextureMapEntry> &textures,
                      QStringList &pkgsToMarker,
                      MipMaps &mipMaps, bool appendMarker,
                      bool verify, int cacheAmount,
-                     ProgressCallback callback, void *callbackHandle)
+                     ProgressCallback callback, void *callbackHandle,
+                     TextureMapView *mapView)
 {
     bool status = true;
+    // With map view only textures touched by mods are copied to the list
+    QSet<uint> mappedTextures;
 
     int totalNumberOfMods = 0;
     int currentNumberOfTotalMods = 1;
@@ -46,12 +52,24 @@ bool Misc::applyMods(QStringList &files, QList<TextureMapEntry> &textures,
 
     for (int i = 0; i < files.count(); i++)
     {
-        if (QFile(files[i]).size() == 0)
+        std::unique_ptr<Stream> fs = ArchiveStream::OpenRead(files[i]);
+        if (!fs)
         {
             if (g_ipc)
             {
-                ConsoleWrite(QString("[IPC]ERROR MEM mod file has 0 length: ") + files[i]);
-                ConsoleSync();
+                IpcChannel::Send(IpcEvent::Error, QString("Failed to open MEM mod file: ") + files[i]);
+            }
+            else
+            {
+                PERROR(QString("Failed to open MEM mod file: ") + files[i] + "\n");
+            }
+            continue;
+        }
+        if (fs->Length() == 0)
+        {
+            if (g_ipc)
+            {
+                IpcChannel::Send(IpcEvent::Error, QString("MEM mod file has 0 length: ") + files[i]);
             }
             else
             {
@@ -59,20 +77,18 @@ bool Misc::applyMods(QStringList &files, QList<TextureMapEntry> &textures,
             }
             continue;
         }
-        FileStream fs = FileStream(files[i], FileMode::Open, FileAccess::ReadOnly);
-        if (!Misc::CheckMEMHeader(fs, files[i]))
+        if (!Misc::CheckMEMHeader(*fs, files[i]))
             continue;
-        fs.JumpTo(fs.ReadInt64());
-        fs.SkipInt32();
-        totalNumberOfMods += fs.ReadInt32();
+        fs->JumpTo(fs->ReadInt64());
+        fs->SkipInt32();
+        totalNumberOfMods += fs->ReadInt32();
     }
 
     for (int i = 0; i < files.count(); i++)
     {
         if (g_ipc)
         {
-            ConsoleWrite(QString("[IPC]PROCESSING_FILE ") + files[i]);
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::ProcessingFile, files[i]);
         }
         else
         {
@@ -80,43 +96,55 @@ bool Misc::applyMods(QStringList &files, QList<TextureMapEntry> &textures,
                          QString::number(files.count()) + " - " + BaseName(files[i]) + "\n");
         }
 
-        FileStream fs = FileStream(files[i], FileMode::Open, FileAccess::ReadOnly);
-        if (!Misc::CheckMEMHeader(fs, files[i]))
+        std::unique_ptr<Stream> fs = ArchiveStream::OpenRead(files[i]);
+        if (!fs || !Misc::CheckMEMHeader(*fs, files[i]))
             continue;
 
-        if (!Misc::CheckMEMGameVersion(fs, files[i], GameData::gameType))
+        if (!Misc::CheckMEMGameVersion(*fs, files[i], GameData::gameType))
             continue;
 
-        int numFiles = fs.ReadInt32();
+        // Stored archive entries are addressed directly inside the archive file
+        QString memPath = files[i];
+        quint64 memBaseOffset = 0;
+        if (ArchiveStream::IsEntryPath(files[i]))
+        {
+            auto archiveStream = static_cast<ArchiveStream *>(fs.get());
+            if (archiveStream->isStored())
+            {
+                memPath = ArchiveStream::ArchiveFromEntryPath(files[i]);
+                memBaseOffset = archiveStream->StoredDataOffset();
+            }
+        }
+
+        int numFiles = fs->ReadInt32();
         QList<FileMod> modFiles{};
         for (int k = 0; k < numFiles; k++)
         {
             FileMod fileMod{};
-            fileMod.tag = fs.ReadUInt32();
-            fs.ReadStringASCIINull(fileMod.name);
-            fileMod.offset = fs.ReadInt64();
-            fileMod.size = fs.ReadInt64();
-            fileMod.flags = fs.ReadInt64();
+            fileMod.tag = fs->ReadUInt32();
+            fs->ReadStringASCIINull(fileMod.name);
+            fileMod.offset = fs->ReadInt64();
+            fileMod.size = fs->ReadInt64();
+            fileMod.flags = fs->ReadInt64();
             modFiles.push_back(fileMod);
         }
         numFiles = modFiles.count();
         for (int l = 0; l < numFiles; l++, currentNumberOfTotalMods++)
         {
             quint32 crc = 0, textureFlags = 0;
-            fs.JumpTo(modFiles[l].offset);
+            fs->JumpTo(modFiles[l].offset);
             long size = modFiles[l].size;
             if (modFiles[l].tag == FileTextureTag ||
                 modFiles[l].tag == FileMovieTextureTag)
             {
-                textureFlags = fs.ReadUInt32();
-                crc = fs.ReadUInt32();
+                textureFlags = fs->ReadUInt32();
+                crc = fs->ReadUInt32();
             }
             else
             {
                 if (g_ipc)
                 {
-                    ConsoleWrite(QString("[IPC]ERROR Unknown tag for file: ") + modFiles[l].name);
-                    ConsoleSync();
+                    IpcChannel::Send(IpcEvent::Error, QString("Unknown tag for file: ") + modFiles[l].name);
                 }
                 else
                 {
@@ -128,7 +156,20 @@ bool Misc::applyMods(QStringList &files, QList<TextureMapEntry> &textures,
             if (modFiles[l].tag == FileTextureTag ||
                 modFiles[l].tag == FileMovieTextureTag)
             {
-                TextureMapEntry f = Misc::FoundTextureInTheMap(textures, crc);
+                TextureMapEntry f;
+                if (mapView)
+                {
+                    f = Misc::FoundTextureInTheMap(*mapView, crc);
+                    if (f.crc != 0 && !mappedTextures.contains(f.crc))
+                    {
+                        mappedTextures.insert(f.crc);
+                        textures.push_back(f);
+                    }
+                }
+                else
+                {
+                    f = Misc::FoundTextureInTheMap(textures, crc);
+                }
                 if (f.crc != 0)
                 {
                     ModEntry entry{};
@@ -136,8 +177,8 @@ bool Misc::applyMods(QStringList &files, QList<TextureMapEntry> &textures,
                     entry.textureName = f.name;
                     if (textureFlags & ModTextureFlags::MarkToConvert)
                         entry.markConvert = true;
-                    entry.memPath = files[i];
-                    entry.memEntryOffset = fs.Position();
+                    entry.memPath = memPath;
+                    entry.memEntryOffset = memBaseOffset + fs->Position();
                     entry.memEntrySize = size;
                     entry.injectedTexture = nullptr;
                     modsToReplace.push_back(entry);
@@ -160,8 +201,7 @@ bool Misc::applyMods(QStringList &files, QList<TextureMapEntry> &textures,
     long elapsed = Misc::elapsedStageTime();
     if (g_ipc)
     {
-        ConsoleWrite(QString("[IPC]STAGE_TIMING %1").arg(elapsed));
-        ConsoleSync();
+        IpcChannel::Send(IpcEvent::StageTiming, QString("%1").arg(elapsed));
     }
 
     if (verify)
@@ -169,8 +209,7 @@ bool Misc::applyMods(QStringList &files, QList<TextureMapEntry> &textures,
         Misc::restartStageTimer();
         if (g_ipc)
         {
-            ConsoleWrite("[IPC]STAGE_CONTEXT STAGE_VERIFYTEXTURES");
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::StageContext, "STAGE_VERIFYTEXTURES");
         }
         else
         {
@@ -182,15 +221,14 @@ bool Misc::applyMods(QStringList &files, QList<TextureMapEntry> &textures,
         long elapsed = Misc::elapsedStageTime();
         if (g_ipc)
         {
-            ConsoleWrite(QString("[IPC]STAGE_TIMING %1").arg(elapsed));
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::StageTiming, QString("%1").arg(elapsed));
         }
     }
 
     return status;
 }
 
-bool Misc::InstallMods(MeType gameId, Resources &resources, QStringList &modFiles,
+bool Misc::InstallMods(MeType gameId, QStringList &modFiles,
                        bool guiInstallerMode, bool alotInstallerMode,
                        bool skipMarkers, bool verify, int cacheAmount,
                        ProgressCallback callback, void *callbackHandle)
@@ -228,18 +266,18 @@ bool Misc::InstallMods(MeType gameId, Resources &resources, QStringList &modFile
     {
         if (!modded)
         {
-            ConsoleWrite("[IPC]STAGE_ADD STAGE_PRESCAN");
-            ConsoleWrite("[IPC]STAGE_ADD STAGE_SCAN");
+            IpcChannel::Send(IpcEvent::StageAdd, "STAGE_PRESCAN");
+            IpcChannel::Send(IpcEvent::StageAdd, "STAGE_SCAN");
         }
-        ConsoleWrite("[IPC]STAGE_ADD STAGE_INSTALLTEXTURES");
+        IpcChannel::Send(IpcEvent::StageAdd, "STAGE_INSTALLTEXTURES");
         if (verify)
-            ConsoleWrite("[IPC]STAGE_ADD STAGE_VERIFYTEXTURES");
+            IpcChannel::Send(IpcEvent::StageAdd, "STAGE_VERIFYTEXTURES");
         if (!skipMarkers && !modded)
-            ConsoleWrite("[IPC]STAGE_ADD STAGE_MARKERS");
-        ConsoleSync();
+            IpcChannel::Send(IpcEvent::StageAdd, "STAGE_MARKERS");
     }
 
     QList<TextureMapEntry> textures;
+    TextureMapView mapView;
 
     if (!modded)
     {
@@ -252,7 +290,7 @@ bool Misc::InstallMods(MeType gameId, Resources &resources, QStringList &modFile
         pkgsToMarker.removeOne(g_GameData->MainData() + "/SFXTest.pcc");
 
         PINFO("Scan textures started...\n");
-        if (!TreeScan::PrepareListOfTextures(gameId, resources, textures, true,
+        if (!TreeScan::PrepareListOfTextures(gameId, textures, true,
                                         callback, callbackHandle))
         {
             PERROR("Failed to scan textures!\n");
@@ -265,20 +303,20 @@ bool Misc::InstallMods(MeType gameId, Resources &resources, QStringList &modFile
     PINFO("Process textures started...\n");
     if (g_ipc)
     {
-        ConsoleWrite("[IPC]STAGE_CONTEXT STAGE_INSTALLTEXTURES");
-        ConsoleSync();
+        IpcChannel::Send(IpcEvent::StageContext, "STAGE_INSTALLTEXTURES");
     }
     if (modded)
     {
         QString path = QStandardPaths::standardLocations(QStandardPaths::GenericConfigLocation).first() +
                 "/MassEffectModder";
         QString mapFile = path + QString("/mele%1map.bin").arg((int)gameId);
-        if (!TreeScan::loadTexturesMapFile(mapFile, textures))
+        if (!TreeScan::openTexturesMapFile(mapFile, mapView, textures))
             return false;
     }
 
     Misc::applyMods(modFiles, textures, pkgsToMarker, mipMaps,
-                    true, verify, cacheAmount, callback, callbackHandle);
+                    true, verify, cacheAmount, callback, callbackHandle,
+                    mapView.isOpen() ? &mapView : nullptr);
 
 
 
@@ -291,12 +329,11 @@ bool Misc::InstallMods(MeType gameId, Resources &resources, QStringList &modFile
             return false;
     }
 
-    TOCBinFile::UpdateAllTOCBinFiles(gameId);
+    TOCBinFile::UpdateChangedTOCBinFiles(gameId);
 
     if (g_ipc)
     {
-        ConsoleWrite("[IPC]STAGE_CONTEXT STAGE_DONE");
-        ConsoleSync();
+        IpcChannel::Send(IpcEvent::StageContext, "STAGE_DONE");
     }
 
     long elapsed = Misc::elapsedTime();
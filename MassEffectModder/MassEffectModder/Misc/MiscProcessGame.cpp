@@ -21,11 +21,14 @@
 
 #include <Misc/Misc.h>
 #include <GameData/GameData.h>
+#include <GameData/MarkersManifest.h>
 #include <GameData/TOCFile.h>
 #include <MipMaps/MipMaps.h>
 #include <Wrappers.h>
 #include <Md5/MD5ModEntries.h>
 #include <Md5/MD5BadEntries.h>
+#include <Md5/MD5Cache.h>
+#include <Helpers/IpcChannel.h>
 #include <Helpers/MiscHelpers.h>
 #include <Helpers/Logs.h>
 #include <Helpers/FileStream.h>
@@ -44,6 +47,7 @@ void Misc::applyModTag(QStringList &mods)
     }
     marker.SeekBegin();
     FileStream fs = FileStream(g_GameData->MainData() + "/SFXTest.pcc", FileMode::Open, FileAccess::ReadWrite);
+    TOCBinFile::RegisterChangedFile(g_GameData->MainData() + "/SFXTest.pcc");
     fs.SeekEnd();
     fs.CopyFrom(marker, marker.Length());
     fs.WriteInt32(marker.Length());
@@ -65,41 +69,52 @@ bool Misc::CheckForMarkers(ProgressCallback callback, void *callbackHandle)
         packages.push_back(g_GameData->packageFiles[i]);
     }
 
+    MarkersManifest manifest(GameData::gameType);
+    int batchSize = omp_get_max_threads() * MarkersBatchFactor;
+    QVector<bool> markers;
     int lastProgress = -1;
-    for (int i = 0; i < packages.count(); i++)
+    for (int batchStart = 0; batchStart < packages.count(); batchStart += batchSize)
     {
-        int newProgress = (i + 1) * 100 / packages.count();
-        if ((newProgress - lastProgress) >= 5)
+        int batchCount = qMin(batchSize, packages.count() - batchStart);
+        markers.fill(false, batchCount);
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int n = 0; n < batchCount; n++)
         {
-            lastProgress = newProgress;
-            if (g_ipc)
-            {
-                ConsoleWrite(QString("[IPC]TASK_PROGRESS ") + QString::number(newProgress));
-                ConsoleSync();
-            }
-            else if (callback)
-            {
-                callback(callbackHandle, newProgress, "Checking markers");
-            }
+            markers[n] = manifest.HasMarker(packages[batchStart + n]);
         }
 
-        FileStream fs = FileStream(g_GameData->GamePath() + packages[i], FileMode::Open, FileAccess::ReadOnly);
-        fs.Seek(-MEMMarkerLength, SeekOrigin::End);
-        QString marker;
-        fs.ReadStringASCII(marker, MEMMarkerLength);
-        if (marker == QString(MEMendFileMarker))
+        for (int n = 0; n < batchCount; n++)
         {
-            if (g_ipc)
+            int i = batchStart + n;
+            int newProgress = (i + 1) * 100 / packages.count();
+            if ((newProgress - lastProgress) >= 5)
             {
-                ConsoleWrite(QString("[IPC]ERROR_FILEMARKER_FOUND ") + packages[i]);
-                ConsoleSync();
+                lastProgress = newProgress;
+                if (g_ipc)
+                {
+                    IpcChannel::Progress(newProgress);
+                }
+                else if (callback)
+                {
+                    callback(callbackHandle, newProgress, "Checking markers");
+                }
             }
-            else
+
+            if (markers[n])
             {
-                PERROR(QString("Error: detected marker: ") + packages[i] + "\n");
+                if (g_ipc)
+                {
+                    IpcChannel::Send(IpcEvent::ErrorFileMarkerFound, packages[i]);
+                }
+                else
+                {
+                    PERROR(QString("Error: detected marker: ") + packages[i] + "\n");
+                }
             }
         }
     }
+    manifest.Save();
 
     return true;
 }
@@ -115,10 +130,13 @@ bool Misc::MarkersPresent(ProgressCallback callback, void *callbackHandle)
         packages.push_back(g_GameData->packageFiles[i]);
     }
 
+    MarkersManifest manifest(GameData::gameType);
+    int batchSize = omp_get_max_threads() * MarkersBatchFactor;
     int lastProgress = -1;
-    for (int i = 0; i < packages.count(); i++)
+    for (int batchStart = 0; batchStart < packages.count(); batchStart += batchSize)
     {
-        int newProgress = (i + 1) * 100 / packages.count();
+        int batchCount = qMin(batchSize, packages.count() - batchStart);
+        int newProgress = (batchStart + batchCount) * 100 / packages.count();
         if ((newProgress - lastProgress) >= 5)
         {
             lastProgress = newProgress;
@@ -128,27 +146,36 @@ bool Misc::MarkersPresent(ProgressCallback callback, void *callbackHandle)
             }
         }
 
-        FileStream fs = FileStream(g_GameData->GamePath() + packages[i], FileMode::Open, FileAccess::ReadOnly);
-        fs.Seek(-MEMMarkerLength, SeekOrigin::End);
-        QString marker;
-        fs.ReadStringASCII(marker, MEMMarkerLength);
-        if (marker == QString(MEMendFileMarker))
+        bool found = false;
+        #pragma omp parallel for schedule(dynamic)
+        for (int n = 0; n < batchCount; n++)
         {
+            if (manifest.HasMarker(packages[batchStart + n]))
+            {
+                #pragma omp atomic write
+                found = true;
+            }
+        }
+        if (found)
+        {
+            manifest.Save();
             return true;
         }
     }
+    manifest.Save();
 
     return false;
 }
 
 void Misc::detectBrokenMod(QStringList &mods)
 {
+    MD5Cache md5Cache(GameData::gameType);
     for (int l = 0; l < badMODSize; l++)
     {
         QString path = g_GameData->GamePath() + badMOD[l].path;
         if (!QFile(path).exists())
             continue;
-        QByteArray md5 = calculateMD5(path);
+        QByteArray md5 = md5Cache.GetMD5(badMOD[l].path);
         if (memcmp(md5.data(), badMOD[l].md5, 16) == 0)
         {
             bool found = false;
@@ -164,6 +191,7 @@ void Misc::detectBrokenMod(QStringList &mods)
                 mods.push_back(badMOD[l].modName);
         }
     }
+    md5Cache.Save();
 }
 
 bool Misc::ReportBadMods()
@@ -178,8 +206,7 @@ bool Misc::ReportBadMods()
         {
             if (g_ipc)
             {
-                ConsoleWrite(QString("[IPC]ERROR ") + badMods[l]);
-                ConsoleSync();
+                IpcChannel::Send(IpcEvent::Error, badMods[l]);
             }
             else
             {
@@ -203,8 +230,7 @@ bool Misc::ReportMods()
         {
             if (g_ipc)
             {
-                ConsoleWrite(QString("[IPC]MOD ") + mods[l]);
-                ConsoleSync();
+                IpcChannel::Send(IpcEvent::Mod, mods[l]);
             }
             else
             {
@@ -231,43 +257,40 @@ void Misc::AddMarkers(QStringList &pkgsToMarker,
     Misc::restartStageTimer();
     if (g_ipc)
     {
-        ConsoleWrite("[IPC]STAGE_CONTEXT STAGE_MARKERS");
-        ConsoleSync();
+        IpcChannel::Send(IpcEvent::StageContext, "STAGE_MARKERS");
     }
+    MarkersManifest manifest(GameData::gameType);
+    int batchSize = omp_get_max_threads() * MarkersBatchFactor;
     int lastProgress = -1;
-    for (int i = 0; i < pkgsToMarker.count(); i++)
+    for (int batchStart = 0; batchStart < pkgsToMarker.count(); batchStart += batchSize)
     {
-        int newProgress = (i + 1) * 100 / pkgsToMarker.count();
+        int batchCount = qMin(batchSize, pkgsToMarker.count() - batchStart);
+        int newProgress = (batchStart + batchCount) * 100 / pkgsToMarker.count();
         if ((newProgress - lastProgress) >= 10)
         {
             lastProgress = newProgress;
             if (g_ipc)
             {
-                ConsoleWrite(QString("[IPC]TASK_PROGRESS ") + QString::number(newProgress));
-                ConsoleSync();
+                IpcChannel::Progress(newProgress);
             }
             else if (callback)
             {
                 callback(callbackHandle, newProgress, "Adding markers");
             }
         }
-        PDEBUG(QString("Misc::AddMarkers File: ") + pkgsToMarker[i] + "\n");
-        FileStream fs = FileStream(g_GameData->GamePath() + pkgsToMarker[i], FileMode::Open, FileAccess::ReadWrite);
-        fs.Seek(-MEMMarkerLength, SeekOrigin::End);
-        QString marker;
-        fs.ReadStringASCII(marker, MEMMarkerLength);
-        QString str(MEMendFileMarker);
-        if (marker != str)
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int n = 0; n < batchCount; n++)
         {
-            fs.SeekEnd();
-            fs.WriteStringASCII(str);
+            PDEBUG(QString("Misc::AddMarkers File: ") + pkgsToMarker[batchStart + n] + "\n");
+            manifest.AddMarker(pkgsToMarker[batchStart + n]);
         }
     }
+    manifest.Save();
     long elapsed = Misc::elapsedStageTime();
     if (g_ipc)
     {
-        ConsoleWrite(QString("[IPC]STAGE_TIMING %1").arg(elapsed));
-        ConsoleSync();
+        IpcChannel::Send(IpcEvent::StageTiming, QString("%1").arg(elapsed));
     }
     PINFO("Adding markers finished.\n\n");
 }
@@ -275,12 +298,13 @@ void Misc::AddMarkers(QStringList &pkgsToMarker,
 
 void Misc::detectMods(QStringList &mods)
 {
+    MD5Cache md5Cache(GameData::gameType);
     for (int l = 0; l < modsEntriesSize; l++)
     {
         QString path = g_GameData->GamePath() + modsEntries[l].path;
         if (!QFile(path).exists())
             continue;
-        QByteArray md5 = calculateMD5(path);
+        QByteArray md5 = md5Cache.GetMD5(modsEntries[l].path);
         if (memcmp(md5.data(), modsEntries[l].md5, 16) == 0)
         {
             bool found = false;
@@ -296,12 +320,25 @@ void Misc::detectMods(QStringList &mods)
                 mods.push_back(modsEntries[l].modName);
         }
     }
+    md5Cache.Save();
 }
 
-QByteArray Misc::calculateMD5(const QString &filePath)
+bool Misc::calculateMD5(const QString &filePath, QByteArray &md5)
 {
+    md5 = QByteArray(16, 0);
     QFile file(filePath);
-    if (file.open(QIODevice::ReadOnly))
-        return QCryptographicHash::hash(file.readAll(), QCryptographicHash::Md5);
-    return QByteArray(16, 0);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    std::unique_ptr<char[]> buffer(new char[MD5ReadBlockSize]);
+    qint64 bytesRead;
+    while ((bytesRead = file.read(buffer.get(), MD5ReadBlockSize)) > 0)
+    {
+        hash.addData(buffer.get(), static_cast<int>(bytesRead));
+    }
+    if (bytesRead < 0)
+        return false;
+    md5 = hash.result();
+    return true;
 }
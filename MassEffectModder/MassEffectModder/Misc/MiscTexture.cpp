@@ -20,9 +20,11 @@
  */
 
 #include <Misc/Misc.h>
+#include <Helpers/IpcChannel.h>
 #include <Helpers/MiscHelpers.h>
 #include <Helpers/Logs.h>
 #include <Resources/Resources.h>
+#include <Texture/TextureMapView.h>
 
 PixelFormat Misc::changeTextureType(PixelFormat gamePixelFormat, PixelFormat texturePixelFormat, TextureType flags, bool bc7format)
 {
@@ -84,23 +86,29 @@ TextureMapEntry Misc::FoundTextureInTheMap(QList<TextureMapEntry> &textures, uin
     return f;
 }
 
+TextureMapEntry Misc::FoundTextureInTheMap(TextureMapView &mapView, uint crc)
+{
+    TextureMapEntry f{};
+    int index = mapView.FindTexture(crc);
+    if (index != -1)
+        mapView.GetTexture(index, f);
+    return f;
+}
+
 TextureMapEntry Misc::FoundTextureInTheInternalMap(MeType gameId, uint crc)
 {
-    QList<TextureMapEntry> textures;
-    Resources resources;
-    resources.loadMD5Tables();
-    TreeScan::loadTexturesMap(gameId, resources, textures);
+    static QList<TextureMapEntry> textures[3];
+    static std::once_flag loaded[3];
 
-    TextureMapEntry f{};
-    for (int s = 0; s < textures.count(); s++)
+    int index = (int)gameId - (int)MeType::ME1_TYPE;
+    if (index < 0 || index >= 3)
+        CRASH();
+    std::call_once(loaded[index], [gameId, index]
     {
-        if (textures[s].crc == crc)
-        {
-            f = textures[s];
-            break;
-        }
-    }
-    return f;
+        TreeScan::loadTexturesMap(gameId, textures[index]);
+    });
+
+    return FoundTextureInTheMap(textures[index], crc);
 }
 
 uint Misc::GetCRCFromTextureMap(QList<TextureMapEntry> &textures, int exportId,
@@ -131,8 +139,7 @@ bool Misc::CorrectTexture(Image &image, TextureMapEntry &f, int numMips,
     {
         if (g_ipc)
         {
-            ConsoleWrite(QString("[IPC]PROCESSING_FILE Converting ") + BaseName(file));
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::ProcessingFile, QString("Converting ") + BaseName(file));
         }
         else
         {
@@ -195,8 +202,7 @@ bool Misc::CheckImage(Image &image, TextureMapEntry &f, const QString &file, int
     {
         if (g_ipc)
         {
-            ConsoleWrite(QString("[IPC]ERROR_FILE_NOT_COMPATIBLE ") + BaseName(file));
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::ErrorFileNotCompatible, BaseName(file));
         }
         else
         {
@@ -218,8 +224,7 @@ bool Misc::CheckImage(Image &image, TextureMapEntry &f, const QString &file, int
     {
         if (g_ipc)
         {
-            ConsoleWrite(QString("[IPC]ERROR_FILE_NOT_COMPATIBLE ") + BaseName(file));
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::ErrorFileNotCompatible, BaseName(file));
         }
         else
         {
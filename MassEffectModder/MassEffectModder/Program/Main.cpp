@@ -26,6 +26,7 @@
 #include <Gui/InstallerWindow.h>
 #include <Gui/Updater.h>
 #endif
+#include <Helpers/IpcChannel.h>
 #include <Helpers/Logs.h>
 #include <Helpers/MiscHelpers.h>
 #include <Program/SignalHandler.h>
@@ -179,6 +180,7 @@ int runQtApplication(int argc, char *argv[])
                   ).arg(MEM_VERSION).arg(MEM_YEAR));
 
     int status = ProcessArguments();
+    IpcChannel::Stop();
 #endif
     ReleaseGameData();
     return status;
@@ -203,6 +205,10 @@ int main(int argc, char *argv[])
 
     OodleUninitLib();
 
+#ifdef BYTEBUFFER_COPY_STATS
+    PDEBUG(QString("ByteBuffer: copied %1 bytes\n").arg(ByteBuffer::CopiedBytes().load()));
+#endif
+
     ReleaseLogs();
 
     return status;
@@ -23,6 +23,7 @@
 #include <iostream>
 #include <csignal>
 
+#include <Helpers/IpcChannel.h>
 #include <Helpers/Logs.h>
 #include <Helpers/MiscHelpers.h>
 #include <Wrappers.h>
@@ -82,12 +83,12 @@ void Exception(const char *file, const char *func, int line, const char *msg)
 
     if (g_ipc)
     {
-        string messageIpc = "[IPC]EXCEPTION_OCCURRED ";
+        string messageIpc;
         if (msg)
             messageIpc += "\"" + std::string(msg) + "\" ";
         messageIpc += std::string(func) + " at " + std::string(str) + ": line " + std::to_string(line);
-        ConsoleWrite(messageIpc.c_str());
-        ConsoleSync();
+        IpcChannel::Send(IpcEvent::ExceptionOccurred, messageIpc.c_str());
+        IpcChannel::Flush(true);
     }
 
     string messageStd = "Exception occurred!\n";
@@ -101,6 +102,7 @@ void Exception(const char *file, const char *func, int line, const char *msg)
     LogCrash(output, messageStd);
 
 #ifdef NDEBUG
+    IpcChannel::Stop(true);
     exit(1);
 #endif
 }
@@ -132,6 +134,11 @@ void Exception(const char *file, const char *func, int line, const char *msg)
         GetBackTrace(output, false, true);
         LogCrash(output, message);
     }
+    else if (g_logs)
+    {
+        g_logs->Flush(true);
+    }
+    IpcChannel::Stop(true);
 
     exit(1);
 }
@@ -24,7 +24,17 @@
 #include <Helpers/FileStream.h>
 #include <Wrappers.h>
 
-void Resources::loadMD5Table(const QString &path, QStringList &tables, QList<MD5FileEntry> &entries)
+static inline const char *PathKey(const char *pool, const MD5FileEntry &entry)
+{
+    return pool + entry.pathOffset;
+}
+
+static inline const char *PathKey(const char *, const char *key)
+{
+    return key;
+}
+
+void MD5Table::Load(const QString &path)
 {
     ByteBuffer decompressed;
     ByteBuffer compressed;
@@ -46,50 +56,86 @@ void Resources::loadMD5Table(const QString &path, QStringList &tables, QList<MD5
     {
         auto tmp = MemoryStream(decompressed);
         int count = tmp.ReadInt32();
+        QVector<quint32> pathOffsets(count);
+        packages.reserve(count);
         for (int l = 0; l < count; l++)
         {
             QString pkg;
             tmp.ReadStringASCIINull(pkg);
-            tables.push_back(pkg);
+            packages.push_back(pkg);
+            pathOffsets[l] = pathPool.size();
+            pathPool += pkg.toLower().toLatin1();
+            pathPool += '\0';
         }
         count = tmp.ReadInt32();
+        entries.resize(count);
         for (int l = 0; l < count; l++)
         {
-            MD5FileEntry entry{};
-            entry.path = tables[tmp.ReadInt32()].toLower();
+            MD5FileEntry &entry = entries[l];
+            entry.packageIndex = tmp.ReadInt32();
+            entry.pathOffset = pathOffsets[entry.packageIndex];
             entry.size = tmp.ReadInt32();
             tmp.ReadToBuffer(entry.md5, 16);
-            entries.push_back(entry);
         }
-        std::sort(entries.begin(), entries.end(), SortComparePath);
     }
     decompressed.Free();
     compressed.Free();
+
+    const char *pool = pathPool.constData();
+    std::stable_sort(entries.begin(), entries.end(),
+                     [pool](const MD5FileEntry &e1, const MD5FileEntry &e2)
+                     {
+                         return strcmp(pool + e1.pathOffset, pool + e2.pathOffset) < 0;
+                     });
+
+    digestOrder.resize(entries.count());
+    for (int l = 0; l < entries.count(); l++)
+        digestOrder[l] = l;
+    const MD5FileEntry *data = entries.constData();
+    std::sort(digestOrder.begin(), digestOrder.end(),
+              [data](quint32 e1, quint32 e2)
+              {
+                  return memcmp(data[e1].md5, data[e2].md5, 16) < 0;
+              });
 }
 
-void Resources::loadMD5Tables()
+MD5Table::Range MD5Table::FindPath(const QString &path) const
 {
-    if (MD5tablesLoaded)
-        CRASH();
-
-    loadMD5Table(":/MD5EntriesME1.bin", tablePkgsME1, entriesME1);
-    loadMD5Table(":/MD5EntriesME2.bin", tablePkgsME2, entriesME2);
-    loadMD5Table(":/MD5EntriesME3.bin", tablePkgsME3, entriesME3);
+    QByteArray key = path.toLower().toLatin1();
+    const char *pool = pathPool.constData();
+    auto range = std::equal_range(begin(), end(), key.constData(),
+                                  [pool](const auto &e1, const auto &e2)
+                                  {
+                                      return strcmp(PathKey(pool, e1), PathKey(pool, e2)) < 0;
+                                  });
+    return Range(range.first, range.second);
+}
 
-    MD5tablesLoaded = true;
+const MD5FileEntry *MD5Table::FindDigest(const quint8 *md5) const
+{
+    const MD5FileEntry *data = entries.constData();
+    auto it = std::lower_bound(digestOrder.constBegin(), digestOrder.constEnd(), md5,
+                               [data](quint32 e, const quint8 *key)
+                               {
+                                   return memcmp(data[e].md5, key, 16) < 0;
+                               });
+    if (it == digestOrder.constEnd() || memcmp(data[*it].md5, md5, 16) != 0)
+        return nullptr;
+    return data + *it;
 }
 
-void Resources::unloadMD5Tables()
+const MD5Table &Resources::GetMD5Table(MeType gameId)
 {
-    if (!MD5tablesLoaded)
-        return;
+    static MD5Table tables[3];
+    static std::once_flag loaded[3];
 
-    tablePkgsME1.clear();
-    tablePkgsME2.clear();
-    tablePkgsME3.clear();
-    entriesME1.clear();
-    entriesME2.clear();
-    entriesME3.clear();
+    int index = (int)gameId - (int)MeType::ME1_TYPE;
+    if (index < 0 || index >= 3)
+        CRASH();
+    std::call_once(loaded[index], [index]
+    {
+        tables[index].Load(QString(":/MD5EntriesME%1.bin").arg(index + 1));
+    });
 
-    MD5tablesLoaded = false;
+    return tables[index];
 }
@@ -24,56 +24,46 @@
 
 #include <Helpers/ByteBuffer.h>
 #include <Helpers/MiscHelpers.h>
+#include <Types/MemTypes.h>
 
 struct MD5FileEntry
 {
-    QString path;
+    quint32 pathOffset;
+    quint32 packageIndex;
+    qint32 size;
     quint8 md5[16];
-    int size;
-
-    bool operator< (const MD5FileEntry &e) const
-    {
-        return AsciiStringCompare(path, e.path) < 0;
-    }
 };
 
-class Resources
+class MD5Table
 {
+    friend class Resources;
+
 private:
-    bool MD5tablesLoaded = false;
 
-    void loadMD5Table(const QString &path, QStringList &tables, QList<MD5FileEntry> &entries);
+    QStringList packages;
+    QByteArray pathPool;
+    QVector<MD5FileEntry> entries;
+    QVector<quint32> digestOrder;
 
-public:
+    void Load(const QString &path);
 
-    static bool SortComparePath(MD5FileEntry &e1, MD5FileEntry &e2)
-    {
-        return AsciiStringCompare(e1.path, e2.path) < 0;
-    }
+public:
 
-    struct ComparePath
-    {
-        bool operator() (const MD5FileEntry& e, const QString& key)
-        {
-            return AsciiStringCompare(e.path, key) < 0;
-        }
+    typedef QPair<const MD5FileEntry *, const MD5FileEntry *> Range;
 
-        bool operator() (const QString& key, const MD5FileEntry& e)
-        {
-            return AsciiStringCompare(e.path, key) < 0;
-        }
-    };
+    const QStringList &Packages() const { return packages; }
+    const MD5FileEntry *begin() const { return entries.constData(); }
+    const MD5FileEntry *end() const { return entries.constData() + entries.count(); }
+    const char *Path(const MD5FileEntry &entry) const { return pathPool.constData() + entry.pathOffset; }
+    Range FindPath(const QString &path) const;
+    const MD5FileEntry *FindDigest(const quint8 *md5) const;
+};
 
-    QList<MD5FileEntry> entriesME1;
-    QList<MD5FileEntry> entriesME2;
-    QList<MD5FileEntry> entriesME3;
-    QStringList tablePkgsME1;
-    QStringList tablePkgsME2;
-    QStringList tablePkgsME3;
+class Resources
+{
+public:
 
-    ~Resources() { unloadMD5Tables(); }
-    void loadMD5Tables();
-    void unloadMD5Tables();
+    static const MD5Table &GetMD5Table(MeType gameId);
 };
 
 #endif
@@ -19,9 +19,10 @@
  *
  */
 
+#include <Helpers/IpcChannel.h>
 #include <Helpers/MiscHelpers.h>
 #include <Helpers/Logs.h>
-#include <Helpers/Crc32.h>
+#include <Helpers/Crc32Fast.h>
 #include <Wrappers.h>
 #include <GameData/Package.h>
 #include <GameData/GameData.h>
@@ -29,63 +30,76 @@
 #include <Program/ConfigIni.h>
 #include <Types/MemTypes.h>
 
-Texture::Texture(Package &package, int exportId, const ByteBuffer &data, bool fixDim)
+Texture::Texture(Package &package, int exportId, UniqueByteBuffer &&data, bool fixDim)
 {
     dataExportId = exportId;
-    properties = new Properties(package, data, package.getPropertiesOffset(exportId));
-    if (data.size() == properties->propertyEndOffset)
+    exportData = std::move(data);
+    properties = new Properties(package, exportData, package.getPropertiesOffset(exportId));
+    if (exportData.size() == properties->propertyEndOffset)
         return;
 
-    textureData = new MemoryStream(data, properties->propertyEndOffset, data.size() - properties->propertyEndOffset);
+    ByteSpan mipsData = ByteSpan(exportData).subSpan(properties->propertyEndOffset,
+                                                     exportData.size() - properties->propertyEndOffset);
+    textureData = new MemoryStream(mipsData);
     if (GameData::gameType != MeType::ME3_TYPE)
     {
         textureData->Skip(12); // 12 zeros
         textureData->SkipInt32(); // position in the package
     }
 
-    int numMipMaps = textureData->ReadInt32();
+    parseMipMaps(*textureData, mipMapsList, fixDim);
+
+    restOfData = mipsData.subSpan(textureData->Position(), textureData->Length() - textureData->Position());
+
+    packagePath = package.packagePath;
+    packageName = BaseNameWithoutExt(packagePath).toLower();
+}
+
+void Texture::parseMipMaps(Stream &stream, QList<TextureMipMap> &mipMaps, bool fixDim)
+{
+    int numMipMaps = stream.ReadInt32();
     for (int l = 0; l < numMipMaps; l++)
     {
         TextureMipMap mipmap{};
-        mipmap.storageType = (StorageTypes)textureData->ReadInt32();
-        mipmap.uncompressedSize = textureData->ReadInt32();
-        mipmap.compressedSize = textureData->ReadInt32();
-        mipmap.dataOffset = textureData->ReadUInt32();
+        mipmap.storageType = (StorageTypes)stream.ReadInt32();
+        mipmap.uncompressedSize = stream.ReadInt32();
+        mipmap.compressedSize = stream.ReadInt32();
+        mipmap.dataOffset = stream.ReadUInt32();
         if (mipmap.storageType == StorageTypes::pccUnc)
         {
-            mipmap.internalOffset = textureData->Position();
-            textureData->Skip(mipmap.uncompressedSize);
+            mipmap.internalOffset = stream.Position();
+            stream.Skip(mipmap.uncompressedSize);
         }
         else if (mipmap.storageType == StorageTypes::pccZlib ||
                  mipmap.storageType == StorageTypes::pccOodle)
         {
-            mipmap.internalOffset = textureData->Position();
-            textureData->Skip(mipmap.compressedSize);
+            mipmap.internalOffset = stream.Position();
+            stream.Skip(mipmap.compressedSize);
         }
 
-        mipmap.width = textureData->ReadInt32();
-        mipmap.height = textureData->ReadInt32();
+        mipmap.width = stream.ReadInt32();
+        mipmap.height = stream.ReadInt32();
 
         if (fixDim)
         {
             if (mipmap.width == 4)
             {
-                for (int i = 0; i < mipMapsList.count(); i++)
+                for (int i = 0; i < mipMaps.count(); i++)
                 {
-                    if (mipMapsList[i].width == mipmap.width)
+                    if (mipMaps[i].width == mipmap.width)
                     {
-                        mipmap.width = mipMapsList.last().width / 2;
+                        mipmap.width = mipMaps.last().width / 2;
                         break;
                     }
                 }
             }
             if (mipmap.height == 4)
             {
-                for (int i = 0; i < mipMapsList.count(); i++)
+                for (int i = 0; i < mipMaps.count(); i++)
                 {
-                    if (mipMapsList[i].height == mipmap.height)
+                    if (mipMaps[i].height == mipmap.height)
                     {
-                        mipmap.height = mipMapsList.last().height / 2;
+                        mipmap.height = mipMaps.last().height / 2;
                         break;
                     }
                 }
@@ -96,20 +110,13 @@ Texture::Texture(Package &package, int exportId, const ByteBuffer &data, bool fi
                 mipmap.height = 1;
         }
 
-        mipMapsList.push_back(mipmap);
+        mipMaps.push_back(mipmap);
     }
-
-    restOfData = ByteBuffer(textureData->Length() - textureData->Position());
-    textureData->ReadToBuffer(restOfData.ptr(), textureData->Length() - textureData->Position());
-
-    packagePath = package.packagePath;
-    packageName = BaseNameWithoutExt(packagePath).toLower();
 }
 
 Texture::~Texture()
 {
     delete textureData;
-    restOfData.Free();
     delete properties;
     for (int i = 0; i < mipMapsList.count(); i++)
     {
@@ -158,27 +165,20 @@ uint Texture::getCrcData(ByteBuffer data)
 {
     if (data.ptr() == nullptr)
         return 0;
-    return ~crc32_16bytes_prefetch(data.ptr(), data.size());
+    return ~crc32_parallel(data.ptr(), data.size());
 }
 
 uint Texture::getCrcMipmap(TextureMipMap &mipmap)
 {
-    ByteBuffer data = getMipMapData(mipmap);
-    if (data.ptr() == nullptr)
-        return 0;
-    uint crc = getCrcData(data);
-    data.Free();
-    return crc;
+    return readMipMapCrc(*textureData, mipmap, *properties, packagePath, dataExportId);
 }
 
 uint Texture::getCrcTopMipmap()
 {
-    ByteBuffer data = getTopImageData();
-    if (data.ptr() == nullptr)
+    if (mipMapsList.count() == 0)
         return 0;
-    uint crc = getCrcData(data);
-    data.Free();
-    return crc;
+
+    return readMipMapCrc(*textureData, getTopMipmap(), *properties, packagePath, dataExportId);
 }
 
 const Texture::TextureMipMap& Texture::getTopMipmap()
@@ -265,7 +265,70 @@ const ByteBuffer Texture::getMipMapDataByIndex(int index)
     return getMipMapData(mipMapsList[index]);
 }
 
-const ByteBuffer Texture::getMipMapData(TextureMipMap &mipmap)
+static QString findTfcFile(const Texture::TextureMipMap &mipmap, Properties &properties,
+                           const QString &packagePath, int dataExportId)
+{
+    QString filename;
+    QString archive = properties.getProperty("TextureFileCacheName").getValueName();
+    filename = g_GameData->MainData() + "/" + archive + ".tfc";
+    if (packagePath.contains("/DLC", Qt::CaseInsensitive))
+    {
+        QString DLCArchiveFile = g_GameData->GamePath() + DirName(packagePath) + "/" + archive + ".tfc";
+        if (QFile(DLCArchiveFile).exists())
+            filename = DLCArchiveFile;
+        else if (!QFile(filename).exists())
+        {
+            QStringList files = g_GameData->tfcFiles.filter(QRegExp(QString("*/") + archive + ".tfc",
+                                                                    Qt::CaseInsensitive, QRegExp::Wildcard));
+            if (files.count() == 1)
+                filename = g_GameData->GamePath() + files.first();
+            else if (files.count() == 0)
+            {
+                if (g_ipc)
+                {
+                    IpcChannel::Send(IpcEvent::ErrorReferencedTfcNotFound, archive + ".tfc");
+                }
+                else
+                {
+                    PERROR(QString("TFC file not found: ") + archive + ".tfc" + "\n");
+                }
+                return QString();
+            }
+            else
+            {
+                QString list;
+                foreach(QString file, files)
+                    list += file + "\n";
+                PERROR((QString("More instances of TFC file: ") + archive + ".tfc\n" +
+                           list).toStdString().c_str());
+                return QString();
+            }
+        }
+    }
+
+    if (!QFile(filename).exists())
+    {
+        if (g_ipc)
+        {
+            IpcChannel::Send(IpcEvent::ErrorReferencedTfcNotFound, g_GameData->RelativeGameData(filename));
+        }
+        else
+        {
+            PERROR(QString("File no found: " + filename + "\n"));
+        }
+        PERROR(QString("\nPackage: ") + packagePath +
+               "\nStorageType: " + QString::number(mipmap.storageType) +
+               "\nExport Id: " + QString::number(dataExportId + 1) +
+               "\nExternal file offset: " + QString::number(mipmap.dataOffset) + "\n");
+        return QString();
+    }
+
+    return filename;
+}
+
+const ByteBuffer Texture::readMipMapData(Stream &textureData, const TextureMipMap &mipmap,
+                                         Properties &properties, const QString &packagePath,
+                                         int dataExportId)
 {
     ByteBuffer mipMapData;
 
@@ -273,15 +336,15 @@ const ByteBuffer Texture::getMipMapData(TextureMipMap &mipmap)
     {
     case StorageTypes::pccUnc:
         {
-            textureData->JumpTo(mipmap.internalOffset);
-            mipMapData = textureData->ReadToBuffer(mipmap.uncompressedSize);
+            textureData.JumpTo(mipmap.internalOffset);
+            mipMapData = textureData.ReadToBuffer(mipmap.uncompressedSize);
             break;
         }
     case StorageTypes::pccZlib:
     case StorageTypes::pccOodle:
         {
-            textureData->JumpTo(mipmap.internalOffset);
-            mipMapData = Package::decompressData(dynamic_cast<Stream &>(*textureData), mipmap.storageType, mipmap.uncompressedSize, mipmap.compressedSize);
+            textureData.JumpTo(mipmap.internalOffset);
+            mipMapData = Package::decompressData(textureData, mipmap.storageType, mipmap.uncompressedSize, mipmap.compressedSize);
             if (mipMapData.ptr() == nullptr)
             {
                 PERROR(QString("\nPackage: ") + packagePath +
@@ -296,80 +359,107 @@ const ByteBuffer Texture::getMipMapData(TextureMipMap &mipmap)
     case StorageTypes::extZlib:
     case StorageTypes::extOodle:
         {
-            QString filename;
-            QString archive = properties->getProperty("TextureFileCacheName").getValueName();
-            filename = g_GameData->MainData() + "/" + archive + ".tfc";
-            if (packagePath.contains("/DLC", Qt::CaseInsensitive))
+            QString filename = findTfcFile(mipmap, properties, packagePath, dataExportId);
+            if (filename.isEmpty())
+                return ByteBuffer();
+            auto fs = FileStream(filename, FileMode::Open, FileAccess::ReadOnly);
+            fs.JumpTo(mipmap.dataOffset);
+            if (mipmap.storageType == StorageTypes::extZlib || mipmap.storageType == StorageTypes::extOodle)
             {
-                QString DLCArchiveFile = g_GameData->GamePath() + DirName(packagePath) + "/" + archive + ".tfc";
-                if (QFile(DLCArchiveFile).exists())
-                    filename = DLCArchiveFile;
-                else if (!QFile(filename).exists())
+                mipMapData = Package::decompressData(dynamic_cast<Stream &>(fs), mipmap.storageType, mipmap.uncompressedSize, mipmap.compressedSize);
+                if (mipMapData.ptr() == nullptr)
                 {
-                    QStringList files = g_GameData->tfcFiles.filter(QRegExp(QString("*/") + archive + ".tfc",
-                                                                            Qt::CaseInsensitive, QRegExp::Wildcard));
-                    if (files.count() == 1)
-                        filename = g_GameData->GamePath() + files.first();
-                    else if (files.count() == 0)
-                    {
-                        if (g_ipc)
-                        {
-                            ConsoleWrite("[IPC]ERROR_REFERENCED_TFC_NOT_FOUND " + archive + ".tfc");
-                            ConsoleSync();
-                        }
-                        else
-                        {
-                            PERROR(QString("TFC file not found: ") + archive + ".tfc" + "\n");
-                        }
-                        return ByteBuffer();
-                    }
-                    else
-                    {
-                        QString list;
-                        foreach(QString file, files)
-                            list += file + "\n";
-                        PERROR((QString("More instances of TFC file: ") + archive + ".tfc\n" +
-                                   list).toStdString().c_str());
-                        return ByteBuffer();
-                    }
+                    PERROR(QString("\nFile: ") + filename +
+                        "\nPackage: " + packagePath +
+                        "\nStorageType: " + QString::number(mipmap.storageType) +
+                        "\nExport Id: " + QString::number(dataExportId + 1) +
+                        "\nExternal file offset: " + QString::number(mipmap.dataOffset) + "\n");
+                    return ByteBuffer();
                 }
             }
+            else
+            {
+                mipMapData = fs.ReadToBuffer(mipmap.uncompressedSize);
+            }
+            break;
+        }
+    case StorageTypes::empty:
+        CRASH();
+    }
+
+    return mipMapData;
+}
+
+static uint crcStream(Stream &stream, qint64 length)
+{
+    ByteBuffer buffer(qMin(length, (qint64)Package::MaxBlockSize));
+    uint crc = 0;
+    while (length > 0)
+    {
+        qint64 size = qMin(length, (qint64)buffer.size());
+        stream.ReadToBuffer(buffer.ptr(), size);
+        crc = crc32_hw(buffer.ptr(), size, crc);
+        length -= size;
+    }
+    buffer.Free();
+    return crc;
+}
 
-            if (!QFile(filename).exists())
+uint Texture::readMipMapCrc(Stream &textureData, const TextureMipMap &mipmap,
+                            Properties &properties, const QString &packagePath,
+                            int dataExportId)
+{
+    uint crc = 0;
+
+    switch (mipmap.storageType)
+    {
+    case StorageTypes::pccUnc:
+        {
+            textureData.JumpTo(mipmap.internalOffset);
+            crc = crcStream(textureData, mipmap.uncompressedSize);
+            break;
+        }
+    case StorageTypes::pccZlib:
+    case StorageTypes::pccOodle:
+        {
+            textureData.JumpTo(mipmap.internalOffset);
+            if (!Package::decompressDataCrc(textureData, mipmap.storageType,
+                                            mipmap.uncompressedSize, mipmap.compressedSize, crc))
             {
-                if (g_ipc)
-                {
-                    ConsoleWrite("[IPC]ERROR_REFERENCED_TFC_NOT_FOUND " + g_GameData->RelativeGameData(filename));
-                    ConsoleSync();
-                }
-                else
-                {
-                    PERROR(QString("File no found: " + filename + "\n"));
-                }
                 PERROR(QString("\nPackage: ") + packagePath +
-                       "\nStorageType: " + QString::number(mipmap.storageType) +
-                       "\nExport Id: " + QString::number(dataExportId + 1) +
-                       "\nExternal file offset: " + QString::number(mipmap.dataOffset) + "\n");
-                return ByteBuffer();
+                    "\nStorageType: " + QString::number(mipmap.storageType) +
+                    "\nExport Id: " + QString::number(dataExportId + 1) +
+                    "\nInternal offset: " + QString::number(mipmap.internalOffset) + "\n");
+                return 0;
             }
+            break;
+        }
+    case StorageTypes::extUnc:
+    case StorageTypes::extUnc2:
+    case StorageTypes::extZlib:
+    case StorageTypes::extOodle:
+        {
+            QString filename = findTfcFile(mipmap, properties, packagePath, dataExportId);
+            if (filename.isEmpty())
+                return 0;
             auto fs = FileStream(filename, FileMode::Open, FileAccess::ReadOnly);
             fs.JumpTo(mipmap.dataOffset);
             if (mipmap.storageType == StorageTypes::extZlib || mipmap.storageType == StorageTypes::extOodle)
             {
-                mipMapData = Package::decompressData(dynamic_cast<Stream &>(fs), mipmap.storageType, mipmap.uncompressedSize, mipmap.compressedSize);
-                if (mipMapData.ptr() == nullptr)
+                if (!Package::decompressDataCrc(fs, mipmap.storageType,
+                                                mipmap.uncompressedSize, mipmap.compressedSize, crc))
                 {
                     PERROR(QString("\nFile: ") + filename +
                         "\nPackage: " + packagePath +
                         "\nStorageType: " + QString::number(mipmap.storageType) +
                         "\nExport Id: " + QString::number(dataExportId + 1) +
                         "\nExternal file offset: " + QString::number(mipmap.dataOffset) + "\n");
-                    return ByteBuffer();
+                    return 0;
                 }
             }
             else
             {
-                mipMapData = fs.ReadToBuffer(mipmap.uncompressedSize);
+                crc = crcStream(fs, mipmap.uncompressedSize);
             }
             break;
         }
@@ -377,7 +467,12 @@ const ByteBuffer Texture::getMipMapData(TextureMipMap &mipmap)
         CRASH();
     }
 
-    return mipMapData;
+    return ~crc;
+}
+
+const ByteBuffer Texture::getMipMapData(TextureMipMap &mipmap)
+{
+    return readMipMapData(*textureData, mipmap, *properties, packagePath, dataExportId);
 }
 
 const ByteBuffer Texture::toArray(uint pccTextureDataOffset, bool updateOffset)
@@ -31,8 +31,9 @@ class Texture
 {
 private:
 
+    UniqueByteBuffer exportData;
     MemoryStream *textureData = nullptr;
-    ByteBuffer restOfData;
+    ByteSpan restOfData;
     QString packagePath;
     Properties *properties;
 
@@ -55,8 +56,15 @@ public:
     QString packageName;
     int dataExportId;
 
-    Texture(Package &package, int exportId, const ByteBuffer &data, bool fixDim = true);
+    Texture(Package &package, int exportId, UniqueByteBuffer &&data, bool fixDim = true);
     ~Texture();
+    static void parseMipMaps(Stream &stream, QList<TextureMipMap> &mipMaps, bool fixDim);
+    static const ByteBuffer readMipMapData(Stream &textureData, const TextureMipMap &mipmap,
+                                           Properties &properties, const QString &packagePath,
+                                           int dataExportId);
+    static uint readMipMapCrc(Stream &textureData, const TextureMipMap &mipmap,
+                              Properties &properties, const QString &packagePath,
+                              int dataExportId);
     void replaceMipMaps(const QList<TextureMipMap> &newMipMaps);
     Properties& getProperties() { return *properties; }
     uint getCrcData(ByteBuffer data);
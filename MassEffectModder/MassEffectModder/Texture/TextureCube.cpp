@@ -25,7 +25,7 @@
 #include <Texture/TextureCube.h>
 #include <Types/MemTypes.h>
 
-TextureCube::TextureCube(Package &package, int exportIndex, const ByteBuffer &data)
+TextureCube::TextureCube(Package &package, int exportIndex, const ByteSpan &data)
 {
     properties = new Properties(package, data, package.getPropertiesOffset(exportIndex));
     if (data.size() == properties->propertyEndOffset)
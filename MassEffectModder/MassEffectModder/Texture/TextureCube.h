@@ -34,7 +34,7 @@ private:
 
 public:
 
-    TextureCube(Package &package, int exportIndex, const ByteBuffer &data);
+    TextureCube(Package &package, int exportIndex, const ByteSpan &data);
     ~TextureCube();
     Properties& getProperties() { return *properties; }
 };
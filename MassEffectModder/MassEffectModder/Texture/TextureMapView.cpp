@@ -0,0 +1,352 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <Texture/TextureMapView.h>
+#include <Helpers/FileStream.h>
+#include <Helpers/MemoryStream.h>
+#include <Helpers/Logs.h>
+
+static_assert(sizeof(TextureMapView::MapHeader) == 56, "Wrong size of map header");
+static_assert(sizeof(TextureMapView::TextureRecord) == 24, "Wrong size of texture record");
+static_assert(sizeof(TextureMapView::InstanceRecord) == 12, "Wrong size of instance record");
+static_assert(sizeof(TextureMapView::PathRecord) == 8, "Wrong size of path record");
+
+TextureMapView::~TextureMapView()
+{
+    Close();
+}
+
+bool TextureMapView::Open(const QString &path)
+{
+    Close();
+    file = new QFile(path);
+    if (!file->open(QIODevice::ReadOnly))
+    {
+        Close();
+        return false;
+    }
+    qint64 size = file->size();
+    data = file->map(0, size);
+    if (data == nullptr || !Validate(size))
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void TextureMapView::Close()
+{
+    if (file)
+    {
+        if (data)
+            file->unmap(const_cast<uchar *>(data));
+        file->close();
+        delete file;
+        file = nullptr;
+    }
+    data = nullptr;
+    header = nullptr;
+}
+
+bool TextureMapView::Validate(qint64 size)
+{
+    if (size < (qint64)sizeof(MapHeader))
+        return false;
+    header = reinterpret_cast<const MapHeader *>(data);
+    if (header->tag != textureMapBinTag || header->version != textureMapBinVersion)
+        return false;
+    if (header->scannedPackagesCount > header->pathsCount)
+        return false;
+
+    auto checkRange = [size](quint64 offset, quint64 length)
+    {
+        return offset + length <= (quint64)size;
+    };
+    if (!checkRange(header->crcsOffset, (quint64)header->texturesCount * sizeof(quint32)) ||
+        !checkRange(header->texturesOffset, (quint64)header->texturesCount * sizeof(TextureRecord)) ||
+        !checkRange(header->instancesOffset, (quint64)header->instancesCount * sizeof(InstanceRecord)) ||
+        !checkRange(header->pathsOffset, (quint64)header->pathsCount * sizeof(PathRecord)) ||
+        !checkRange(header->stringsOffset, header->stringsSize))
+    {
+        return false;
+    }
+    if ((header->flags & FlagCrcIndex) &&
+        !checkRange(header->crcIndexOffset, CrcIndexSize * sizeof(quint32)))
+    {
+        return false;
+    }
+
+    if ((header->crcsOffset | header->texturesOffset | header->instancesOffset |
+         header->pathsOffset | header->crcIndexOffset) & 3)
+    {
+        return false;
+    }
+
+    crcs = reinterpret_cast<const quint32 *>(data + header->crcsOffset);
+    textureRecords = reinterpret_cast<const TextureRecord *>(data + header->texturesOffset);
+    instanceRecords = reinterpret_cast<const InstanceRecord *>(data + header->instancesOffset);
+    pathRecords = reinterpret_cast<const PathRecord *>(data + header->pathsOffset);
+    strings = reinterpret_cast<const char *>(data + header->stringsOffset);
+    crcIndex = (header->flags & FlagCrcIndex) ?
+                reinterpret_cast<const quint32 *>(data + header->crcIndexOffset) : nullptr;
+
+    // Records are accessed without further checks, all references must be in range
+    auto checkString = [this](quint64 offset, quint64 length)
+    {
+        return offset + length <= header->stringsSize;
+    };
+    for (uint i = 0; i < header->texturesCount; i++)
+    {
+        const TextureRecord &record = textureRecords[i];
+        if (i != 0 && crcs[i - 1] > crcs[i])
+            return false;
+        if (!checkString(record.nameOffset, record.nameLength) ||
+            (quint64)record.firstInstance + record.instancesCount > header->instancesCount)
+        {
+            return false;
+        }
+    }
+    for (uint i = 0; i < header->instancesCount; i++)
+    {
+        qint32 pathIndex = instanceRecords[i].pathIndex;
+        if (pathIndex < -1 || (pathIndex >= 0 && (quint32)pathIndex >= header->pathsCount))
+            return false;
+    }
+    for (uint i = 0; i < header->pathsCount; i++)
+    {
+        if (!checkString(pathRecords[i].offset, pathRecords[i].length))
+            return false;
+    }
+    if (crcIndex)
+    {
+        for (uint i = 0; i < CrcIndexSize; i++)
+        {
+            if (crcIndex[i] > header->texturesCount || (i != 0 && crcIndex[i - 1] > crcIndex[i]))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+int TextureMapView::FindTexture(uint crc)
+{
+    const quint32 *first = crcs;
+    const quint32 *last = crcs + header->texturesCount;
+    if (crcIndex)
+    {
+        first = crcs + crcIndex[crc >> 16];
+        last = crcs + crcIndex[(crc >> 16) + 1];
+    }
+    auto it = std::lower_bound(first, last, crc);
+    if (it == last || *it != crc)
+        return -1;
+    return it - crcs;
+}
+
+QString TextureMapView::TextureName(int index)
+{
+    const TextureRecord &record = textureRecords[index];
+    return QString::fromLatin1(strings + record.nameOffset, record.nameLength);
+}
+
+QString TextureMapView::PathName(int index)
+{
+    const PathRecord &record = pathRecords[index];
+    return QString::fromLatin1(strings + record.offset, record.length);
+}
+
+void TextureMapView::GetScannedPackages(QStringList &packages)
+{
+    packages.reserve(header->scannedPackagesCount);
+    for (uint i = 0; i < header->scannedPackagesCount; i++)
+    {
+        packages.push_back(PathName(i));
+    }
+}
+
+void TextureMapView::GetTexture(int index, TextureMapEntry &texture)
+{
+    fillTexture(index, texture, nullptr);
+}
+
+void TextureMapView::GetTexture(int index, TextureMapEntry &texture, const QStringList &paths)
+{
+    fillTexture(index, texture, &paths);
+}
+
+void TextureMapView::fillTexture(int index, TextureMapEntry &texture, const QStringList *paths)
+{
+    const TextureRecord &record = textureRecords[index];
+    texture.name = QString::fromLatin1(strings + record.nameOffset, record.nameLength);
+    texture.crc = crcs[index];
+    texture.width = record.width;
+    texture.height = record.height;
+    texture.pixfmt = (PixelFormat)record.pixfmt;
+    texture.type = (TextureType)record.type;
+    texture.list.clear();
+    texture.list.reserve(record.instancesCount);
+    for (uint k = 0; k < record.instancesCount; k++)
+    {
+        const InstanceRecord &instance = instanceRecords[record.firstInstance + k];
+        TextureMapPackageEntry matched{};
+        matched.exportID = instance.exportID;
+        matched.movieTexture = (instance.flags & 1) == 1;
+        matched.hasAlphaData = (instance.flags & 2) == 2;
+        matched.numMips = instance.numMips;
+        if (instance.pathIndex >= 0)
+            matched.path = paths ? (*paths)[instance.pathIndex] : PathName(instance.pathIndex);
+        texture.list.push_back(matched);
+    }
+}
+
+void TextureMapView::ToList(QList<TextureMapEntry> &textures, QStringList &packages)
+{
+    // paths are shared between instances, no copies of strings are made
+    QStringList paths;
+    paths.reserve(header->pathsCount);
+    for (uint i = 0; i < header->pathsCount; i++)
+    {
+        paths.push_back(PathName(i));
+    }
+    for (uint i = 0; i < header->scannedPackagesCount; i++)
+    {
+        packages.push_back(paths[i]);
+    }
+
+    textures.reserve(textures.count() + header->texturesCount);
+    for (uint i = 0; i < header->texturesCount; i++)
+    {
+        TextureMapEntry texture{};
+        GetTexture(i, texture, paths);
+        textures.push_back(texture);
+    }
+}
+
+void TextureMapView::Save(const QString &path, const QList<TextureMapEntry> &textures,
+                          const QStringList &packages)
+{
+    QVector<int> order(textures.count());
+    for (int i = 0; i < textures.count(); i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&textures](int a, int b)
+    {
+        return textures[a].crc < textures[b].crc;
+    });
+
+    QByteArray stringPool;
+    QStringList paths;
+    QHash<QString, int> pathsIndex;
+    auto internPath = [&paths, &pathsIndex](const QString &pkgPath)
+    {
+        auto it = pathsIndex.constFind(pkgPath);
+        if (it != pathsIndex.constEnd())
+            return it.value();
+        int index = paths.count();
+        pathsIndex.insert(pkgPath, index);
+        paths.push_back(pkgPath);
+        return index;
+    };
+    for (int i = 0; i < packages.count(); i++)
+        internPath(packages[i]);
+    int scannedPackagesCount = paths.count();
+
+    MemoryStream crcsSection, texturesSection, instancesSection;
+    quint32 instancesCount = 0;
+    QVector<quint32> crcIndex(CrcIndexSize);
+    int lastBucket = -1;
+    for (int i = 0; i < order.count(); i++)
+    {
+        const TextureMapEntry &texture = textures[order[i]];
+        int bucket = texture.crc >> 16;
+        while (lastBucket < bucket)
+            crcIndex[++lastBucket] = i;
+        crcsSection.WriteUInt32(texture.crc);
+
+        QByteArray name = texture.name.toLatin1();
+        texturesSection.WriteUInt32(stringPool.size());
+        texturesSection.WriteUInt32(name.size());
+        stringPool.append(name);
+        texturesSection.WriteUInt32(instancesCount);
+        texturesSection.WriteUInt32(texture.list.count());
+        texturesSection.WriteInt16(texture.width);
+        texturesSection.WriteInt16(texture.height);
+        texturesSection.WriteByte(texture.pixfmt);
+        texturesSection.WriteByte(texture.type);
+        texturesSection.WriteUInt16(0);
+
+        for (int k = 0; k < texture.list.count(); k++)
+        {
+            const TextureMapPackageEntry &m = texture.list[k];
+            instancesSection.WriteInt32(m.exportID);
+            instancesSection.WriteInt32(m.path.length() != 0 ? internPath(m.path) : -1);
+            quint8 flags = m.movieTexture ? 1 : 0;
+            flags |= m.hasAlphaData ? 2 : 0;
+            instancesSection.WriteByte(flags);
+            instancesSection.WriteByte(m.numMips);
+            instancesSection.WriteUInt16(0);
+            instancesCount++;
+        }
+    }
+    while (lastBucket < CrcIndexSize - 1)
+        crcIndex[++lastBucket] = order.count();
+
+    MemoryStream pathsSection;
+    for (int i = 0; i < paths.count(); i++)
+    {
+        QByteArray pathName = QString(paths[i]).replace(QChar('\\'), QChar('/')).toLatin1();
+        pathsSection.WriteUInt32(stringPool.size());
+        pathsSection.WriteUInt32(pathName.size());
+        stringPool.append(pathName);
+    }
+
+    MapHeader mapHeader{};
+    mapHeader.tag = textureMapBinTag;
+    mapHeader.version = textureMapBinVersion;
+    mapHeader.flags = FlagCrcIndex;
+    mapHeader.texturesCount = order.count();
+    mapHeader.instancesCount = instancesCount;
+    mapHeader.pathsCount = paths.count();
+    mapHeader.scannedPackagesCount = scannedPackagesCount;
+    mapHeader.crcsOffset = sizeof(MapHeader);
+    mapHeader.texturesOffset = mapHeader.crcsOffset + crcsSection.Length();
+    mapHeader.instancesOffset = mapHeader.texturesOffset + texturesSection.Length();
+    mapHeader.pathsOffset = mapHeader.instancesOffset + instancesSection.Length();
+    mapHeader.crcIndexOffset = mapHeader.pathsOffset + pathsSection.Length();
+    mapHeader.stringsOffset = mapHeader.crcIndexOffset + CrcIndexSize * sizeof(quint32);
+    mapHeader.stringsSize = stringPool.size();
+
+    if (QFile(path).exists())
+        QFile(path).remove();
+    FileStream fs = FileStream(path, FileMode::Create, FileAccess::WriteOnly);
+    fs.WriteFromBuffer(reinterpret_cast<quint8 *>(&mapHeader), sizeof(MapHeader));
+    crcsSection.SeekBegin();
+    fs.CopyFrom(crcsSection, crcsSection.Length());
+    texturesSection.SeekBegin();
+    fs.CopyFrom(texturesSection, texturesSection.Length());
+    instancesSection.SeekBegin();
+    fs.CopyFrom(instancesSection, instancesSection.Length());
+    pathsSection.SeekBegin();
+    fs.CopyFrom(pathsSection, pathsSection.Length());
+    fs.WriteFromBuffer(reinterpret_cast<quint8 *>(crcIndex.data()), CrcIndexSize * sizeof(quint32));
+    fs.WriteFromBuffer(reinterpret_cast<quint8 *>(stringPool.data()), stringPool.size());
+}
@@ -0,0 +1,128 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef TEXTURE_MAP_VIEW_H
+#define TEXTURE_MAP_VIEW_H
+
+#include <Texture/TextureScan.h>
+
+// Textures map file (version 2), layout:
+//   header
+//   CRC column (sorted ascending)
+//   texture records, same order as CRC column
+//   instance records, grouped per texture
+//   path records, scanned packages first
+//   optional CRC index by upper 16 bits of CRC
+//   string pool of texture names and package paths
+class TextureMapView
+{
+public:
+
+    enum
+    {
+        FlagCrcIndex = 1,
+        CrcIndexSize = 0x10001,
+    };
+
+    struct MapHeader
+    {
+        quint32 tag;
+        quint32 version;
+        quint32 flags;
+        quint32 texturesCount;
+        quint32 instancesCount;
+        quint32 pathsCount;
+        quint32 scannedPackagesCount;
+        quint32 crcsOffset;
+        quint32 texturesOffset;
+        quint32 instancesOffset;
+        quint32 pathsOffset;
+        quint32 crcIndexOffset;
+        quint32 stringsOffset;
+        quint32 stringsSize;
+    };
+
+    struct TextureRecord
+    {
+        quint32 nameOffset;
+        quint32 nameLength;
+        quint32 firstInstance;
+        quint32 instancesCount;
+        qint16 width;
+        qint16 height;
+        quint8 pixfmt;
+        quint8 type;
+        quint16 reserved;
+    };
+
+    struct InstanceRecord
+    {
+        qint32 exportID;
+        qint32 pathIndex;
+        quint8 flags;
+        quint8 numMips;
+        quint16 reserved;
+    };
+
+    struct PathRecord
+    {
+        quint32 offset;
+        quint32 length;
+    };
+
+private:
+
+    QFile *file = nullptr;
+    const uchar *data = nullptr;
+    const MapHeader *header = nullptr;
+    const quint32 *crcs = nullptr;
+    const TextureRecord *textureRecords = nullptr;
+    const InstanceRecord *instanceRecords = nullptr;
+    const PathRecord *pathRecords = nullptr;
+    const quint32 *crcIndex = nullptr;
+    const char *strings = nullptr;
+
+    bool Validate(qint64 size);
+    void fillTexture(int index, TextureMapEntry &texture, const QStringList *paths);
+
+public:
+
+    TextureMapView() = default;
+    ~TextureMapView();
+    bool Open(const QString &path);
+    void Close();
+    bool isOpen() { return data != nullptr; }
+    int TexturesCount() { return header->texturesCount; }
+    int ScannedPackagesCount() { return header->scannedPackagesCount; }
+    uint Crc(int index) { return crcs[index]; }
+    int FindTexture(uint crc);
+    QString TextureName(int index);
+    QString PathName(int index);
+    void GetScannedPackages(QStringList &packages);
+    void GetTexture(int index, TextureMapEntry &texture);
+    void GetTexture(int index, TextureMapEntry &texture, const QStringList &paths);
+    void ToList(QList<TextureMapEntry> &textures, QStringList &packages);
+
+    static void Save(const QString &path, const QList<TextureMapEntry> &textures,
+                     const QStringList &packages);
+};
+
+#endif
@@ -19,16 +19,17 @@
  *
  */
 
+#include <Helpers/IpcChannel.h>
 #include <Helpers/MiscHelpers.h>
 #include <Helpers/Logs.h>
-#include <Helpers/Crc32.h>
+#include <Helpers/Crc32Fast.h>
 #include <GameData/Package.h>
 #include <GameData/GameData.h>
 #include <Texture/TextureMovie.h>
 #include <Program/ConfigIni.h>
 #include <Types/MemTypes.h>
 
-TextureMovie::TextureMovie(Package &package, int exportId, const ByteBuffer &data)
+TextureMovie::TextureMovie(Package &package, int exportId, const ByteSpan &data)
 {
     dataExportId = exportId;
     packagePath = package.packagePath;
@@ -130,8 +131,7 @@ const ByteBuffer TextureMovie::getData()
                     {
                         if (g_ipc)
                         {
-                            ConsoleWrite("[IPC]ERROR_REFERENCED_TFC_NOT_FOUND " + archive + ".tfc");
-                            ConsoleSync();
+                            IpcChannel::Send(IpcEvent::ErrorReferencedTfcNotFound, archive + ".tfc");
                         }
                         else
                         {
@@ -155,8 +155,7 @@ const ByteBuffer TextureMovie::getData()
             {
                 if (g_ipc)
                 {
-                    ConsoleWrite("[IPC]ERROR_REFERENCED_TFC_NOT_FOUND " + g_GameData->RelativeGameData(filename));
-                    ConsoleSync();
+                    IpcChannel::Send(IpcEvent::ErrorReferencedTfcNotFound, g_GameData->RelativeGameData(filename));
                 }
                 else
                 {
@@ -175,8 +174,7 @@ const ByteBuffer TextureMovie::getData()
             {
                 if (g_ipc)
                 {
-                    ConsoleWrite("[IPC]ERROR Not supported movie texture");
-                    ConsoleSync();
+                    IpcChannel::Send(IpcEvent::Error, "Not supported movie texture");
                 }
                 else
                 {
@@ -201,7 +199,7 @@ const ByteBuffer TextureMovie::getData()
 uint TextureMovie::getCrcData()
 {
     ByteBuffer data = getData();
-    uint crc = ~crc32_16bytes_prefetch(data.ptr(), data.size());
+    uint crc = ~crc32_parallel(data.ptr(), data.size());
     data.Free();
     return crc;
 }
@@ -42,7 +42,7 @@ private:
 
 public:
 
-    TextureMovie(Package &package, int exportId, const ByteBuffer &data);
+    TextureMovie(Package &package, int exportId, const ByteSpan &data);
     ~TextureMovie();
     Properties& getProperties() { return *properties; }
     StorageTypes getStorageType() { return storageType; }
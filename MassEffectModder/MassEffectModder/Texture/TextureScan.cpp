@@ -19,13 +19,17 @@
  *
  */
 
+#include <Helpers/IpcChannel.h>
 #include <Helpers/MiscHelpers.h>
 #include <Helpers/Logs.h>
 #include <Wrappers.h>
 #include <Texture/TextureScan.h>
+#include <Texture/TextureScanCache.h>
+#include <Texture/TextureMapView.h>
 #include <Texture/Texture.h>
 #include <Texture/TextureMovie.h>
 #include <Texture/TextureCube.h>
+#include <Texture/TextureView.h>
 #include <GameData/Package.h>
 #include <GameData/GameData.h>
 #include <GameData/TOCFile.h>
@@ -93,15 +97,9 @@ bool TreeScan::IsBlankTexture(uint crc)
     return false;
 }
 
-void TreeScan::loadTexturesMap(MeType gameId, Resources &resources, QList<TextureMapEntry> &textures)
+void TreeScan::loadTexturesMap(MeType gameId, QList<TextureMapEntry> &textures)
 {
-    QStringList pkgs;
-    if (gameId == MeType::ME1_TYPE)
-        pkgs = resources.tablePkgsME1;
-    else if (gameId == MeType::ME2_TYPE)
-        pkgs = resources.tablePkgsME2;
-    else
-        pkgs = resources.tablePkgsME3;
+    const QStringList &pkgs = Resources::GetMD5Table(gameId).Packages();
 
     FileStream tmp = FileStream(QString(":/mele%1map.bin").arg((int)gameId), FileMode::Open, FileAccess::ReadOnly);
     if (tmp.ReadUInt32() != 0x504D5443)
@@ -147,13 +145,25 @@ void TreeScan::loadTexturesMap(MeType gameId, Resources &resources, QList<Textur
 }
 
 bool TreeScan::loadTexturesMapFile(QString &path, QList<TextureMapEntry> &textures, bool ignoreCheck)
+{
+    TextureMapView view;
+    bool status = openTexturesMapFile(path, view, textures, ignoreCheck);
+    if (view.isOpen())
+    {
+        QStringList packages;
+        view.ToList(textures, packages);
+    }
+    return status;
+}
+
+bool TreeScan::openTexturesMapFile(QString &path, TextureMapView &view,
+                                   QList<TextureMapEntry> &textures, bool ignoreCheck)
 {
     if (!QFile(path).exists())
     {
         if (g_ipc)
         {
-            ConsoleWrite("[IPC]ERROR_TEXTURE_MAP_MISSING");
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::ErrorTextureMapMissing);
         }
         else
         {
@@ -172,8 +182,7 @@ bool TreeScan::loadTexturesMapFile(QString &path, QList<TextureMapEntry> &textur
     {
         if (g_ipc)
         {
-            ConsoleWrite("[IPC]ERROR_TEXTURE_MAP_WRONG");
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::ErrorTextureMapWrong);
         }
         else
         {
@@ -185,9 +194,26 @@ bool TreeScan::loadTexturesMapFile(QString &path, QList<TextureMapEntry> &textur
     QStringList packages = QStringList();
 
     if (version == 1)
+    {
         loadTexturesMapFileV1(fs, textures, packages);
+    }
     else
-        CRASH();
+    {
+        fs.Close();
+        if (!view.Open(path))
+        {
+            if (g_ipc)
+            {
+                IpcChannel::Send(IpcEvent::ErrorTextureMapWrong);
+            }
+            else
+            {
+                PERROR("Detected wrong or old version of textures scan file!\n");
+            }
+            return false;
+        }
+        view.GetScannedPackages(packages);
+    }
 
     if (!ignoreCheck)
     {
@@ -206,8 +232,7 @@ bool TreeScan::loadTexturesMapFile(QString &path, QList<TextureMapEntry> &textur
             {
                 if (g_ipc)
                 {
-                    ConsoleWrite(QString("[IPC]ERROR_REMOVED_FILE ") + packages[i]);
-                    ConsoleSync();
+                    IpcChannel::Send(IpcEvent::ErrorRemovedFile, packages[i]);
                 }
                 else
                 {
@@ -234,8 +259,7 @@ bool TreeScan::loadTexturesMapFile(QString &path, QList<TextureMapEntry> &textur
             {
                 if (g_ipc)
                 {
-                    ConsoleWrite(QString("[IPC]ERROR_ADDED_FILE ") + g_GameData->packageFiles[i]);
-                    ConsoleSync();
+                    IpcChannel::Send(IpcEvent::ErrorAddedFile, g_GameData->packageFiles[i]);
                 }
                 else
                 {
@@ -288,29 +312,55 @@ void TreeScan::loadTexturesMapFileV1(Stream &streeam, QList<TextureMapEntry> &te
     }
 }
 
-bool TreeScan::PrepareListOfTextures(MeType gameId, Resources &resources,
-                                    QList<TextureMapEntry> &textures,
-                                    bool saveMapFile,
-                                    ProgressCallback callback, void *callbackHandle)
+bool TreeScan::loadTexturesMapPackages(const QString &path, QStringList &packages)
 {
-    QStringList pkgs;
-    QList<MD5FileEntry> md5Entries;
-    if (gameId == MeType::ME1_TYPE)
-    {
-        pkgs = resources.tablePkgsME1;
-        md5Entries = resources.entriesME1;
-    }
-    else if (gameId == MeType::ME2_TYPE)
-    {
-        pkgs = resources.tablePkgsME2;
-        md5Entries = resources.entriesME2;
-    }
-    else
+    FileStream fs = FileStream(path, FileMode::Open, FileAccess::ReadOnly);
+    uint tag = fs.ReadUInt32();
+    uint version = fs.ReadUInt32();
+    if (tag != textureMapBinTag || version > textureMapBinVersion)
+        return false;
+
+    if (version == 1)
     {
-        pkgs = resources.tablePkgsME3;
-        md5Entries = resources.entriesME3;
+        uint countTexture = fs.ReadUInt32();
+        for (uint i = 0; i < countTexture; i++)
+        {
+            fs.Skip(fs.ReadInt32());
+            fs.SkipInt32();
+            uint countPackages = fs.ReadUInt32();
+            for (uint k = 0; k < countPackages; k++)
+            {
+                fs.Skip(8);
+                fs.Skip(fs.ReadInt32());
+            }
+        }
+
+        int numPackages = fs.ReadInt32();
+        for (int i = 0; i < numPackages; i++)
+        {
+            QString pkgPath;
+            fs.ReadStringASCII(pkgPath, fs.ReadInt32());
+            pkgPath.replace(QChar('\\'), QChar('/'));
+            packages.push_back(pkgPath);
+        }
+        return true;
     }
 
+    fs.Close();
+    TextureMapView view;
+    if (!view.Open(path))
+        return false;
+    view.GetScannedPackages(packages);
+    return true;
+}
+
+bool TreeScan::PrepareListOfTextures(MeType gameId, QList<TextureMapEntry> &textures,
+                                    bool saveMapFile,
+                                    ProgressCallback callback, void *callbackHandle)
+{
+    const MD5Table &md5Entries = Resources::GetMD5Table(gameId);
+    const QStringList &pkgs = md5Entries.Packages();
+
     QString path = QStandardPaths::standardLocations(QStandardPaths::GenericConfigLocation).first() +
             "/MassEffectModder";
     if (!QDir(path).exists())
@@ -326,11 +376,10 @@ bool TreeScan::PrepareListOfTextures(MeType gameId, Resources &resources,
     {
         if (g_ipc)
         {
-            ConsoleWrite("[IPC]STAGE_CONTEXT STAGE_PRESCAN");
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::StageContext, "STAGE_PRESCAN");
         }
 
-        loadTexturesMap(gameId, resources, textures);
+        loadTexturesMap(gameId, textures);
 
         for (int k = 0; k < textures.count(); k++)
         {
@@ -396,19 +445,26 @@ bool TreeScan::PrepareListOfTextures(MeType gameId, Resources &resources,
     long elapsed = Misc::elapsedStageTime();
     if (g_ipc)
     {
-        ConsoleWrite(QString("[IPC]STAGE_TIMING %1").arg(elapsed));
-        ConsoleSync();
+        IpcChannel::Send(IpcEvent::StageTiming, QString("%1").arg(elapsed));
     }
 
     Misc::restartStageTimer();
     if (g_ipc)
     {
-        ConsoleWrite("[IPC]STAGE_CONTEXT STAGE_SCAN");
-        ConsoleSync();
+        IpcChannel::Send(IpcEvent::StageContext, "STAGE_SCAN");
+    }
+
+    QHash<uint, int> crcIndex;
+    crcIndex.reserve(textures.count());
+    for (int k = 0; k < textures.count(); k++)
+    {
+        if (!crcIndex.contains(textures[k].crc))
+            crcIndex.insert(textures[k].crc, k);
     }
 
     if (!generateBuiltinMapFiles)
     {
+        TextureScanCache scanCache(gameId);
         QStringList addedFiles;
         QStringList modifiedFiles;
 
@@ -423,14 +479,10 @@ bool TreeScan::PrepareListOfTextures(MeType gameId, Resources &resources,
 #endif
             bool modified = true;
             bool foundPkg = false;
-            QString package = g_GameData->packageFiles[i].toLower();
             long packageSize = QFile(g_GameData->GamePath() + g_GameData->packageFiles[i]).size();
-            auto range = std::equal_range(md5Entries.begin(), md5Entries.end(),
-                                          package, Resources::ComparePath());
+            auto range = md5Entries.FindPath(g_GameData->packageFiles[i]);
             for (auto it = range.first; it != range.second; it++)
             {
-                if (it->path.compare(package, Qt::CaseSensitive) != 0)
-                    break;
                 foundPkg = true;
                 if (packageSize == it->size)
                 {
@@ -449,9 +501,8 @@ bool TreeScan::PrepareListOfTextures(MeType gameId, Resources &resources,
         int currentPackage = 0;
         if (g_ipc)
         {
-            ConsoleWrite(QString("[IPC]STAGE_WEIGHT STAGE_SCAN ") +
-                QString::number(((float)totalPackages / g_GameData->packageFiles.count())));
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::StageWeight, QString("STAGE_SCAN ") +
+                             QString::number(((float)totalPackages / g_GameData->packageFiles.count())));
         }
         for (int i = 0; i < modifiedFiles.count(); i++, currentPackage++)
         {
@@ -464,8 +515,7 @@ bool TreeScan::PrepareListOfTextures(MeType gameId, Resources &resources,
 #endif
             if (g_ipc)
             {
-                ConsoleWrite(QString("[IPC]PROCESSING_FILE ") + modifiedFiles[i]);
-                ConsoleSync();
+                IpcChannel::Send(IpcEvent::ProcessingFile, modifiedFiles[i]);
             }
             else
             {
@@ -480,15 +530,14 @@ bool TreeScan::PrepareListOfTextures(MeType gameId, Resources &resources,
                 lastProgress = newProgress;
                 if (g_ipc)
                 {
-                    ConsoleWrite(QString("[IPC]TASK_PROGRESS ") + QString::number(newProgress));
-                    ConsoleSync();
+                    IpcChannel::Progress(newProgress);
                 }
                 else if (callback)
                 {
                     callback(callbackHandle, newProgress, "Scanning textures");
                 }
             }
-            FindTextures(textures, modifiedFiles[i], true);
+            FindTextures(textures, crcIndex, &scanCache, modifiedFiles[i], true);
         }
 
         for (int i = 0; i < addedFiles.count(); i++, currentPackage++)
@@ -502,8 +551,7 @@ bool TreeScan::PrepareListOfTextures(MeType gameId, Resources &resources,
 #endif
             if (g_ipc)
             {
-                ConsoleWrite(QString("[IPC]PROCESSING_FILE ") + addedFiles[i]);
-                ConsoleSync();
+                IpcChannel::Send(IpcEvent::ProcessingFile, addedFiles[i]);
             }
             else
             {
@@ -518,16 +566,16 @@ bool TreeScan::PrepareListOfTextures(MeType gameId, Resources &resources,
                 lastProgress = newProgress;
                 if (g_ipc)
                 {
-                    ConsoleWrite(QString("[IPC]TASK_PROGRESS ") + QString::number(newProgress));
-                    ConsoleSync();
+                    IpcChannel::Progress(newProgress);
                 }
                 else if (callback)
                 {
                     callback(callbackHandle, newProgress, "Scanning textures");
                 }
             }
-            FindTextures(textures, addedFiles[i], false);
+            FindTextures(textures, crcIndex, &scanCache, addedFiles[i], false);
         }
+        scanCache.Save();
     }
     else
     {
@@ -543,8 +591,7 @@ bool TreeScan::PrepareListOfTextures(MeType gameId, Resources &resources,
 #endif
             if (g_ipc)
             {
-                ConsoleWrite(QString("[IPC]PROCESSING_FILE ") + g_GameData->packageFiles[i]);
-                ConsoleSync();
+                IpcChannel::Send(IpcEvent::ProcessingFile, g_GameData->packageFiles[i]);
             }
             else
             {
@@ -559,15 +606,14 @@ bool TreeScan::PrepareListOfTextures(MeType gameId, Resources &resources,
                 lastProgress = newProgress;
                 if (g_ipc)
                 {
-                    ConsoleWrite(QString("[IPC]TASK_PROGRESS ") + QString::number(newProgress));
-                    ConsoleSync();
+                    IpcChannel::Progress(newProgress);
                 }
                 else if (callback)
                 {
                     callback(callbackHandle, newProgress, "Scanning textures");
                 }
             }
-            FindTextures(textures, g_GameData->packageFiles[i], false);
+            FindTextures(textures, crcIndex, nullptr, g_GameData->packageFiles[i], false);
         }
     }
 
@@ -576,72 +622,44 @@ bool TreeScan::PrepareListOfTextures(MeType gameId, Resources &resources,
 
     if (saveMapFile)
     {
-        if (QFile(filename).exists())
-            QFile(filename).remove();
+        if (!generateBuiltinMapFiles)
+        {
+            TextureMapView::Save(filename, textures, g_GameData->packageFiles);
+        }
+        else
+        {
+            if (QFile(filename).exists())
+                QFile(filename).remove();
 
-        auto fs = FileStream(filename, FileMode::Create, FileAccess::WriteOnly);
-        MemoryStream mem;
-        mem.WriteUInt32(textureMapBinTag);
-        mem.WriteUInt32(textureMapBinVersion);
-        mem.WriteInt32(textures.count());
+            auto fs = FileStream(filename, FileMode::Create, FileAccess::WriteOnly);
+            MemoryStream mem;
+            mem.WriteUInt32(textureMapBinTag);
+            mem.WriteUInt32(textureMapBuiltinVersion);
+            mem.WriteInt32(textures.count());
 
-        for (int i = 0; i < textures.count(); i++)
-        {
-            const TextureMapEntry& texture = textures[i];
-            if (generateBuiltinMapFiles)
-                mem.WriteByte(texture.name.length());
-            else
-                mem.WriteInt32(texture.name.length());
-            mem.WriteStringASCII(texture.name);
-            mem.WriteUInt32(texture.crc);
-            if (generateBuiltinMapFiles)
+            for (int i = 0; i < textures.count(); i++)
             {
+                const TextureMapEntry& texture = textures[i];
+                mem.WriteByte(texture.name.length());
+                mem.WriteStringASCII(texture.name);
+                mem.WriteUInt32(texture.crc);
                 mem.WriteInt16(texture.width);
                 mem.WriteInt16(texture.height);
                 mem.WriteByte(texture.pixfmt);
                 mem.WriteByte(texture.type);
-
                 mem.WriteInt16(texture.list.count());
-            }
-            else
-            {
-                mem.WriteInt32(texture.list.count());
-            }
-            for (int k = 0; k < texture.list.count(); k++)
-            {
-                const TextureMapPackageEntry& m = texture.list[k];
-                mem.WriteInt32(m.exportID);
-                if (generateBuiltinMapFiles)
+                for (int k = 0; k < texture.list.count(); k++)
                 {
+                    const TextureMapPackageEntry& m = texture.list[k];
+                    mem.WriteInt32(m.exportID);
                     quint32 flags = m.hasAlphaData ? 1 : 0;
                     mem.WriteByte(flags);
                     mem.WriteByte(m.numMips);
                     mem.WriteInt16(pkgs.indexOf(m.path));
                 }
-                else
-                {
-                    quint32 flags = m.movieTexture ? 1 : 0;
-                    flags |= m.hasAlphaData ? 2 : 0;
-                    mem.WriteUInt32(flags);
-                    mem.WriteInt32(m.path.length());
-                    QString path = m.path;
-                    mem.WriteStringASCII(path.replace(QChar('/'), QChar('\\'), Qt::CaseInsensitive));
-                }
             }
-        }
-        if (!generateBuiltinMapFiles)
-        {
-            mem.WriteInt32(g_GameData->packageFiles.count());
-            for (int i = 0; i < g_GameData->packageFiles.count(); i++)
-            {
-                mem.WriteInt32(g_GameData->packageFiles[i].length());
-                mem.WriteStringASCII(g_GameData->packageFiles[i].replace(QChar('/'), QChar('\\')));
-            }
-        }
-        mem.SeekBegin();
+            mem.SeekBegin();
 
-        if (generateBuiltinMapFiles)
-        {
             fs.WriteUInt32(0x504D5443);
             fs.WriteUInt32(mem.Length());
             quint8 *compressed = nullptr;
@@ -653,23 +671,19 @@ bool TreeScan::PrepareListOfTextures(MeType gameId, Resources &resources,
             fs.WriteFromBuffer(compressed, compressedSize);
             delete[] compressed;
         }
-        else
-        {
-            fs.CopyFrom(mem, mem.Length());
-        }
     }
 
     elapsed = Misc::elapsedStageTime();
     if (g_ipc)
     {
-        ConsoleWrite(QString("[IPC]STAGE_TIMING %1").arg(elapsed));
-        ConsoleSync();
+        IpcChannel::Send(IpcEvent::StageTiming, QString("%1").arg(elapsed));
     }
 
     return true;
 }
 
-void TreeScan::FindTextures(QList<TextureMapEntry> &textures, const QString &packagePath, bool modified)
+bool TreeScan::ScanPackage(const QString &packagePath, QList<TextureScanEntry> &entries,
+                           const QHash<uint, int> *knownCrcs)
 {
     Package package;
     int status = package.Open(g_GameData->GamePath() + packagePath);
@@ -677,16 +691,16 @@ void TreeScan::FindTextures(QList<TextureMapEntry> &textures, const QString &pac
     {
         if (g_ipc)
         {
-            ConsoleWrite(QString("[IPC]ERROR Issue opening package file: ") + packagePath);
-            ConsoleSync();
+            IpcChannel::Send(IpcEvent::Error, QString("Issue opening package file: ") + packagePath);
         }
         else
         {
             PERROR(QString("ERROR: Issue opening package file: ") + packagePath + "\n");
         }
-        return;
+        return false;
     }
 
+    QSet<uint> scannedCrcs;
     for (int i = 0; i < package.exportsTable.count(); i++)
     {
         Package::ExportEntry& exp = package.exportsTable[i];
@@ -698,174 +712,71 @@ void TreeScan::FindTextures(QList<TextureMapEntry> &textures, const QString &pac
             id == package.nameIdTextureMovie ||
             id == package.nameIdTextureCube)
         {
-            ByteBuffer exportData = package.getExportData(i);
+            TextureScanEntry entry{};
+            entry.exportID = i;
+            entry.name = exp.objectName;
+            entry.alphaDetected = true;
+
+            // Scan needs only top mip of textures, skip reading other mips
+            UniqueByteBuffer exportData;
+            if (id == package.nameIdTextureMovie || id == package.nameIdTextureCube)
+                exportData = package.getExportData(i);
+            else
+                exportData = TextureView::getTopMipExportData(package, i);
             if (exportData.ptr() == nullptr)
             {
-                if (g_ipc)
-                {
-                    ConsoleWrite(QString("[IPC]ERROR Texture ") + exp.objectName +
-                                 " has broken export data in package: " +
-                                 packagePath + "\nExport Id: " + QString::number(i + 1) + "\nSkipping...");
-                    ConsoleSync();
-                }
-                else
-                {
-                    PERROR(QString("Error: Texture ") + exp.objectName +
-                                 " has broken export data in package: " +
-                                 packagePath +"\nExport Id: " + QString::number(i + 1) + "\nSkipping...\n");
-                }
+                entry.status = TextureScanEntry::BrokenExportData;
+                entries.push_back(entry);
                 continue;
             }
 
-            TextureMovie *textureMovie = nullptr;
-            TextureCube *textureCube = nullptr;
-            Texture *texture = nullptr;
-            uint crc;
-
-            TextureMapPackageEntry matchTexture{};
-            matchTexture.exportID = i;
-            matchTexture.path = packagePath;
-            matchTexture.hasAlphaData = false;
-
             if (id == package.nameIdTextureMovie)
             {
-                textureMovie = new TextureMovie(package, i, exportData);
+                TextureMovie textureMovie(package, i, exportData);
                 exportData.Free();
-                if (!textureMovie->hasTextureData())
-                {
-                    delete textureMovie;
+                if (!textureMovie.hasTextureData())
                     continue;
+                entry.movieTexture = true;
+                entry.crc = textureMovie.getCrcData();
+                entry.type = TextureType::Movie;
+                if (generateBuiltinMapFiles)
+                {
+                    entry.width = textureMovie.getProperties().getProperty("SizeX").getValueInt();
+                    entry.height = textureMovie.getProperties().getProperty("SizeY").getValueInt();
+                    entry.pixfmt = Image::getPixelFormatType(textureMovie.getProperties().getProperty("Format").getValueName());
                 }
-                matchTexture.movieTexture = true;
-                crc = textureMovie->getCrcData();
             }
             else if (id == package.nameIdTextureCube)
             {
-                textureCube = new TextureCube(package, i, exportData);
+                TextureCube textureCube(package, i, exportData);
                 exportData.Free();
-                delete textureCube;
                 continue;
             }
             else
             {
-                texture = new Texture(package, i, exportData);
-                exportData.Free();
-                if (!texture->hasImageData())
-                {
-                    delete texture;
+                TextureView texture(package, i, std::move(exportData));
+                if (!texture.hasImageData())
                     continue;
-                }
-
-                matchTexture.numMips = texture->numNotEmptyMips();
-                crc = texture->getCrcTopMipmap();
-            }
-
-            if (crc == 0)
-            {
-                if (g_ipc)
-                {
-                    ConsoleWrite(QString("[IPC]ERROR Texture ") + exp.objectName + " is broken in package: " +
-                                 packagePath + "\nExport Id: " + QString::number(i + 1) + "\nSkipping...");
-                    ConsoleSync();
-                }
-                else
-                {
-                    PERROR(QString("Error: Texture ") + exp.objectName + " is broken in package: " +
-                                 packagePath +"\nExport Id: " + QString::number(i + 1) + "\nSkipping...\n");
-                }
-                delete textureMovie;
-                delete texture;
-                continue;
-            }
-
-            int foundTextureIndex = -1;
-            for (int k = 0; k < textures.count(); k++)
-            {
-                if (textures[k].crc == crc)
-                {
-                    foundTextureIndex = k;
-                    break;
-                }
-            }
-            QString packagePathLower = packagePath.toLower();
-            if (foundTextureIndex != -1)
-            {
-                const TextureMapEntry& foundTexName = textures[foundTextureIndex];
-                if (modified)
-                {
-                    bool found = false;
-                    for (int s = 0; s < foundTexName.list.count(); s++)
-                    {
-                        if (foundTexName.list[s].exportID == i &&
-                            AsciiStringMatchCaseIgnore(foundTexName.list[s].path, packagePathLower))
-                        {
-                            found = true;
-                            break;
-                        }
-                    }
-                    if (found)
-                    {
-                        delete textureMovie;
-                        delete texture;
-                        continue;
-                    }
-                }
-                textures[foundTextureIndex].list.push_back(matchTexture);
-            }
-            else
-            {
-                if (modified)
-                {
-                    for (int k = 0; k < textures.count(); k++)
-                    {
-                        bool found = false;
-                        for (int t = 0; t < textures[k].list.count(); t++)
-                        {
-                            if (textures[k].list[t].exportID == i &&
-                                AsciiStringMatchCaseIgnore(textures[k].list[t].path, packagePathLower))
-                            {
-                                TextureMapPackageEntry f = textures[k].list[t];
-                                f.path = "";
-                                textures[k].list[t] = f;
-                                found = true;
-                                break;
-                            }
-                        }
-                        if (found)
-                            break;
-                    }
-                }
-                TextureMapEntry foundTex;
-                foundTex.name = exp.objectName;
-                foundTex.crc = crc;
 
-                if (id == package.nameIdTextureMovie)
-                {
-                    if (generateBuiltinMapFiles)
-                    {
-                        foundTex.width = textureMovie->getProperties().getProperty("SizeX").getValueInt();
-                        foundTex.height = textureMovie->getProperties().getProperty("SizeY").getValueInt();
-                        foundTex.pixfmt = Image::getPixelFormatType(textureMovie->getProperties().getProperty("Format").getValueName());
-                        foundTex.type = TextureType::Movie;
-                    }
-                }
-                else
+                entry.numMips = texture.numNotEmptyMips();
+                entry.crc = texture.getCrcTopMipmap();
+                if (entry.crc != 0)
                 {
-                    foundTex.width = texture->getTopMipmap().width;
-                    foundTex.height = texture->getTopMipmap().height;
-                    foundTex.pixfmt = Image::getPixelFormatType(texture->getProperties().getProperty("Format").getValueName());
-                    if (texture->getProperties().exists("CompressionSettings"))
+                    entry.width = texture.getTopMipmap().width;
+                    entry.height = texture.getTopMipmap().height;
+                    entry.pixfmt = Image::getPixelFormatType(texture.getProperties().getProperty("Format").getValueName());
+                    if (texture.getProperties().exists("CompressionSettings"))
                     {
-                        QString cmp = texture->getProperties().getProperty("CompressionSettings").getValueName();
+                        QString cmp = texture.getProperties().getProperty("CompressionSettings").getValueName();
                         if (cmp == "TC_OneBitAlpha")
                         {
-                            foundTex.type = TextureType::OneBitAlpha;
-                            matchTexture.hasAlphaData = true;
+                            entry.type = TextureType::OneBitAlpha;
+                            entry.hasAlphaData = true;
                         }
                         else if (cmp == "TC_Displacementmap")
-                            foundTex.type = TextureType::Displacementmap;
+                            entry.type = TextureType::Displacementmap;
                         else if (cmp == "TC_Grayscale")
-                            foundTex.type = TextureType::GreyScale;
+                            entry.type = TextureType::GreyScale;
                         else if (cmp == "TC_Normalmap" ||
                             cmp == "TC_NormalmapHQ" ||
                             cmp == "TC_NormalmapAlpha" ||
@@ -873,14 +784,14 @@ void TreeScan::FindTextures(QList<TextureMapEntry> &textures, const QString &pac
                             cmp == "TC_NormalmapBC7" ||
                             cmp == "TC_NormalmapUncompressed")
                         {
-                            foundTex.type = TextureType::Normalmap;
+                            entry.type = TextureType::Normalmap;
                             if (cmp == "TC_NormalmapAlpha")
-                                matchTexture.hasAlphaData = true;
+                                entry.hasAlphaData = true;
                         }
                         else if (cmp == "TC_BC7" ||
                                  cmp == "TC_HighDynamicRange")
                         {
-                            foundTex.type = TextureType::Diffuse;
+                            entry.type = TextureType::Diffuse;
                         }
                         else
                         {
@@ -889,30 +800,182 @@ void TreeScan::FindTextures(QList<TextureMapEntry> &textures, const QString &pac
                     }
                     else
                     {
-                        foundTex.type = TextureType::Diffuse;
+                        entry.type = TextureType::Diffuse;
                     }
 
-                    if (foundTex.type == TextureType::Diffuse)
+                    if (entry.type == TextureType::Diffuse &&
+                        (entry.pixfmt == PixelFormat::DXT5 ||
+                         entry.pixfmt == PixelFormat::BC7 ||
+                         entry.pixfmt == PixelFormat::ARGB ||
+                         entry.pixfmt == PixelFormat::R10G10B10A2 ||
+                         entry.pixfmt == PixelFormat::R16G16B16A16))
                     {
-                        if (foundTex.pixfmt == PixelFormat::DXT5 ||
-                            foundTex.pixfmt == PixelFormat::BC7 ||
-                            foundTex.pixfmt == PixelFormat::ARGB ||
-                            foundTex.pixfmt == PixelFormat::R10G10B10A2 ||
-                            foundTex.pixfmt == PixelFormat::R16G16B16A16)
+                        // alpha detection is needed only for textures which will be added to the map
+                        if (knownCrcs == nullptr ||
+                            (!knownCrcs->contains(entry.crc) && !scannedCrcs.contains(entry.crc)))
                         {
-                            ByteBuffer data = texture->getTopImageData();
-                            auto pixels = Image::convertRawToInternal(data, foundTex.width, foundTex.height, foundTex.pixfmt);
-                            matchTexture.hasAlphaData = Image::InternalDetectAlphaData(pixels, foundTex.width, foundTex.height);
+                            ByteBuffer data = texture.getTopImageData();
+                            auto pixels = Image::convertRawToInternal(data, entry.width, entry.height, entry.pixfmt);
+                            entry.hasAlphaData = Image::InternalDetectAlphaData(pixels, entry.width, entry.height);
                             data.Free();
                             pixels.Free();
                         }
+                        else
+                        {
+                            entry.alphaDetected = false;
+                        }
+                    }
+                }
+            }
+
+            if (entry.crc == 0)
+                entry.status = TextureScanEntry::BrokenTexture;
+            else
+                scannedCrcs.insert(entry.crc);
+            entries.push_back(entry);
+        }
+    }
+
+    return true;
+}
+
+bool TreeScan::CanMergeScanEntries(const QHash<uint, int> &crcIndex,
+                                   const QList<TextureScanEntry> &entries)
+{
+    QSet<uint> addedCrcs;
+    for (const auto &entry : entries)
+    {
+        if (entry.status != TextureScanEntry::Ok)
+            continue;
+        if (!entry.alphaDetected && !crcIndex.contains(entry.crc) && !addedCrcs.contains(entry.crc))
+            return false;
+        addedCrcs.insert(entry.crc);
+    }
+    return true;
+}
+
+void TreeScan::MergeScanEntries(QList<TextureMapEntry> &textures, QHash<uint, int> &crcIndex,
+                                const QString &packagePath, const QList<TextureScanEntry> &entries,
+                                bool modified)
+{
+    QString packagePathLower = packagePath.toLower();
+    for (const auto &entry : entries)
+    {
+        if (entry.status == TextureScanEntry::BrokenExportData)
+        {
+            if (g_ipc)
+            {
+                IpcChannel::Send(IpcEvent::Error, QString("Texture ") + entry.name +
+                                 " has broken export data in package: " +
+                                 packagePath + "\nExport Id: " + QString::number(entry.exportID + 1) + "\nSkipping...");
+            }
+            else
+            {
+                PERROR(QString("Error: Texture ") + entry.name +
+                             " has broken export data in package: " +
+                             packagePath +"\nExport Id: " + QString::number(entry.exportID + 1) + "\nSkipping...\n");
+            }
+            continue;
+        }
+        if (entry.status == TextureScanEntry::BrokenTexture)
+        {
+            if (g_ipc)
+            {
+                IpcChannel::Send(IpcEvent::Error, QString("Texture ") + entry.name + " is broken in package: " +
+                                 packagePath + "\nExport Id: " + QString::number(entry.exportID + 1) + "\nSkipping...");
+            }
+            else
+            {
+                PERROR(QString("Error: Texture ") + entry.name + " is broken in package: " +
+                             packagePath +"\nExport Id: " + QString::number(entry.exportID + 1) + "\nSkipping...\n");
+            }
+            continue;
+        }
+
+        TextureMapPackageEntry matchTexture{};
+        matchTexture.exportID = entry.exportID;
+        matchTexture.path = packagePath;
+        matchTexture.numMips = entry.numMips;
+        matchTexture.movieTexture = entry.movieTexture;
+        matchTexture.hasAlphaData = false;
+
+        auto foundTexture = crcIndex.constFind(entry.crc);
+        if (foundTexture != crcIndex.constEnd())
+        {
+            int foundTextureIndex = foundTexture.value();
+            const TextureMapEntry& foundTexName = textures[foundTextureIndex];
+            if (modified)
+            {
+                bool found = false;
+                for (int s = 0; s < foundTexName.list.count(); s++)
+                {
+                    if (foundTexName.list[s].exportID == entry.exportID &&
+                        AsciiStringMatchCaseIgnore(foundTexName.list[s].path, packagePathLower))
+                    {
+                        found = true;
+                        break;
+                    }
+                }
+                if (found)
+                    continue;
+            }
+            textures[foundTextureIndex].list.push_back(matchTexture);
+        }
+        else
+        {
+            if (modified)
+            {
+                for (int k = 0; k < textures.count(); k++)
+                {
+                    bool found = false;
+                    for (int t = 0; t < textures[k].list.count(); t++)
+                    {
+                        if (textures[k].list[t].exportID == entry.exportID &&
+                            AsciiStringMatchCaseIgnore(textures[k].list[t].path, packagePathLower))
+                        {
+                            TextureMapPackageEntry f = textures[k].list[t];
+                            f.path = "";
+                            textures[k].list[t] = f;
+                            found = true;
+                            break;
+                        }
                     }
+                    if (found)
+                        break;
                 }
-                foundTex.list.push_back(matchTexture);
-                textures.push_back(foundTex);
             }
-            delete textureMovie;
-            delete texture;
+            TextureMapEntry foundTex;
+            foundTex.name = entry.name;
+            foundTex.crc = entry.crc;
+            foundTex.width = entry.width;
+            foundTex.height = entry.height;
+            foundTex.pixfmt = entry.pixfmt;
+            foundTex.type = entry.type;
+            matchTexture.hasAlphaData = entry.hasAlphaData;
+            foundTex.list.push_back(matchTexture);
+            crcIndex.insert(foundTex.crc, textures.count());
+            textures.push_back(foundTex);
         }
     }
 }
+
+void TreeScan::FindTextures(QList<TextureMapEntry> &textures, QHash<uint, int> &crcIndex,
+                            TextureScanCache *scanCache, const QString &packagePath, bool modified)
+{
+    QList<TextureScanEntry> entries;
+    if (scanCache && scanCache->Get(packagePath, entries))
+    {
+        if (CanMergeScanEntries(crcIndex, entries))
+        {
+            MergeScanEntries(textures, crcIndex, packagePath, entries, modified);
+            return;
+        }
+        entries.clear();
+    }
+
+    if (!ScanPackage(packagePath, entries, &crcIndex))
+        return;
+    if (scanCache)
+        scanCache->Put(packagePath, entries);
+    MergeScanEntries(textures, crcIndex, packagePath, entries, modified);
+}
@@ -27,6 +27,8 @@
 #include <GameData/Properties.h>
 #include <Resources/Resources.h>
 
+class TextureMapView;
+
 struct Texture4kNormEntry
 {
     QString path;
@@ -44,6 +46,28 @@ struct TextureMapPackageEntry
     bool hasAlphaData;
 };
 
+struct TextureScanEntry
+{
+    enum ScanStatus
+    {
+        Ok = 0,
+        BrokenExportData,
+        BrokenTexture,
+    };
+
+    int exportID;
+    QString name;
+    uint crc;
+    int width, height;
+    PixelFormat pixfmt;
+    TextureType type;
+    int numMips;
+    bool movieTexture;
+    bool hasAlphaData;
+    bool alphaDetected;
+    ScanStatus status;
+};
+
 struct TextureMapEntry
 {
     QString name;
@@ -54,23 +78,35 @@ struct TextureMapEntry
     int width, height;
 };
 
+class TextureScanCache;
+
 class TreeScan
 {
 private:
 
-    static void FindTextures(QList<TextureMapEntry> &textures,
-                             const QString &packagePath, bool modified);
+    static bool ScanPackage(const QString &packagePath, QList<TextureScanEntry> &entries,
+                            const QHash<uint, int> *knownCrcs);
+    static bool CanMergeScanEntries(const QHash<uint, int> &crcIndex,
+                                    const QList<TextureScanEntry> &entries);
+    static void MergeScanEntries(QList<TextureMapEntry> &textures, QHash<uint, int> &crcIndex,
+                                 const QString &packagePath, const QList<TextureScanEntry> &entries,
+                                 bool modified);
+    static void FindTextures(QList<TextureMapEntry> &textures, QHash<uint, int> &crcIndex,
+                             TextureScanCache *scanCache, const QString &packagePath, bool modified);
 
 public:
 
     typedef void (*ProgressCallback)(void *handle, int progress, const QString &stage);
 
     TreeScan() = default;
-    static void loadTexturesMap(MeType gameId, Resources &resources, QList<TextureMapEntry> &textures);
+    static void loadTexturesMap(MeType gameId, QList<TextureMapEntry> &textures);
     static bool loadTexturesMapFile(QString &path, QList<TextureMapEntry> &textures, bool ignoreCheck = false);
+    // Current map is opened as view for lookups, old version is loaded to textures list
+    static bool openTexturesMapFile(QString &path, TextureMapView &view,
+                                    QList<TextureMapEntry> &textures, bool ignoreCheck = false);
     static void loadTexturesMapFileV1(Stream &streeam, QList<TextureMapEntry> &textures, QStringList &packages);
-    static bool PrepareListOfTextures(MeType gameId, Resources &resources,
-                                     QList<TextureMapEntry> &textures, bool saveMapFile,
+    static bool loadTexturesMapPackages(const QString &path, QStringList &packages);
+    static bool PrepareListOfTextures(MeType gameId, QList<TextureMapEntry> &textures, bool saveMapFile,
                                      ProgressCallback callback, void *callbackHandle);
     static bool IsBlankTexture(uint crc);
 };
@@ -0,0 +1,193 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <Texture/TextureScanCache.h>
+#include <GameData/GameData.h>
+#include <Helpers/CacheFile.h>
+#include <Helpers/Crc32Fast.h>
+#include <Helpers/MemoryStream.h>
+#include <Helpers/MiscHelpers.h>
+#include <Helpers/Logs.h>
+
+TextureScanCache::TextureScanCache(MeType gameId)
+{
+    QString path = QStandardPaths::standardLocations(QStandardPaths::GenericConfigLocation).first() +
+            "/MassEffectModder";
+    if (!QDir(path).exists())
+        QDir(path).mkpath(path);
+    cachePath = path + QString("/mele%1scan.bin").arg((int)gameId);
+    Load();
+}
+
+void TextureScanCache::Load()
+{
+    if (!QFile(cachePath).exists())
+        return;
+
+    CacheFileReader fs(cachePath);
+    if (fs.ReadUInt32() != scanCacheBinTag)
+    {
+        PDEBUG("TextureScanCache: wrong cache file, ignoring: " + cachePath + "\n");
+        return;
+    }
+    if (fs.ReadUInt32() != scanCacheBinVersion)
+    {
+        PDEBUG("TextureScanCache: unsupported cache version, ignoring: " + cachePath + "\n");
+        return;
+    }
+    int countPackages = fs.ReadInt32();
+    // key terminator, size, mtime, header CRC and textures count
+    if (!fs.CheckCount(countPackages, 2 + 8 + 8 + 4 + 4))
+    {
+        PDEBUG("TextureScanCache: broken cache file, ignoring: " + cachePath + "\n");
+        return;
+    }
+    entries.reserve(countPackages);
+    for (int i = 0; i < countPackages && !fs.Failed(); i++)
+    {
+        QString key;
+        CacheEntry entry{};
+        fs.ReadStringUnicode16Null(key);
+        entry.size = fs.ReadInt64();
+        entry.mtime = fs.ReadInt64();
+        entry.headerCrc = fs.ReadUInt32();
+        int countTextures = fs.ReadInt32();
+        if (!fs.CheckCount(countTextures, 4 + 4 + 4 + 4 + 4 + 1 + 1 + 4 + 1 + 1))
+            break;
+        for (int t = 0; t < countTextures && !fs.Failed(); t++)
+        {
+            TextureScanEntry texture{};
+            texture.exportID = fs.ReadInt32();
+            int len = fs.ReadInt32();
+            fs.ReadStringASCII(texture.name, len);
+            texture.crc = fs.ReadUInt32();
+            texture.width = fs.ReadInt32();
+            texture.height = fs.ReadInt32();
+            texture.pixfmt = (PixelFormat)fs.ReadByte();
+            texture.type = (TextureType)fs.ReadByte();
+            texture.numMips = fs.ReadInt32();
+            quint8 flags = fs.ReadByte();
+            texture.movieTexture = (flags & 1) == 1;
+            texture.hasAlphaData = (flags & 2) == 2;
+            texture.alphaDetected = (flags & 4) == 4;
+            texture.status = (TextureScanEntry::ScanStatus)fs.ReadByte();
+            entry.textures.push_back(texture);
+        }
+        entries.insert(key, entry);
+    }
+    if (fs.Failed() || fs.Remaining() != 0)
+    {
+        PDEBUG("TextureScanCache: broken cache file, ignoring: " + cachePath + "\n");
+        entries.clear();
+    }
+}
+
+void TextureScanCache::Save()
+{
+    if (!modified && usedEntries.count() == entries.count())
+        return;
+
+    MemoryStream mem;
+    mem.WriteUInt32(scanCacheBinTag);
+    mem.WriteUInt32(scanCacheBinVersion);
+    mem.WriteInt32(usedEntries.count());
+    for (auto it = entries.constBegin(); it != entries.constEnd(); it++)
+    {
+        // entries of packages not scanned this time are dropped
+        if (!usedEntries.contains(it.key()))
+            continue;
+        mem.WriteStringUnicode16Null(it.key());
+        mem.WriteInt64(it.value().size);
+        mem.WriteInt64(it.value().mtime);
+        mem.WriteUInt32(it.value().headerCrc);
+        mem.WriteInt32(it.value().textures.count());
+        for (const auto &texture : it.value().textures)
+        {
+            mem.WriteInt32(texture.exportID);
+            mem.WriteInt32(texture.name.length());
+            mem.WriteStringASCII(texture.name);
+            mem.WriteUInt32(texture.crc);
+            mem.WriteInt32(texture.width);
+            mem.WriteInt32(texture.height);
+            mem.WriteByte(texture.pixfmt);
+            mem.WriteByte(texture.type);
+            mem.WriteInt32(texture.numMips);
+            quint8 flags = texture.movieTexture ? 1 : 0;
+            flags |= texture.hasAlphaData ? 2 : 0;
+            flags |= texture.alphaDetected ? 4 : 0;
+            mem.WriteByte(flags);
+            mem.WriteByte(texture.status);
+        }
+    }
+    if (!WriteCacheFile(cachePath, mem))
+    {
+        PDEBUG("TextureScanCache: failed to write cache file: " + cachePath + "\n");
+        return;
+    }
+    modified = false;
+}
+
+bool TextureScanCache::getPackageKey(const QString &path, qint64 &size, qint64 &mtime, quint32 &headerCrc)
+{
+    quint64 inode;
+    if (!GetFileStat(path, size, mtime, inode))
+        return false;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    QByteArray header = file.read(HeaderHashSize);
+    headerCrc = ~crc32_hw(header.constData(), header.size());
+    return true;
+}
+
+bool TextureScanCache::Get(const QString &packagePath, QList<TextureScanEntry> &textures)
+{
+    QString key = packagePath.toLower();
+    auto it = entries.constFind(key);
+    if (it == entries.constEnd())
+        return false;
+
+    qint64 size, mtime;
+    quint32 headerCrc;
+    if (!getPackageKey(g_GameData->GamePath() + packagePath, size, mtime, headerCrc) ||
+        it.value().size != size || it.value().mtime != mtime || it.value().headerCrc != headerCrc)
+    {
+        return false;
+    }
+
+    textures = it.value().textures;
+    usedEntries.insert(key);
+    return true;
+}
+
+void TextureScanCache::Put(const QString &packagePath, const QList<TextureScanEntry> &textures)
+{
+    CacheEntry entry{};
+    if (!getPackageKey(g_GameData->GamePath() + packagePath, entry.size, entry.mtime, entry.headerCrc))
+        return;
+    entry.textures = textures;
+
+    QString key = packagePath.toLower();
+    entries.insert(key, entry);
+    usedEntries.insert(key);
+    modified = true;
+}
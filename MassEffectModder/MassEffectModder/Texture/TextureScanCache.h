@@ -0,0 +1,60 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef TEXTURE_SCAN_CACHE_H
+#define TEXTURE_SCAN_CACHE_H
+
+#include <Texture/TextureScan.h>
+
+class TextureScanCache
+{
+private:
+
+    enum
+    {
+        HeaderHashSize = 0x10000, // 64KB
+    };
+
+    struct CacheEntry
+    {
+        qint64 size;
+        qint64 mtime;
+        quint32 headerCrc;
+        QList<TextureScanEntry> textures;
+    };
+
+    QHash<QString, CacheEntry> entries;
+    QSet<QString> usedEntries;
+    QString cachePath;
+    bool modified = false;
+
+    static bool getPackageKey(const QString &path, qint64 &size, qint64 &mtime, quint32 &headerCrc);
+    void Load();
+
+public:
+
+    explicit TextureScanCache(MeType gameId);
+    bool Get(const QString &packagePath, QList<TextureScanEntry> &textures);
+    void Put(const QString &packagePath, const QList<TextureScanEntry> &textures);
+    void Save();
+};
+
+#endif
@@ -0,0 +1,258 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include <Helpers/MiscHelpers.h>
+#include <Helpers/Crc32Fast.h>
+#include <GameData/GameData.h>
+#include <Texture/TextureView.h>
+#include <Types/MemTypes.h>
+
+#define TEXTURE_VIEW_PREFIX_READ_SIZE 4096
+
+UniqueByteBuffer TextureView::getTopMipExportData(Package &package, int exportId)
+{
+    uint exportSize = package.exportsTable[exportId].getDataSize();
+    UniqueByteBuffer data(exportSize);
+    quint8 *ptr = data.ptr();
+
+    // Ranges are read in export order, bytes inside of already read prefix are skipped
+    uint readEnd = 0;
+    auto read = [&](uint offset, uint length)
+    {
+        if ((quint64)offset + length > exportSize)
+            return false;
+        if (offset + length <= readEnd)
+            return true;
+        if (offset < readEnd)
+        {
+            length -= readEnd - offset;
+            offset = readEnd;
+        }
+        if (!package.getExportDataRange(exportId, offset, length, ptr + offset))
+            return false;
+        if (offset == readEnd)
+            readEnd = offset + length;
+        return true;
+    };
+
+    uint offset = package.getPropertiesOffset(exportId);
+    if (!read(0, qMin(exportSize, (uint)TEXTURE_VIEW_PREFIX_READ_SIZE)) || !read(0, offset))
+        return {};
+
+    for (;;)
+    {
+        if (!read(offset, 8))
+            return {};
+        if (package.getName(*reinterpret_cast<qint32 *>(ptr + offset)) == "None")
+        {
+            offset += 8;
+            break;
+        }
+        if (!read(offset + 8, 16))
+            return {};
+        QString type = package.getName(*reinterpret_cast<qint32 *>(ptr + offset + 8));
+        uint size = *reinterpret_cast<qint32 *>(ptr + offset + 16);
+        if (type == "StructProperty" || type == "ByteProperty")
+            size += 8;
+        else if (type == "BoolProperty")
+            size = 1;
+        else if (type != "IntProperty" && type != "StrProperty" && type != "FloatProperty" &&
+                 type != "NameProperty" && type != "ObjectProperty")
+        {
+            // Not expected property layout, let full parser handle it
+            return package.getExportData(exportId);
+        }
+        if (!read(offset + 24, size))
+            return {};
+        offset += 24 + size;
+    }
+    if (offset == exportSize)
+        return data;
+
+    if (GameData::gameType != MeType::ME3_TYPE)
+        offset += 16;
+    if (!read(offset, 4))
+        return {};
+    int numMipMaps = *reinterpret_cast<qint32 *>(ptr + offset);
+    offset += 4;
+    bool topMipFound = false;
+    for (int l = 0; l < numMipMaps; l++)
+    {
+        if (!read(offset, 16))
+            return {};
+        auto storageType = (StorageTypes)*reinterpret_cast<qint32 *>(ptr + offset);
+        uint uncompressedSize = *reinterpret_cast<qint32 *>(ptr + offset + 4);
+        uint compressedSize = *reinterpret_cast<qint32 *>(ptr + offset + 8);
+        offset += 16;
+        uint size = 0;
+        if (storageType == StorageTypes::pccUnc)
+            size = uncompressedSize;
+        else if (storageType == StorageTypes::pccZlib || storageType == StorageTypes::pccOodle)
+            size = compressedSize;
+        if (!topMipFound && storageType != StorageTypes::empty)
+        {
+            topMipFound = true;
+            if (!read(offset, size))
+                return {};
+        }
+        offset += size;
+        if (!read(offset, 8))
+            return {};
+        offset += 8;
+    }
+
+    return data;
+}
+
+TextureView::TextureView(Package &package, int exportId, UniqueByteBuffer &&data, bool fixDim)
+{
+    dataExportId = exportId;
+    exportData = std::move(data);
+    properties = new Properties(package, exportData, package.getPropertiesOffset(exportId));
+    if (exportData.size() == properties->propertyEndOffset)
+        return;
+
+    mipsData = exportData.ptr() + properties->propertyEndOffset;
+    textureData = new MemoryStream(mipsData, exportData.size() - properties->propertyEndOffset);
+    if (GameData::gameType != MeType::ME3_TYPE)
+    {
+        textureData->Skip(12); // 12 zeros
+        textureData->SkipInt32(); // position in the package
+    }
+
+    Texture::parseMipMaps(*textureData, mipMapsList, fixDim);
+
+    packagePath = package.packagePath;
+    packageName = BaseNameWithoutExt(packagePath).toLower();
+}
+
+TextureView::~TextureView()
+{
+    delete textureData;
+    delete properties;
+}
+
+uint TextureView::getCrcMipmap(const Texture::TextureMipMap &mipmap)
+{
+    if (mipmap.storageType == StorageTypes::pccUnc)
+    {
+        if (mipmap.uncompressedSize == 0)
+            return 0;
+        if (mipmap.internalOffset + mipmap.uncompressedSize > textureData->Length())
+            return 0;
+        return ~crc32_parallel(mipsData + mipmap.internalOffset, mipmap.uncompressedSize);
+    }
+
+    return Texture::readMipMapCrc(*textureData, mipmap, *properties, packagePath, dataExportId);
+}
+
+uint TextureView::getCrcMipmapByIndex(int index)
+{
+    if (mipMapsList.count() == 0 || index < 0 || index >= mipMapsList.count())
+        return 0;
+
+    return getCrcMipmap(mipMapsList[index]);
+}
+
+uint TextureView::getCrcTopMipmap()
+{
+    if (mipMapsList.count() == 0)
+        return 0;
+
+    return getCrcMipmap(getTopMipmap());
+}
+
+const Texture::TextureMipMap& TextureView::getMipMapByIndex(int index)
+{
+    if (mipMapsList.count() == 0 || index < 0 || index >= mipMapsList.count())
+        CRASH();
+
+    return mipMapsList[index];
+}
+
+const Texture::TextureMipMap& TextureView::getTopMipmap()
+{
+    for (int l = 0; l < mipMapsList.count(); l++)
+    {
+        if (mipMapsList[l].storageType != StorageTypes::empty)
+            return mipMapsList[l];
+    }
+    CRASH();
+}
+
+const ByteBuffer TextureView::getTopImageData()
+{
+    if (mipMapsList.count() == 0)
+        return ByteBuffer();
+
+    return getMipMapData(getTopMipmap());
+}
+
+const ByteBuffer TextureView::getMipMapDataByIndex(int index)
+{
+    if (mipMapsList.count() == 0 || index < 0 || index >= mipMapsList.count())
+        return ByteBuffer();
+
+    return getMipMapData(mipMapsList[index]);
+}
+
+const ByteBuffer TextureView::getMipMapData(const Texture::TextureMipMap &mipmap)
+{
+    return Texture::readMipMapData(*textureData, mipmap, *properties, packagePath, dataExportId);
+}
+
+void TextureView::removeEmptyMips()
+{
+    for (int l = 0; l < mipMapsList.count(); l++)
+    {
+        if (mipMapsList[l].storageType == StorageTypes::empty)
+        {
+            mipMapsList.removeAt(l--);
+        }
+    }
+}
+
+int TextureView::numNotEmptyMips()
+{
+    int num = 0;
+    for (int l = 0; l < mipMapsList.count(); l++)
+    {
+        if (mipMapsList[l].storageType != StorageTypes::empty)
+            num++;
+    }
+    return num;
+}
+
+bool TextureView::HasExternalMips()
+{
+    for (int l = 0; l < mipMapsList.count(); l++)
+    {
+        if (mipMapsList[l].storageType == StorageTypes::extUnc ||
+            mipMapsList[l].storageType == StorageTypes::extUnc2 ||
+            mipMapsList[l].storageType == StorageTypes::extOodle ||
+            mipMapsList[l].storageType == StorageTypes::extZlib)
+        {
+            return true;
+        }
+    }
+    return false;
+}
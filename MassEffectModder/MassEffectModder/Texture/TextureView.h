@@ -0,0 +1,73 @@
+/*
+ * MassEffectModder
+ *
+ * Copyright (C) 2021 Pawel Kolodziejski
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#ifndef TEXTURE_VIEW_H
+#define TEXTURE_VIEW_H
+
+#include <Helpers/MemoryStream.h>
+#include <GameData/Package.h>
+#include <GameData/Properties.h>
+#include <Texture/Texture.h>
+
+// Read-only texture parsed in place over export data.
+// View takes ownership of export data, it is not copied.
+class TextureView
+{
+private:
+
+    UniqueByteBuffer exportData;
+    const quint8 *mipsData = nullptr;
+    MemoryStream *textureData = nullptr;
+    QString packagePath;
+    Properties *properties;
+
+public:
+
+    QList<Texture::TextureMipMap> mipMapsList;
+    QString packageName;
+    int dataExportId;
+
+    TextureView(Package &package, int exportId, UniqueByteBuffer &&data, bool fixDim = true);
+    TextureView(const TextureView &) = delete;
+    TextureView &operator=(const TextureView &) = delete;
+    ~TextureView();
+    Properties& getProperties() { return *properties; }
+    uint getCrcMipmap(const Texture::TextureMipMap &mipmap);
+    uint getCrcMipmapByIndex(int index);
+    uint getCrcTopMipmap();
+    const Texture::TextureMipMap& getMipMapByIndex(int index);
+    const Texture::TextureMipMap& getTopMipmap();
+    bool hasImageData() { return mipMapsList.count() != 0; }
+    const ByteBuffer getTopImageData();
+    const ByteBuffer getMipMapDataByIndex(int index);
+    const ByteBuffer getMipMapData(const Texture::TextureMipMap &mipmap);
+    void removeEmptyMips();
+    int numNotEmptyMips();
+    int getNumMipmaps() { return mipMapsList.count(); }
+    bool HasExternalMips();
+
+    // Reads only properties, mip table and top mip of texture export.
+    // Remaining bytes of returned buffer are left uninitialized.
+    static UniqueByteBuffer getTopMipExportData(Package &package, int exportId);
+};
+
+#endif
@@ -68,7 +68,16 @@ typedef enum
 } CompressionDataType;
 
 #define textureMapBinTag      0x5054454D
-#define textureMapBinVersion  1
+#define textureMapBinVersion  2
+#define textureMapBuiltinVersion 1
+#define md5CacheBinTag        0x4335444D
+#define md5CacheBinVersion    1
+#define markersManifestBinTag 0x4B524D4D
+#define markersManifestBinVersion 1
+#define scanCacheBinTag       0x4E414353
+#define scanCacheBinVersion   1
+#define packageCacheBinTag    0x48434B50
+#define packageCacheBinVersion 1
 #define TextureModTag         0x444F4D54
 #define TextureModVersion     3
 #define FileTextureTag        0x53444446
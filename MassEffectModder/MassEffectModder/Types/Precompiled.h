@@ -26,6 +26,7 @@
 #include <cmath>
 #include <string>
 #include <utility>
+#include <atomic>
 #include <mutex>
 #include <memory>
 
@@ -42,6 +43,7 @@
 #include <QFileInfo>
 #include <QList>
 #include <QMap>
+#include <QSaveFile>
 #include <QSet>
 #include <QSettings>
 #include <QStandardPaths>
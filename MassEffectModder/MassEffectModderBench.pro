@@ -0,0 +1,10 @@
+include(MassEffectModderCommon.pri)
+
+ZSTD_ENABLE = false
+cache(ZSTD_ENABLE, set)
+
+GUI_MODE = false
+cache(GUI_MODE, set)
+
+BENCH_MODE = true
+cache(BENCH_MODE, set)
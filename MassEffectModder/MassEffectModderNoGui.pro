@@ -5,3 +5,6 @@ cache(ZSTD_ENABLE, set)
 
 GUI_MODE = false
 cache(GUI_MODE, set)
+
+BENCH_MODE = false
+cache(BENCH_MODE, set)
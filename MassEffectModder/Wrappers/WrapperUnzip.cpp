@@ -28,6 +28,12 @@
 #include <cstring>
 #include <cstdio>
 #include <cerrno>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 #include <sys/types.h>
 #include <sys/stat.h>
 
@@ -242,6 +248,57 @@ int ZipReadCurrentFileToOutputFile(void *handle, const void *outputFile,
     return 0;
 }
 
+int ZipOpenCurrentFile(void *handle)
+{
+    auto unzipHandle = static_cast<UnzipHandle *>(handle);
+
+    if (unzipHandle == nullptr)
+        return -1;
+
+    return unzOpenCurrentFile(unzipHandle->file);
+}
+
+int ZipReadCurrentFileChunk(void *handle, unsigned char *dst, unsigned int len)
+{
+    auto unzipHandle = static_cast<UnzipHandle *>(handle);
+
+    if (unzipHandle == nullptr || dst == nullptr)
+        return -1;
+
+    return unzReadCurrentFile(unzipHandle->file, dst, len);
+}
+
+int ZipCloseCurrentFile(void *handle)
+{
+    auto unzipHandle = static_cast<UnzipHandle *>(handle);
+
+    if (unzipHandle == nullptr)
+        return -1;
+
+    return unzCloseCurrentFile(unzipHandle->file);
+}
+
+int ZipGetCurrentFileDataOffset(void *handle, unsigned long long *offset, bool *stored)
+{
+    auto unzipHandle = static_cast<UnzipHandle *>(handle);
+    int result;
+
+    if (unzipHandle == nullptr || offset == nullptr || stored == nullptr)
+        return -1;
+
+    result = unzGetCurrentFileInfo64(unzipHandle->file, &unzipHandle->curFileInfo,
+                                     nullptr, 0, nullptr, 0, nullptr, 0);
+    if (result != UNZ_OK)
+        return result;
+
+    // Valid only after ZipOpenCurrentFile(), points to entry data in archive file
+    *offset = unzGetCurrentFileZStreamPos64(unzipHandle->file);
+    *stored = unzipHandle->curFileInfo.compression_method == 0 &&
+              (unzipHandle->curFileInfo.flag & 1) == 0;
+
+    return 0;
+}
+
 void ZipClose(void *handle)
 {
     auto unzipHandle = static_cast<UnzipHandle *>(handle);
@@ -317,15 +374,35 @@ static bool compareExt(char *filename, const char *ext)
 }
 #endif
 
+#define UNPACK_MAX_WRITERS 4
+
+#if defined(_WIN32)
+typedef std::wstring UnpackPath;
+#else
+typedef std::string UnpackPath;
+#endif
+
+struct ZipUnpackEntry
+{
+    int index;
+    std::string fileName;
+    unsigned long long size;
+    unsigned long flags;
+    unz64_file_pos pos;
+    UnpackPath outputFile;
+};
+
 static bool g_ipc;
 static int lastProgress;
 static ZPOS64_T progressUnpackedSize;
 static ZPOS64_T totalUnpackedSize;
+static std::mutex unpackLock;
 
 static void PrintProgressIpc(ZPOS64_T processedBytes)
 {
     if (g_ipc)
     {
+        std::unique_lock<std::mutex> lock(unpackLock);
         progressUnpackedSize += processedBytes;
         int newProgress = progressUnpackedSize * 100 / totalUnpackedSize;
         if (lastProgress != newProgress)
@@ -341,6 +418,95 @@ static void PrintProgressIpc(ZPOS64_T processedBytes)
     }
 }
 
+static int ZipGoToFilePos(void *handle, const unz64_file_pos *pos)
+{
+    auto unzipHandle = static_cast<UnzipHandle *>(handle);
+
+    if (unzipHandle == nullptr || pos == nullptr)
+        return -1;
+
+    return unzGoToFilePos64(unzipHandle->file, pos);
+}
+
+static int ZipGetFilePos(void *handle, unz64_file_pos *pos)
+{
+    auto unzipHandle = static_cast<UnzipHandle *>(handle);
+
+    if (unzipHandle == nullptr || pos == nullptr)
+        return -1;
+
+    return unzGetFilePos64(unzipHandle->file, pos);
+}
+
+static bool ZipUnpackEntries(const void *path, const std::vector<ZipUnpackEntry> &entries,
+                             int numEntries, std::atomic<size_t> &nextEntry, std::atomic<bool> &failed)
+{
+    int entriesInArchive = 0;
+    void *handle = ZipOpenFromFile(path, &entriesInArchive);
+    if (handle == nullptr)
+    {
+#if defined(_WIN32)
+        fwprintf(stderr, L"Error: Failed to open archive!\n");
+#else
+        fprintf(stderr, "Error: Failed to open archive!\n");
+#endif
+        failed = true;
+        return false;
+    }
+
+    while (!failed)
+    {
+        size_t n = nextEntry++;
+        if (n >= entries.size())
+            break;
+        const ZipUnpackEntry &entry = entries[n];
+
+        if (g_ipc)
+        {
+            std::unique_lock<std::mutex> lock(unpackLock);
+#if defined(_WIN32)
+            wprintf(L"[IPC]FILENAME %s\n", entry.fileName.c_str());
+#else
+            printf("[IPC]FILENAME %s\n", entry.fileName.c_str());
+#endif
+            fflush(stdout);
+        }
+
+        if (ZipGoToFilePos(handle, &entry.pos) != UNZ_OK ||
+            ZipReadCurrentFileToOutputFile(handle, entry.outputFile.c_str(), PrintProgressIpc) != 0)
+        {
+#if defined(_WIN32)
+            fwprintf(stderr, L"Error: Failed to read file in archive, aborting!\n");
+#else
+            fprintf(stderr, "Error: Failed to read file in archive, aborting!\n");
+#endif
+            failed = true;
+            break;
+        }
+
+#if !defined(_WIN32)
+        if ((entry.flags >> 16) & 0xFFFF)
+            chmod(entry.outputFile.c_str(), (entry.flags >> 16) & 0xFFFF);
+#endif
+
+        if (!g_ipc)
+        {
+            std::unique_lock<std::mutex> lock(unpackLock);
+#if defined(_WIN32)
+            wprintf(L"%d of %d - %s - size %llu - Ok\n", (entry.index + 1), numEntries,
+                    entry.fileName.c_str(), entry.size);
+#else
+            printf("%d of %d - %s - size %llu - Ok\n", (entry.index + 1), numEntries,
+                   entry.fileName.c_str(), entry.size);
+#endif
+        }
+    }
+
+    ZipClose(handle);
+
+    return !failed;
+}
+
 int ZipUnpack(const void *path, const void *output_path,
               const void *filter, bool full_path, bool ipc)
 {
@@ -355,6 +521,10 @@ int ZipUnpack(const void *path, const void *output_path,
     auto filterExt = static_cast<const char *>(filter);
 #endif
     char fileName[260];
+    std::vector<ZipUnpackEntry> entries;
+    std::atomic<size_t> nextEntry(0);
+    std::atomic<bool> failed(false);
+    unsigned int numThreads;
 
     g_ipc = ipc;
     lastProgress = -1;
@@ -372,6 +542,8 @@ int ZipUnpack(const void *path, const void *output_path,
         goto failed;
     }
 
+    // Resolve output paths and create directories up front, entries are
+    // then decompressed in parallel, each worker with own archive handle.
     for (int i = 0; i < numEntries; i++)
     {
         unsigned long fileFlags = 0;
@@ -385,20 +557,6 @@ int ZipUnpack(const void *path, const void *output_path,
 #endif
             goto failed;
         }
-        if (filterExt[0] != 0 && (dstLen == 0 || !compareExt(fileName, filterExt)))
-        {
-            ZipGoToNextFile(handle);
-            continue;
-        }
-        totalUnpackedSize += dstLen;
-        ZipGoToNextFile(handle);
-    }
-
-    ZipGoToFirstFile(handle);
-    for (int i = 0; i < numEntries; i++)
-    {
-        unsigned long fileFlags = 0;
-        result = ZipGetCurrentFileInfo(handle, fileName, sizeof (fileName), &dstLen, &fileFlags);
         if (dstLen == 0)
         {
             if (!ipc)
@@ -415,26 +573,8 @@ int ZipUnpack(const void *path, const void *output_path,
 
         if (filterExt[0] != 0 && !compareExt(fileName, filterExt))
         {
-           ZipGoToNextFile(handle);
-           continue;
-        }
-
-        if (ipc)
-        {
-#if defined(_WIN32)
-            wprintf(L"[IPC]FILENAME %s\n", fileName);
-#else
-            printf("[IPC]FILENAME %s\n", fileName);
-#endif
-            fflush(stdout);
-        }
-        else
-        {
-#if defined(_WIN32)
-            wprintf(L"%d of %d - %s - size %llu - ", (i + 1), numEntries, fileName, dstLen);
-#else
-            printf("%d of %d - %s - size %llu - ", (i + 1), numEntries, fileName, dstLen);
-#endif
+            ZipGoToNextFile(handle);
+            continue;
         }
 
 #if defined(_WIN32)
@@ -496,12 +636,6 @@ int ZipUnpack(const void *path, const void *output_path,
                 }
             }
         }
-
-        if (result != 0)
-        {
-            result = 1;
-            break;
-        }
 #else
         char outputFile[PATH_MAX];
         if (outputDir && outputDir[0] != 0)
@@ -548,47 +682,55 @@ int ZipUnpack(const void *path, const void *output_path,
                 }
             }
         }
-        if (result != 0)
-        {
-            result = 1;
-            break;
-        }
 #endif
-
-        result = ZipReadCurrentFileToOutputFile(handle, outputFile, PrintProgressIpc);
         if (result != 0)
-        {
-#if defined(_WIN32)
-            fwprintf(stderr, L"Error: Failed to read file in archive, aborting!\n");
-#else
-            fprintf(stderr, "Error: Failed to read file in archive, aborting!\n");
-#endif
-            result = 1;
             goto failed;
-        }
 
-#if !defined(_WIN32)
-        if ((fileFlags >> 16) & 0xFFFF)
-            chmod(outputFile, (fileFlags >> 16) & 0xFFFF);
-#endif
-
-        if (!ipc)
+        ZipUnpackEntry entry;
+        entry.index = i;
+        entry.fileName = fileName;
+        entry.size = dstLen;
+        entry.flags = fileFlags;
+        entry.outputFile = outputFile;
+        if (ZipGetFilePos(handle, &entry.pos) != UNZ_OK)
         {
 #if defined(_WIN32)
-            wprintf(L"Ok\n");
+            fwprintf(stderr, L"Error: Failed to get file infomation in archive, aborting!\n");
 #else
-            printf("Ok\n");
+            fprintf(stderr, "Error: Failed to get file infomation in archive, aborting!\n");
 #endif
+            goto failed;
         }
+        entries.push_back(entry);
+        totalUnpackedSize += dstLen;
         ZipGoToNextFile(handle);
     }
 
     ZipClose(handle);
     handle = nullptr;
+
+    numThreads = std::min(std::max(std::thread::hardware_concurrency(), 1U), static_cast<unsigned int>(UNPACK_MAX_WRITERS));
+    numThreads = std::min(numThreads, static_cast<unsigned int>(entries.size()));
+    if (numThreads <= 1)
+    {
+        ZipUnpackEntries(path, entries, numEntries, nextEntry, failed);
+    }
+    else
+    {
+        std::vector<std::thread> workers;
+        for (unsigned int t = 0; t < numThreads; t++)
+        {
+            workers.emplace_back(ZipUnpackEntries, path, std::cref(entries), numEntries,
+                                 std::ref(nextEntry), std::ref(failed));
+        }
+        for (auto &worker : workers)
+            worker.join();
+    }
+
     fflush(stdout);
     fflush(stderr);
 
-    return result;
+    return failed ? 1 : 0;
 
 failed:
 
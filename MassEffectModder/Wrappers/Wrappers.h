@@ -32,15 +32,19 @@ class BC7BlockDecoder;
 int LzmaDecompress(BYTE *src, UINT32 src_len, BYTE *dst, UINT32 *dst_len);
 int LzmaCompress(BYTE *src, UINT32 src_len, BYTE **dst, UINT32 *dst_len, int compress_level = 5);
 
-void *ZipOpenFromFile(const void *path, int *numEntries, int tpf);
-void *ZipOpenFromMem(BYTE *src, UINT64 srcLen, int *numEntries, int tpf);
+void *ZipOpenFromFile(const void *path, int *numEntries);
+void *ZipOpenFromMem(BYTE *src, UINT64 srcLen, int *numEntries);
 int ZipGetCurrentFileInfo(void *handle, char *fileName,
                           int sizeOfFileName, unsigned long long *dstLen,
                           unsigned long *fileFlags);
 int ZipGoToFirstFile(void *handle);
 int ZipGoToNextFile(void *handle);
 int ZipLocateFile(void *handle, const char *filename);
-int ZipReadCurrentFile(void *handle, BYTE *dst, UINT64 dst_len, const BYTE *pass);
+int ZipReadCurrentFile(void *handle, BYTE *dst, UINT64 dst_len);
+int ZipOpenCurrentFile(void *handle);
+int ZipReadCurrentFileChunk(void *handle, BYTE *dst, unsigned int len);
+int ZipCloseCurrentFile(void *handle);
+int ZipGetCurrentFileDataOffset(void *handle, UINT64 *offset, bool *stored);
 void ZipClose(void *handle);
 int ZipUnpack(const void *path, const void *output_path, const void *filter,
               bool full_path, bool ipc = false);
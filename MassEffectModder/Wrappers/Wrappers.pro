@@ -130,4 +130,6 @@ equals(ZSTD_ENABLE, true) {
 }
 }
 
+unix:LIBS += -lpthread
+
 }